@@ -99,7 +99,7 @@ while t < tdomain.ub():
     cn.add(ctc.eval, [ti, xi, x, v])
     cn.add(ctc.dist, [xi[0], xi[1], b[0], b[1], yi])
 
-  contraction_dt = cn.contract_during(iteration_dt)
+  contraction_dt = cn.contract_during(iteration_dt).duration
   if iteration_dt>contraction_dt:
     time.sleep(iteration_dt-contraction_dt) # iteration delay
 
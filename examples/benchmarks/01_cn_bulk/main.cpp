@@ -0,0 +1,80 @@
+/** 
+ *  tubex-lib - Benchmarks
+ *  Construction of large contractor networks
+ * ----------------------------------------------------------------------------
+ *
+ *  \brief      Synthetic network of 1M static contractors, built with successive
+ *              calls to ContractorNetwork::add() or with the bulk method
+ *
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <tubex.h>
+
+using namespace std;
+using namespace tubex;
+
+double elapsed(const chrono::steady_clock::time_point& t_start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+}
+
+int main(int argc, char** argv)
+{
+  int n = 1000000; // number of contractors
+  if(argc > 1 && atoi(argv[1]) > 0)
+    n = atoi(argv[1]);
+
+  int nb_vars = n/10; // each variable is involved in 30 contractors on average
+  CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+
+  // Pseudo-random (but reproducible) structure of the network
+  vector<array<int,3> > v_ids(n);
+  srand(42);
+  for(auto& ids : v_ids)
+    for(auto& id : ids)
+      id = rand() % nb_vars;
+
+  cout << "Synthetic network: " << n << " contractors, " << nb_vars << " variables" << endl;
+
+  // Successive calls to add()
+  {
+    vector<Interval> x(nb_vars, Interval(-10.,10.));
+    ContractorNetwork cn;
+
+    chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+    for(const auto& ids : v_ids)
+      cn.add(ctc_plus, {x[ids[0]], x[ids[1]], x[ids[2]]});
+    cout << "  add() in a loop:  " << elapsed(t_start) << "s"
+         << " (" << cn.nb_ctc() << " ctc, " << cn.nb_dom() << " dom)" << endl;
+  }
+
+  // Bulk construction
+  {
+    vector<Interval> x(nb_vars, Interval(-10.,10.));
+    ContractorNetwork cn;
+
+    chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+    vector<pair<Ctc*,vector<Domain> > > v_batch;
+    v_batch.reserve(n);
+    for(const auto& ids : v_ids)
+      v_batch.push_back(make_pair(&ctc_plus, vector<Domain>({x[ids[0]], x[ids[1]], x[ids[2]]})));
+    cn.add(v_batch);
+    cout << "  bulk add():       " << elapsed(t_start) << "s"
+         << " (" << cn.nb_ctc() << " ctc, " << cn.nb_dom() << " dom)" << endl;
+
+    t_start = chrono::steady_clock::now();
+    cn.contract();
+    cout << "  contraction:      " << elapsed(t_start) << "s" << endl;
+  }
+
+  // Checking if this example still works:
+  return EXIT_SUCCESS;
+}
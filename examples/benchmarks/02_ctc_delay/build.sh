@@ -0,0 +1,11 @@
+# ==================================================================
+#  tubex-lib - build script
+# ==================================================================
+
+#!/bin/bash
+
+mkdir build -p
+cd build
+cmake ..
+make
+cd ..
\ No newline at end of file
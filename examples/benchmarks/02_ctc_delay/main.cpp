@@ -0,0 +1,66 @@
+/** 
+ *  tubex-lib - Benchmarks
+ *  Delay contractor on long tubes
+ * ----------------------------------------------------------------------------
+ *
+ *  \brief      Contraction of x(t)=y(t+a) on tubes of 50k slices, for a thin
+ *              delay (index shift) and for an uncertain delay (synthesis trees)
+ *
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <tubex.h>
+
+using namespace std;
+using namespace tubex;
+
+double elapsed(const chrono::steady_clock::time_point& t_start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+}
+
+int main(int argc, char** argv)
+{
+  int n = 50000; // number of slices
+  if(argc > 1 && atoi(argv[1]) > 0)
+    n = atoi(argv[1]);
+
+  double dt = 1./64.; // exact gates: slicings can be shifted
+  Interval tdomain(0., n*dt);
+  CtcDelay ctc_delay;
+
+  cout << "Delay contractor: tubes of " << n << " slices" << endl;
+
+  // Thin delay, aligned slicings: index shift
+  {
+    Tube x(tdomain, dt, TFunction("cos(t)"));
+    Tube y(tdomain, dt);
+    Interval a(64.*dt);
+
+    chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+    ctc_delay.contract(a, x, y);
+    cout << "  thin delay:       " << elapsed(t_start) << "s"
+         << " (y(" << tdomain.ub() << ")=" << y(tdomain.ub()) << ")" << endl;
+  }
+
+  // Uncertain delay: evaluations and inversions with synthesis trees
+  {
+    Tube x(tdomain, dt, TFunction("cos(t)"));
+    Tube y(tdomain, dt, TFunction("sin(t)"));
+    Interval a(0., 2.*M_PI);
+
+    chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+    ctc_delay.contract(a, x, y);
+    cout << "  uncertain delay:  " << elapsed(t_start) << "s"
+         << " (a=" << a << ")" << endl;
+  }
+
+  // Checking if this example still works:
+  return EXIT_SUCCESS;
+}
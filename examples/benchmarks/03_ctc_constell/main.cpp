@@ -0,0 +1,101 @@
+/** 
+ *  tubex-lib - Benchmarks
+ *  Constellation contractor on large maps
+ * ----------------------------------------------------------------------------
+ *
+ *  \brief      Contraction of observations with CtcConstell on maps of 10, 1k
+ *              and 100k landmarks, compared with a linear scan of the map
+ *
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <tubex.h>
+#include <tubex-rob.h>
+
+using namespace std;
+using namespace tubex;
+
+double elapsed(const chrono::steady_clock::time_point& t_start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+}
+
+double rand_value(double lb, double ub)
+{
+  return lb + (ub - lb) * rand() / (double)RAND_MAX;
+}
+
+int main(int argc, char** argv)
+{
+  int n_max = 100000; // largest number of landmarks
+  if(argc > 1 && atoi(argv[1]) > 0)
+    n_max = atoi(argv[1]);
+
+  int nb_obs = 10000; // number of contracted boxes
+  srand(42);
+
+  for(int n = 10 ; n <= n_max ; n *= 100)
+  {
+    // Landmarks spread over a square of constant density
+
+    double side = 10. * sqrt(n);
+    vector<IntervalVector> v_map;
+    for(int i = 0 ; i < n ; i++)
+    {
+      Vector pos({ rand_value(0., side), rand_value(0., side), rand_value(0., 5.) });
+      v_map.push_back(IntervalVector(pos).inflate(0.1));
+    }
+
+    vector<IntervalVector> v_obs;
+    for(int i = 0 ; i < nb_obs ; i++)
+    {
+      Vector pos({ rand_value(0., side), rand_value(0., side) });
+      v_obs.push_back(IntervalVector(pos).inflate(rand_value(1., 10.)));
+    }
+
+    cout << "Map of " << n << " landmarks, " << nb_obs << " observations" << endl;
+
+    // Linear scan (previous implementation)
+
+      vector<IntervalVector> v_scan(v_obs);
+      chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+      for(auto& a : v_scan)
+      {
+        IntervalVector union_result(2, Interval::EMPTY_SET);
+        for(const auto& mj : v_map)
+          union_result |= a & mj.subvector(0,1);
+        a = union_result;
+      }
+      cout << "  linear scan:      " << elapsed(t_start) << "s" << endl;
+
+    // Tree
+
+      vector<IntervalVector> v_tree(v_obs);
+      t_start = chrono::steady_clock::now();
+      CtcConstell ctc_constell(v_map);
+      cout << "  tree building:    " << elapsed(t_start) << "s" << endl;
+
+      t_start = chrono::steady_clock::now();
+      for(auto& a : v_tree)
+        ctc_constell.contract(a);
+      cout << "  tree queries:     " << elapsed(t_start) << "s" << endl;
+
+    // Checking that the results are identical
+
+      for(int i = 0 ; i < nb_obs ; i++)
+        if(v_tree[i] != v_scan[i])
+        {
+          cout << "  different results for " << v_obs[i] << endl;
+          return EXIT_FAILURE;
+        }
+  }
+
+  // Checking if this example still works:
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+/** 
+ *  tubex-lib - Benchmarks
+ *  Compiled evaluations of TFunction
+ * ----------------------------------------------------------------------------
+ *
+ *  \brief      Evaluation of the velocity model of the Redermor AUV (Euler
+ *              angles and body velocities to world velocities) on tubes,
+ *              with the IBEX evaluator and with its compiled expression tape
+ *
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <tubex.h>
+
+using namespace std;
+using namespace tubex;
+
+double elapsed(const chrono::steady_clock::time_point& t_start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+}
+
+int main(int argc, char** argv)
+{
+  int n = 200000; // number of slices
+  if(argc > 1 && atoi(argv[1]) > 0)
+    n = atoi(argv[1]);
+
+  Interval tdomain(0., 10.);
+  double dt = tdomain.diam() / n;
+
+  // Euler angles (phi,theta,psi) and body velocities (vxr,vyr,vzr), as sensed
+  TubeVector x(tdomain, dt,
+    TFunction("(0.1*sin(t)+[-0.01,0.01] ; 0.05*cos(t)+[-0.01,0.01] ; 0.3*t+[-0.02,0.02] ; \
+                1.5+[-0.05,0.05] ; 0.1*sin(2*t)+[-0.05,0.05] ; [-0.05,0.05])"));
+
+  TFunction f("phi", "theta", "psi", "vxr", "vyr", "vzr",
+   "(vxr * cos(theta) * cos(psi) \
+     - vyr * (cos(phi) * sin(psi) - sin(theta) * cos(psi) * sin(phi)) \
+     + vzr * (sin(phi) * sin(psi) + sin(theta) * cos(psi) * cos(phi)) \
+     ; \
+     vxr * cos(theta) * sin(psi) \
+     + vyr * (cos(psi) * cos(phi) + sin(theta) * sin(psi) * sin(phi)) \
+     - vzr * (cos(psi) * sin(phi) - sin(theta) * cos(phi) * sin(psi)) ; \
+     - vxr * sin(theta) + vyr * cos(theta)*sin(phi) + vzr * cos(theta) * cos(phi))");
+
+  cout << "Redermor velocity model: tubes of " << x.nb_slices() << " slices" << endl;
+
+  chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+  TubeVector v_ibex = f.eval_vector(x);
+  cout << "  IBEX evaluator:     " << elapsed(t_start) << "s" << endl;
+
+  TFunction f_compiled(f);
+  if(!f_compiled.compile())
+    return EXIT_FAILURE;
+
+  t_start = chrono::steady_clock::now();
+  TubeVector v_compiled = f_compiled.eval_vector(x);
+  cout << "  compiled evaluator: " << elapsed(t_start) << "s" << endl;
+
+  // Checking if this example still works:
+  return v_compiled == v_ibex ? EXIT_SUCCESS : EXIT_FAILURE;
+}
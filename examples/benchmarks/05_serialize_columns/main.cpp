@@ -0,0 +1,67 @@
+/** 
+ *  tubex-lib - Benchmarks
+ *  Serialization of tubes by columns
+ * ----------------------------------------------------------------------------
+ *
+ *  \brief      Serialization and deserialization of a 10-dimensional tube,
+ *              with the version 2 of the binary format (one write per value)
+ *              and the version 3 (one buffered write per column)
+ *
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <tubex.h>
+
+using namespace std;
+using namespace tubex;
+
+double elapsed(const chrono::steady_clock::time_point& t_start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+}
+
+bool bench_version(const TubeVector& x, int version_number)
+{
+  string filename = "bench_05.tube";
+
+  chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+  x.serialize(filename, version_number);
+  cout << "  version " << version_number << ", serialization:   " << elapsed(t_start) << "s" << endl;
+
+  t_start = chrono::steady_clock::now();
+  TubeVector y(filename);
+  cout << "  version " << version_number << ", deserialization: " << elapsed(t_start) << "s" << endl;
+
+  remove(filename.c_str());
+  return x == y;
+}
+
+int main(int argc, char** argv)
+{
+  int n = 1000000; // number of slices
+  if(argc > 1 && atoi(argv[1]) > 0)
+    n = atoi(argv[1]);
+
+  Interval tdomain(0., 10.);
+  TubeVector x(tdomain, tdomain.diam() / n, 10);
+
+  for(int i = 0 ; i < x.size() ; i++)
+    for(Slice *s = x[i].first_slice() ; s != NULL ; s = s->next_slice())
+      s->set_envelope(i + sin(s->tdomain().mid()) + Interval(-0.1,0.1));
+
+  cout << "Serialization of a tube of dimension " << x.size()
+       << " and " << x.nb_slices() << " slices" << endl;
+
+  bool v2 = bench_version(x, 2);
+  bool v3 = bench_version(x, 3);
+
+  // Checking if this example still works:
+  return v2 && v3 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -19,6 +19,7 @@
 #include "tubex_ContractorNetwork.h"
 // Generated file from Doxygen XML (doxygen2docstring.py):
 #include "tubex_py_ContractorNetwork_docs.h"
+#include "tubex_py_Deadline_docs.h"
 
 using namespace std;
 using namespace ibex;
@@ -91,6 +92,62 @@ vector<tubex::Domain> pylist_to_vectordomains(py::list lst)
 
 void export_ContractorNetwork(py::module& m)
 {
+  py::class_<Deadline>(m, "Deadline", DEADLINE_MAIN)
+
+    .def(py::init<>(),
+      DEADLINE_DEADLINE)
+
+    .def(py::init<double>(),
+      DEADLINE_DEADLINE_DOUBLE,
+      "dt"_a)
+
+    .def("cancel", &Deadline::cancel,
+      DEADLINE_VOID_CANCEL)
+
+    .def("is_cancelled", &Deadline::is_cancelled,
+      DEADLINE_BOOL_IS_CANCELLED)
+
+    .def("expired", &Deadline::expired,
+      DEADLINE_BOOL_EXPIRED)
+
+    .def("elapsed_time", &Deadline::elapsed_time,
+      DEADLINE_DOUBLE_ELAPSED_TIME)
+
+    .def("remaining_time", &Deadline::remaining_time,
+      DEADLINE_DOUBLE_REMAINING_TIME)
+  ;
+
+  py::class_<ContractionResult>(m, "ContractionResult",
+    "Outcome of a contraction process that may have been interrupted before reaching a fixed point.")
+    .def_readonly("completed", &ContractionResult::completed,
+      "True if a fixed point has been reached, False if the process has been interrupted.")
+    .def_readonly("nb_ctc_in_stack", &ContractionResult::nb_ctc_in_stack,
+      "Number of contractors remaining in the queue, processed first during the next call.")
+    .def_readonly("duration", &ContractionResult::duration,
+      "Wall-clock computation time in seconds.")
+  ;
+
+  py::enum_<SearchStrategy>(m, "SearchStrategy")
+    .value("DEPTH_FIRST", SearchStrategy::DEPTH_FIRST)
+    .value("BEST_FIRST", SearchStrategy::BEST_FIRST)
+  ;
+
+  py::class_<SolverResult>(m, "SolverResult",
+    "Solutions and statistics of a branch-and-prune exploration.")
+    .def_readonly("boxes", &SolverResult::boxes,
+      "For each solution, values of the bisected intervals and interval vectors (concatenated), if any.")
+    .def_readonly("tubes", &SolverResult::tubes,
+      "For each solution, values of the bisected tubes, if any.")
+    .def_readonly("nb_solutions", &SolverResult::nb_solutions,
+      "Number of solutions: nodes that cannot be bisected anymore.")
+    .def_readonly("nb_nodes", &SolverResult::nb_nodes,
+      "Number of explored (contracted) nodes of the search tree.")
+    .def_readonly("completed", &SolverResult::completed,
+      "False if the exploration has been interrupted by the deadline.")
+    .def_readonly("duration", &SolverResult::duration,
+      "Wall-clock computation time in seconds.")
+  ;
+
   py::class_<ContractorNetwork> cn(m, "ContractorNetwork", CONTRACTORNETWORK_MAIN);
   cn
 
@@ -170,16 +227,62 @@ void export_ContractorNetwork(py::module& m)
       CONTRACTORNETWORK_VOID_ADD_DATA_TUBEVECTOR_DOUBLE_INTERVALVECTOR,
       "x"_a, "t"_a, "y"_a)
 
+    .def("break_down_static_ctc", &ContractorNetwork::break_down_static_ctc,
+      CONTRACTORNETWORK_VOID_BREAK_DOWN_STATIC_CTC_BOOL,
+      "breakdown"_a=true)
+
+  // Frozen network
+
+    .def("freeze", &ContractorNetwork::freeze,
+      CONTRACTORNETWORK_VOID_FREEZE)
+
+    .def("is_frozen", &ContractorNetwork::is_frozen,
+      CONTRACTORNETWORK_BOOL_IS_FROZEN)
+
+  // Reusing the network (cycles)
+
+    .def("rebind", (void (ContractorNetwork::*)(Interval&,const Interval&))&ContractorNetwork::rebind,
+      CONTRACTORNETWORK_VOID_REBIND_INTERVAL_INTERVAL,
+      "i"_a, "value"_a)
+
+    .def("rebind", (void (ContractorNetwork::*)(IntervalVector&,const IntervalVector&))&ContractorNetwork::rebind,
+      CONTRACTORNETWORK_VOID_REBIND_INTERVALVECTOR_INTERVALVECTOR,
+      "iv"_a, "value"_a)
+
+    .def("rebind", (void (ContractorNetwork::*)(Tube&,const Tube&))&ContractorNetwork::rebind,
+      CONTRACTORNETWORK_VOID_REBIND_TUBE_TUBE,
+      "x"_a, "value"_a)
+
+    .def("rebind", (void (ContractorNetwork::*)(Tube&,const Interval&))&ContractorNetwork::rebind,
+      CONTRACTORNETWORK_VOID_REBIND_TUBE_INTERVAL,
+      "x"_a, "codomain"_a)
+
+    .def("rebind", (void (ContractorNetwork::*)(TubeVector&,const TubeVector&))&ContractorNetwork::rebind,
+      CONTRACTORNETWORK_VOID_REBIND_TUBEVECTOR_TUBEVECTOR,
+      "x"_a, "value"_a)
+
+  // Sliding window (online estimation)
+
+    .def("slide_window", &ContractorNetwork::slide_window,
+      CONTRACTORNETWORK_VOID_SLIDE_WINDOW_DOUBLE_BOOL,
+      "t"_a, "keep_prior"_a=true)
+
   // Contraction process  
 
-    .def("contract", &ContractorNetwork::contract,
+    .def("contract", (double (ContractorNetwork::*)(bool))&ContractorNetwork::contract,
       CONTRACTORNETWORK_DOUBLE_CONTRACT_BOOL,
       "verbose"_a=false)
 
     .def("contract_during", &ContractorNetwork::contract_during,
-      CONTRACTORNETWORK_DOUBLE_CONTRACT_DURING_DOUBLE_BOOL,
+      CONTRACTORNETWORK_CONTRACTIONRESULT_CONTRACT_DURING_DOUBLE_BOOL,
       "dt"_a, "verbose"_a=false)
 
+    // The GIL is released, so that the deadline can be cancelled from another Python thread
+    .def("contract", (ContractionResult (ContractorNetwork::*)(Deadline&,bool))&ContractorNetwork::contract,
+      CONTRACTORNETWORK_CONTRACTIONRESULT_CONTRACT_DEADLINE_BOOL,
+      "deadline"_a, "verbose"_a=false,
+      py::call_guard<py::gil_scoped_release>())
+
     .def("set_fixedpoint_ratio", &ContractorNetwork::set_fixedpoint_ratio,
       CONTRACTORNETWORK_VOID_SET_FIXEDPOINT_RATIO_FLOAT,
       "r"_a)
@@ -190,6 +293,30 @@ void export_ContractorNetwork(py::module& m)
     .def("nb_ctc_in_stack", &ContractorNetwork::nb_ctc_in_stack,
       CONTRACTORNETWORK_INT_NB_CTC_IN_STACK)
 
+  // Checkpoints
+
+    .def("save_state", &ContractorNetwork::save_state,
+      CONTRACTORNETWORK_INT_SAVE_STATE)
+
+    .def("restore_state", &ContractorNetwork::restore_state,
+      CONTRACTORNETWORK_VOID_RESTORE_STATE)
+
+    .def("discard_state", &ContractorNetwork::discard_state,
+      CONTRACTORNETWORK_VOID_DISCARD_STATE)
+
+    .def("nb_saved_states", &ContractorNetwork::nb_saved_states,
+      CONTRACTORNETWORK_INT_NB_SAVED_STATES)
+
+  // Branch and prune
+
+    .def("solve", [](ContractorNetwork& cn, py::list lst, double eps, SearchStrategy strategy, double timeout, bool verbose)
+      {
+        return cn.solve(pylist_to_vectordomains(lst), eps, strategy, timeout, verbose);
+      },
+      CONTRACTORNETWORK_SOLVERRESULT_SOLVE_VECTORDOMAIN_DOUBLE_SEARCHSTRATEGY_DOUBLE_BOOL,
+      "v_domains"_a, "eps"_a, "strategy"_a=SearchStrategy::DEPTH_FIRST,
+      "timeout"_a=POS_INFINITY, "verbose"_a=false)
+
   // Visualization
 
     .def("set_name", (void (ContractorNetwork::*)(Ctc &,const string&))&ContractorNetwork::set_name,
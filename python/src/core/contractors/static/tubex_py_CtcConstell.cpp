@@ -31,13 +31,13 @@ void export_CtcConstell(py::module& m)
   py::class_<CtcConstell,Ctc> ctc_constell(m, "CtcConstell", CTCCONSTELL_MAIN);
   ctc_constell
 
-    .def(py::init<const list<IntervalVector> &>(),
-      CTCCONSTELL_CTCCONSTELL_VECTORINTERVALVECTOR,
-      "map"_a.noconvert())
+    .def(py::init<const list<IntervalVector> &,int>(),
+      CTCCONSTELL_CTCCONSTELL_LISTINTERVALVECTOR_INT,
+      "map"_a.noconvert(), "dim"_a=2)
 
-    .def(py::init<const vector<IntervalVector> &>(),
-      CTCCONSTELL_CTCCONSTELL_VECTORINTERVALVECTOR,
-      "map"_a.noconvert())
+    .def(py::init<const vector<IntervalVector> &,int>(),
+      CTCCONSTELL_CTCCONSTELL_VECTORINTERVALVECTOR_INT,
+      "map"_a.noconvert(), "dim"_a=2)
 
     .def("contract", &CtcConstell::contract,
       CTCCONSTELL_VOID_CONTRACT_INTERVALVECTOR,
@@ -301,6 +301,10 @@ void export_Tube(py::module& m)
       TUBE_VOID_SHIFT_TDOMAIN_DOUBLE,
       "a"_a)
 
+    .def("slide_tdomain", &Tube::slide_tdomain,
+      TUBE_INT_SLIDE_TDOMAIN_DOUBLE,
+      "t"_a)
+
   // Bisection
 
     .def("bisect", &Tube::bisect,
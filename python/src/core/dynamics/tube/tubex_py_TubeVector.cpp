@@ -300,6 +300,10 @@ void export_TubeVector(py::module& m)
       TUBEVECTOR_VOID_SHIFT_TDOMAIN_DOUBLE,
       "a"_a)
 
+    .def("slide_tdomain", &TubeVector::slide_tdomain,
+      TUBEVECTOR_INT_SLIDE_TDOMAIN_DOUBLE,
+      "t"_a)
+
   // Bisection
 
     .def("bisect", (const pair<TubeVector, TubeVector> (TubeVector::*)(double,float) const)&TubeVector::bisect,
@@ -115,8 +115,8 @@ void export_TFunction(py::module& m, py::class_<TFnc>& fnc)
       "x"_a)
 
     .def("traj_eval_vector", &TFunction::traj_eval_vector,
-      TFUNCTION_CONSTTRAJECTORYVECTOR_TRAJ_EVAL_VECTOR_TRAJECTORYVECTOR,
-      "x"_a)
+      TFUNCTION_CONSTTRAJECTORYVECTOR_TRAJ_EVAL_VECTOR_TRAJECTORYVECTOR_BOOL,
+      "x"_a, "shared_time_axis"_a=false)
 
     .def("eval_vector", (const IntervalVector (TFunction::*)(const Interval&) const)&TFunction::eval_vector,
       TFUNCTION_CONSTINTERVALVECTOR_EVAL_VECTOR_INTERVAL,
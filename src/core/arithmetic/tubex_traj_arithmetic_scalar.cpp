@@ -26,13 +26,12 @@ namespace tubex
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
       && "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
+    vector<double> v_y = x.sampled_values();
 
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = -it->second;
+    for(auto& y : v_y)
+      y = -y;
 
-    return Trajectory(map_y);
+    return Trajectory(x.sampled_times(), v_y);
   }
     
   #define macro_scal_unary(f) \
@@ -42,13 +41,12 @@ namespace tubex
       assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES \
         && "not supported yet for trajectories defined by a Function"); \
       \
-      map<double,double> map_y = x.sampled_map(); \
+      vector<double> v_y = x.sampled_values(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second); \
+      for(auto& y : v_y) \
+        y = std::f(y); \
       \
-      return Trajectory(map_y); \
+      return Trajectory(x.sampled_times(), v_y); \
     } \
     \
 
@@ -61,13 +59,12 @@ namespace tubex
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
       && "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
+    vector<double> v_y = x.sampled_values();
 
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::pow(it->second,2);
+    for(auto& y : v_y)
+      y = std::pow(y,2);
 
-    return Trajectory(map_y);
+    return Trajectory(x.sampled_times(), v_y);
   }
 
   macro_scal_unary(sqrt);
@@ -91,13 +88,12 @@ namespace tubex
       assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      map<double,double> map_y = x.sampled_map(); \
+      vector<double> v_y = x.sampled_values(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second, param); \
+      for(auto& y : v_y) \
+        y = std::f(y, param); \
       \
-      return Trajectory(map_y); \
+      return Trajectory(x.sampled_times(), v_y); \
     } \
     \
   
@@ -109,12 +105,11 @@ namespace tubex
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::pow(it->second, 1. / p);
+    vector<double> v_y = x.sampled_values();
+    for(auto& y : v_y)
+      y = std::pow(y, 1. / p);
 
-    return Trajectory(map_y);
+    return Trajectory(x.sampled_times(), v_y);
   }
 
   #define macro_scal_binary_arith(f) \
@@ -130,17 +125,11 @@ namespace tubex
         x1_sampled.sample(x2); \
       if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x2_sampled.sample(x1); \
-      map<double,double> new_map; \
-      map<double,double>::const_iterator it_x1 = x1_sampled.sampled_map().begin(); \
-      map<double,double>::const_iterator it_x2 = x2_sampled.sampled_map().begin(); \
+      vector<double> v_y = x1_sampled.sampled_values(); \
+      for(size_t k = 0 ; k < v_y.size() ; k++) \
+        v_y[k] = v_y[k] f x2_sampled.sampled_values()[k]; \
       \
-      while(it_x1 != x1_sampled.sampled_map().end()) \
-      { \
-        new_map[it_x1->first] = it_x1->second f it_x2->second; \
-        it_x1++; it_x2++; \
-      } \
-      \
-      return Trajectory(new_map); \
+      return Trajectory(x1_sampled.sampled_times(), v_y); \
     } \
     \
     const Trajectory operator f(const Trajectory& x1, double x2) \
@@ -148,14 +137,12 @@ namespace tubex
       assert(x1.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      Trajectory y(x1); \
-      map<double,double> map_y = y.sampled_map(); \
+      vector<double> v_y = x1.sampled_values(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = it->second f x2; \
+      for(auto& y : v_y) \
+        y = y f x2; \
       \
-      return Trajectory(map_y); \
+      return Trajectory(x1.sampled_times(), v_y); \
     } \
     \
     const Trajectory operator f(double x1, const Trajectory& x2) \
@@ -163,14 +150,12 @@ namespace tubex
       assert(x2.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      Trajectory y(x2); \
-      map<double,double> map_y = y.sampled_map(); \
+      vector<double> v_y = x2.sampled_values(); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = x1 f it->second; \
+      for(auto& y : v_y) \
+        y = x1 f y; \
       \
-      return Trajectory(map_y); \
+      return Trajectory(x2.sampled_times(), v_y); \
     } \
     \
 
@@ -190,18 +175,11 @@ namespace tubex
       x1_sampled.sample(x2);
     if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES)
       x2_sampled.sample(x1);
-    map<double,double> map_x1 = x1.sampled_map(), map_x2 = x2.sampled_map();
-
-    map<double,double>::iterator it_x1 = map_x1.begin();
-    map<double,double>::iterator it_x2 = map_x2.begin();
-
-    while(it_x1 != map_x1.end())
-    {
-      it_x1->second = std::atan2(it_x1->second, it_x2->second);
-      it_x1++; it_x2++;
-    }
+    vector<double> v_y = x1_sampled.sampled_values();
+    for(size_t k = 0 ; k < v_y.size() ; k++)
+      v_y[k] = std::atan2(v_y[k], x2_sampled.sampled_values()[k]);
 
-    return Trajectory(map_x1);
+    return Trajectory(x1_sampled.sampled_times(), v_y);
   }
 
   const Trajectory atan2(const Trajectory& x1, double x2)
@@ -209,14 +187,12 @@ namespace tubex
     assert(x1.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    Trajectory y(x1);
-    map<double,double> map_y = y.sampled_map();
+    vector<double> v_y = x1.sampled_values();
 
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::atan2(it->second, x2);
+    for(auto& y : v_y)
+      y = std::atan2(y, x2);
 
-    return Trajectory(map_y);
+    return Trajectory(x1.sampled_times(), v_y);
   }
 
   const Trajectory atan2(double x1, const Trajectory& x2)
@@ -224,13 +200,11 @@ namespace tubex
     assert(x2.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    Trajectory y(x2);
-    map<double,double> map_y = y.sampled_map();
+    vector<double> v_y = x2.sampled_values();
 
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::atan2(x1, it->second);
+    for(auto& y : v_y)
+      y = std::atan2(x1, y);
 
-    return Trajectory(map_y);
+    return Trajectory(x2.sampled_times(), v_y);
   }
 }
\ No newline at end of file
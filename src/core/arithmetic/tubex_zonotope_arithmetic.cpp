@@ -0,0 +1,188 @@
+/** 
+ *  Arithmetic operations on zonotopes
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_zonotope_arithmetic.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  const Zonotope operator+(const Zonotope& x, const IntervalVector& v)
+  {
+    assert(x.size() == v.size());
+
+    if(x.is_empty() || v.is_empty())
+      return Zonotope(IntervalVector::empty(x.size()));
+
+    return Zonotope(x.center() + v, x.generators());
+  }
+
+  const Zonotope operator+(const IntervalVector& v, const Zonotope& x)
+  {
+    return operator+(x, v);
+  }
+
+  const Zonotope operator-(const Zonotope& x, const IntervalVector& v)
+  {
+    return operator+(x, -v);
+  }
+
+  const Zonotope operator*(const IntervalMatrix& m, const Zonotope& x)
+  {
+    assert(x.size() == m.nb_cols() && x.size() == m.nb_rows());
+
+    if(x.is_empty())
+      return x;
+
+    int n = x.size();
+    vector<Vector> v_generators = x.generators();
+
+    // The bounded part of the center box is transformed into generators,
+    // in order to avoid wrapping effects: only its midpoint is kept
+
+      Vector c_mid(n, 0.);
+      IntervalVector c_unbounded(n, Interval(0.));
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        const Interval& c = x.center()[i];
+
+        if(c.is_unbounded())
+          c_unbounded[i] = c;
+
+        else
+        {
+          c_mid[i] = c.mid();
+          double rad = (c - c_mid[i]).mag(); // upper bound
+          if(rad > 0.)
+          {
+            Vector g(n, 0.);
+            g[i] = rad;
+            v_generators.push_back(g);
+          }
+        }
+      }
+
+    IntervalVector center = m * IntervalVector(c_mid);
+    if(x.is_unbounded())
+      center += m * c_unbounded;
+
+    // Images of the generators: the uncertainties (from [m] or from
+    // floating point operations) are enclosed in the center box
+
+      for(auto& g : v_generators)
+      {
+        IntervalVector mg = m * IntervalVector(g);
+        g = mg.mid();
+        center += Interval(-1.,1.) * (mg - g);
+      }
+
+    return Zonotope(center, v_generators);
+  }
+
+  const Zonotope operator&(const Zonotope& z1, const Zonotope& z2)
+  {
+    assert(z1.size() == z2.size());
+
+    // Intersections of zonotopes are not zonotopes: each one is
+    // contracted with the box of the other, the best result is kept
+
+      Zonotope z1_ = z1 & z2.box();
+      Zonotope z2_ = z2 & z1_.box();
+
+      if(z1_.is_empty() || z2_.is_empty())
+        return Zonotope(IntervalVector::empty(z1.size()));
+
+      IntervalVector box1 = z1_.box(), box2 = z2_.box();
+      double perimeter1 = 0., perimeter2 = 0.;
+      for(int i = 0 ; i < z1.size() ; i++)
+      {
+        perimeter1 += box1[i].diam();
+        perimeter2 += box2[i].diam();
+      }
+
+      return perimeter2 < perimeter1 ? z2_ : z1_;
+  }
+
+  const Zonotope operator&(const IntervalVector& z1, const Zonotope& z2)
+  {
+    return operator&(z2, z1);
+  }
+
+  const Zonotope operator&(const Zonotope& z1, const IntervalVector& z2)
+  {
+    assert(z1.size() == z2.size());
+
+    int n = z1.size();
+
+    if(z1.is_empty() || z2.is_empty())
+      return Zonotope(IntervalVector::empty(n));
+
+    // Each dimension i provides the constraint c_i + sum_j g_ij*e_j in [z2_i],
+    // propagated over the center and over the coefficients e_j in [-1,1]
+
+      const vector<Vector>& v_generators = z1.generators();
+      int m = v_generators.size();
+
+      IntervalVector c(z1.center());
+      vector<Interval> v_e(m, Interval(-1.,1.));
+      vector<Interval> v_prefix(m+1), v_suffix(m+1);
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        if(z2[i] == Interval::ALL_REALS)
+          continue;
+
+        v_prefix[0] = 0.; v_suffix[m] = 0.;
+        for(int j = 0 ; j < m ; j++)
+          v_prefix[j+1] = v_prefix[j] + v_generators[j][i] * v_e[j];
+        for(int j = m-1 ; j >= 0 ; j--)
+          v_suffix[j] = v_suffix[j+1] + v_generators[j][i] * v_e[j];
+
+        c[i] &= z2[i] - v_prefix[m];
+        if(c[i].is_empty())
+          return Zonotope(IntervalVector::empty(n));
+
+        Interval r = z2[i] - c[i];
+        if(r == Interval::ALL_REALS)
+          continue;
+
+        for(int j = 0 ; j < m ; j++)
+          if(v_generators[j][i] != 0.)
+          {
+            v_e[j] &= (r - (v_prefix[j] + v_suffix[j+1])) / v_generators[j][i];
+            if(v_e[j].is_empty())
+              return Zonotope(IntervalVector::empty(n));
+          }
+      }
+
+    // Normalization of the coefficients e_j back to [-1,1]
+
+      vector<Vector> v_result_generators;
+
+      for(int j = 0 ; j < m ; j++)
+      {
+        IntervalVector g(v_generators[j]);
+        double e_mid = v_e[j].mid();
+        double e_rad = (v_e[j] - e_mid).mag(); // upper bound
+        c += Interval(e_mid) * g;
+
+        if(e_rad > 0.)
+        {
+          IntervalVector scaled_g = Interval(e_rad) * g;
+          v_result_generators.push_back(scaled_g.mid());
+          c += Interval(-1.,1.) * (scaled_g - scaled_g.mid());
+        }
+      }
+
+    return Zonotope(c, v_result_generators);
+  }
+}
@@ -0,0 +1,32 @@
+/** 
+ *  \file
+ *  Arithmetic operations on zonotopes
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_ZONOTOPE_ARITHMETIC_H__
+#define __TUBEX_ZONOTOPE_ARITHMETIC_H__
+
+#include "ibex_IntervalVector.h"
+#include "ibex_IntervalMatrix.h"
+#include "tubex_Zonotope.h"
+
+namespace tubex
+{
+  const Zonotope operator+(const Zonotope& x, const ibex::IntervalVector& v);
+  const Zonotope operator+(const ibex::IntervalVector& v, const Zonotope& x);
+  const Zonotope operator-(const Zonotope& x, const ibex::IntervalVector& v);
+
+  const Zonotope operator*(const ibex::IntervalMatrix& m, const Zonotope& x);
+
+  const Zonotope operator&(const Zonotope& z1, const Zonotope& z2);
+  const Zonotope operator&(const ibex::IntervalVector& z1, const Zonotope& z2);
+  const Zonotope operator&(const Zonotope& z1, const ibex::IntervalVector& z2);
+}
+
+#endif
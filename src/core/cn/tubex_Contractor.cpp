@@ -19,15 +19,14 @@ using namespace ibex;
 
 namespace tubex
 {
-  int Contractor::ctc_counter = 0;
+  atomic<int> Contractor::ctc_counter(0);
 
   Contractor::Contractor(Type type, const vector<Domain*>& v_domains)
     : m_type(type), m_v_domains(v_domains)
   {
     assert(!v_domains.empty());
 
-    ctc_counter++;
-    m_ctc_id = ctc_counter;
+    m_ctc_id = ++ctc_counter;
   }
 
   Contractor::Contractor(Ctc& ctc, const vector<Domain*>& v_domains)
@@ -36,6 +35,8 @@ namespace tubex
     assert(!v_domains.empty());
 
     m_static_ctc = reference_wrapper<Ctc>(ctc);
+    // Note: the gather/scatter plan is built when the contractor is stored
+    // in the network (copy), not for temporary objects used for comparisons
   }
 
   Contractor::Contractor(DynCtc& ctc, const vector<Domain*>& v_domains) 
@@ -44,7 +45,8 @@ namespace tubex
     assert(!v_domains.empty());
 
     m_dyn_ctc = reference_wrapper<DynCtc>(ctc);
-    m_dyn_ctc.get().preserve_slicing(true);
+    // Note: the slicing is preserved by the contractions of a network,
+    // without modifying the object (see context())
   }
 
   Contractor::Contractor(const Contractor& ac)
@@ -54,6 +56,7 @@ namespace tubex
 
     m_name = ac.m_name;
     m_ctc_id = ac.m_ctc_id;
+    m_time_propag = ac.m_time_propag;
 
     switch(ac.m_type)
     {
@@ -64,6 +67,7 @@ namespace tubex
         
       case Type::T_IBEX:
         m_static_ctc = reference_wrapper<Ctc>(ac.m_static_ctc);
+        build_gather_scatter_plan();
         break;
 
       case Type::T_TUBEX:
@@ -77,7 +81,8 @@ namespace tubex
   
   Contractor::~Contractor()
   {
-
+    if(m_box != NULL)
+      delete m_box;
   }
 
   int Contractor::id() const
@@ -112,6 +117,16 @@ namespace tubex
     m_active = active;
   }
 
+  const Interval& Contractor::changed_tdomain() const
+  {
+    return m_changed_tdomain;
+  }
+
+  void Contractor::set_changed_tdomain(const Interval& changed_tdomain)
+  {
+    m_changed_tdomain = changed_tdomain;
+  }
+
   vector<Domain*>& Contractor::domains()
   {
     return const_cast<vector<Domain*>&>(static_cast<const Contractor&>(*this).domains());
@@ -178,7 +193,13 @@ namespace tubex
     return true;
   }
 
-  void Contractor::contract()
+  const Interval Contractor::dependency_tdomain() const
+  {
+    assert(m_type == Type::T_TUBEX);
+    return m_dyn_ctc.get().dependency_tdomain(m_v_domains, context());
+  }
+
+  bool Contractor::contract(const Deadline *deadline)
   {
     assert(!m_v_domains.empty());
 
@@ -197,131 +218,91 @@ namespace tubex
       // Case: list of heterogeneous components
       else
       {
-        for(int j = 0 ; j < 3 ; j++) // to possibly deal with 3 subdomains of a Slice (gates + envelope)
-        {
-          bool at_least_one_slice = false;
-          // if this ^ stays false, then the for loop will break after the first iteration
+        if(m_box == NULL) // contractor not stored in a network
+          build_gather_scatter_plan();
 
-          // Building a temporary box for the contraction
-          
-            IntervalVector box(m_static_ctc.get().nb_var);
+        assert(m_v_plan.size() == (size_t)m_static_ctc.get().nb_var);
+        IntervalVector& box = *m_box;
+        const size_t n = m_v_plan.size();
 
-            int i = 0;
-            for(auto& dom : m_v_domains)
+        for(int j = 0 ; j < m_nb_passes ; j++) // to possibly deal with 3 subdomains of a Slice (gates + envelope)
+        {
+          // Gathering the components in the preallocated box
+
+            for(size_t i = 0 ; i < n ; i++)
             {
-              switch(dom->type())
+              if(m_v_plan[i].first != NULL)
+                box[i] = *m_v_plan[i].first;
+
+              else
               {
-                case Domain::Type::T_INTERVAL:
-                  box[i] = dom->interval();
-                  i++;
-                  break;
-
-                case Domain::Type::T_INTERVAL_VECTOR:
-                  assert(false && "interval vectors should not be handled here");
-                  box.put(i, dom->interval_vector());
-                  i+=dom->interval_vector().size();
-                  break;
-
-                case Domain::Type::T_SLICE:
-                  switch(j)
-                  {
-                    case 0: // we start from the envelope
-                      box[i] = dom->slice().codomain();
-                      break;
-                    
-                    // Then the gates
-                    case 1:
-                      box[i] = dom->slice().input_gate();
-                      break;
-                      
-                    case 2:
-                      box[i] = dom->slice().output_gate();
-                      break;
-
-                    default:
-                      assert(false && "Slice domain already treated");
-                  }
-                  i++;
-                  at_least_one_slice = true;
-                  break;
-
-                case Domain::Type::T_TUBE:
-                case Domain::Type::T_TUBE_VECTOR:
-                  assert(false && "dynamic domains should not be handled here");
-                  break;
-
-                default:
-                  assert(false && "unhandled case");
+                const Slice *s = m_v_plan[i].second;
+                switch(j)
+                {
+                  case 0: // we start from the envelope
+                    box[i] = s->codomain();
+                    break;
+
+                  // Then the gates
+                  case 1:
+                    box[i] = s->input_gate();
+                    break;
+
+                  case 2:
+                    box[i] = s->output_gate();
+                    break;
+
+                  default:
+                    assert(false && "Slice domain already treated");
+                }
               }
             }
 
-            assert(i == m_static_ctc.get().nb_var);
-
           // Contracting
 
             m_static_ctc.get().contract(box);
-            
+
           // Updating the domains (reverse operation)
 
-            i = 0;
-            for(auto& dom : m_v_domains)
+            for(size_t i = 0 ; i < n ; i++)
             {
-              switch(dom->type())
+              if(m_v_plan[i].first != NULL)
+                *m_v_plan[i].first = box[i];
+
+              else
               {
-                case Domain::Type::T_INTERVAL:
+                Slice *s = m_v_plan[i].second;
+                switch(j)
                 {
-                  dom->interval() = box[i];
-                  i++;
-                }
-                break;
+                  case 0:
+                    s->set_envelope(box[i]);
+                    break;
 
-                case Domain::Type::T_INTERVAL_VECTOR:
-                {
-                  int vector_size = dom->interval_vector().size();
-                  dom->interval_vector() = box.subvector(i, i+vector_size);
-                  i+=vector_size;
-                }
-                break;
+                  case 1:
+                    s->set_input_gate(box[i]);
+                    break;
 
-                case Domain::Type::T_SLICE:
-                {
-                  switch(j)
-                  {
-                    case 0:
-                      dom->slice().set_envelope(box[i]);
-                      break;
-
-                    case 1:
-                      dom->slice().set_input_gate(box[i]);
-                      break;
-
-                    case 2:
-                      dom->slice().set_output_gate(box[i]);
-                      break;
-
-                    default:
-                      assert(false && "Slice domain already treated");
-                  }
-                  i++;
-                }
-                break;
+                  case 2:
+                    s->set_output_gate(box[i]);
+                    break;
 
-                default:
-                  assert(false && "unhandled case");
+                  default:
+                    assert(false && "Slice domain already treated");
+                }
               }
             }
-
-            assert(i == m_static_ctc.get().nb_var);
-
-          if(!at_least_one_slice)
-            break;
         }
       }
     }
 
     else if(m_type == Type::T_TUBEX)
     {
-      m_dyn_ctc.get().contract(m_v_domains);
+      // Only the parts of the tubes impacted by the last changes are contracted.
+      // The settings of this call are not stored in the DynCtc object,
+      // that may be shared by several networks running in parallel
+      const ContractionContext ctc_context = context(deadline);
+      m_dyn_ctc.get().contract(m_v_domains, ctc_context);
+      return !ctc_context.interrupted;
     }
 
     else if(m_type == Type::T_COMPONENT)
@@ -375,8 +356,65 @@ namespace tubex
 
     else
       assert(false && "unhandled case");
+
+    return true;
   }
   
+  void Contractor::build_gather_scatter_plan()
+  {
+    assert(m_type == Type::T_IBEX);
+
+    // Case: all components in one vector box, no plan needed
+    if(m_v_domains.size() == 1 && m_v_domains[0]->type() == Domain::Type::T_INTERVAL_VECTOR)
+      return;
+
+    m_v_plan.clear();
+    m_nb_passes = 1;
+
+    for(auto& dom : m_v_domains)
+    {
+      switch(dom->type())
+      {
+        case Domain::Type::T_INTERVAL:
+          m_v_plan.push_back(make_pair(&dom->interval(), (Slice*)NULL));
+          break;
+
+        case Domain::Type::T_INTERVAL_VECTOR:
+          for(int k = 0 ; k < dom->interval_vector().size() ; k++)
+            m_v_plan.push_back(make_pair(&dom->interval_vector()[k], (Slice*)NULL));
+          break;
+
+        case Domain::Type::T_SLICE:
+          m_v_plan.push_back(make_pair((Interval*)NULL, &dom->slice()));
+          m_nb_passes = 3;
+          break;
+
+        case Domain::Type::T_TUBE:
+        case Domain::Type::T_TUBE_VECTOR:
+          assert(false && "dynamic domains should not be handled here");
+          break;
+
+        default:
+          assert(false && "unhandled case");
+      }
+    }
+
+    assert((int)m_v_plan.size() == m_static_ctc.get().nb_var);
+    if(m_box != NULL)
+      delete m_box;
+    m_box = new IntervalVector(m_static_ctc.get().nb_var);
+  }
+
+  const ContractionContext Contractor::context(const Deadline *deadline) const
+  {
+    ContractionContext context;
+    context.preserve_slicing = true;
+    context.time_propag = m_time_propag;
+    context.deadline = deadline;
+    context.changed_tdomain = m_changed_tdomain;
+    return context;
+  }
+
   const string Contractor::name() const
   {
     switch(type())
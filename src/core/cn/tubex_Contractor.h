@@ -13,6 +13,7 @@
 #define __TUBEX_CONTRACTOR_H__
 
 #include <vector>
+#include <atomic>
 #include <functional>
 #include "ibex_Ctc.h"
 #include "tubex_DynCtc.h"
@@ -52,12 +53,16 @@ namespace tubex
       bool is_active() const;
       void set_active(bool active);
 
+      const ibex::Interval& changed_tdomain() const;
+      void set_changed_tdomain(const ibex::Interval& changed_tdomain);
+
       std::vector<Domain*>& domains();
       const std::vector<Domain*>& domains() const;
 
       bool operator==(const Contractor& x) const;
 
-      void contract();
+      bool contract(const Deadline *deadline = NULL); // false if interrupted before the end of the computations
+      const ibex::Interval dependency_tdomain() const;
 
       const std::string name() const;
       void set_name(const std::string& name);
@@ -67,8 +72,14 @@ namespace tubex
 
     protected:
 
+      void build_gather_scatter_plan();
+      const ContractionContext context(const Deadline *deadline = NULL) const;
+
       const Type m_type;
       double m_active = true;
+      ibex::Interval m_changed_tdomain = ibex::Interval::ALL_REALS; //!< window of the changes on tubes since the last contraction
+      int m_graph_index = -1; //!< index of the contractor in the compact graph of a frozen network
+      bool m_time_propag = true; //!< settings of this registration (see ContractionContext), the DynCtc object may be shared
 
       union
       {
@@ -78,11 +89,18 @@ namespace tubex
 
       std::vector<Domain*> m_v_domains;
 
+      // Gather/scatter plan of static contractors on heterogeneous domains,
+      // computed once when the contractor is added (no allocation per call)
+      ibex::IntervalVector *m_box = NULL; //!< preallocated box of the static contractor
+      std::vector<std::pair<ibex::Interval*,Slice*> > m_v_plan; //!< for each box component: interval reference, or slice
+      int m_nb_passes = 1; //!< 3 if slices are involved (envelope, input gate, output gate), 1 otherwise
+
       std::string m_name;
       int m_ctc_id;
 
-      static int ctc_counter;
+      static std::atomic<int> ctc_counter;
       
+      friend class ContractorNetwork;
       friend class ContractorHashcode;
   };
 }
@@ -8,8 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
 #include "tubex_ContractorNetwork.h"
 #include "tubex_CtcEval.h"
+#include "tubex_CtcStatic.h"
 #include "tubex_Exception.h"
 #include "tubex_DomainsTypeException.h"
 
@@ -31,6 +33,7 @@ namespace tubex
     {
       for(auto& dom : m_map_domains)
         delete dom.second;
+      // Slices surviving the network are released by the trail
       for(auto& ctc : m_map_ctc)
         delete ctc.second;
 
@@ -81,6 +84,7 @@ namespace tubex
 
     IntervalVector& ContractorNetwork::subvector(Vector& v, int start_index, int end_index)
     {
+      m_frozen = false; // new links
       assert(start_index >= 0);
       assert(end_index < v.size());
       assert(start_index <= end_index);
@@ -109,6 +113,7 @@ namespace tubex
 
     IntervalVector& ContractorNetwork::subvector(IntervalVector& iv, int start_index, int end_index)
     {
+      m_frozen = false; // new links
       assert(start_index >= 0);
       assert(end_index < iv.size());
       assert(start_index <= end_index);
@@ -146,6 +151,7 @@ namespace tubex
 
     void ContractorNetwork::add(Ctc& static_ctc, const vector<Domain>& v_domains)
     {
+      m_frozen = false; // new links
       if(v_domains.empty())
         throw Exception(__func__, "cannot add a contractor without domains");
 
@@ -247,14 +253,17 @@ namespace tubex
 
     void ContractorNetwork::add(DynCtc& dyn_ctc, const vector<Domain>& v_domains)
     {
+      m_frozen = false; // new links
       if(v_domains.empty())
         throw Exception(__func__, "cannot add a contractor without domains");
 
       // If the CtcEval contractor is involved, its contracting impact is set
       // to the minimal and we add the CtcDeriv contractor on top of that, in 
       // order to reach thin propagations of contractions.
+      // This setting is specific to this registration: the object is not modified.
       // todo: add CtcDeriv only if not already added?
       // todo: prevent from several CtcDeriv on same couple of slices?
+      bool time_propag = true;
       if(typeid(dyn_ctc) == typeid(CtcEval))
       {
         if(v_domains.size() != 3 && v_domains.size() != 4)
@@ -262,7 +271,7 @@ namespace tubex
 
         if(v_domains.size() == 4) // with derivative information
         {
-          static_cast<CtcEval&>(dyn_ctc).enable_time_propag(false);
+          time_propag = false;
 
           if(m_ctc_deriv == NULL)
             m_ctc_deriv = new CtcDeriv();
@@ -283,23 +292,18 @@ namespace tubex
         // todo ^: use "typeid(dyn_ctc) == typeid(CtcDeriv)" instead of "&dyn_ctc == m_ctc_deriv" ?
         pair<Domain*,Domain*> p = make_pair(add_dom(v_domains[0]), add_dom(v_domains[1]));
 
-        if(find(m_domains_related_to_ctcderiv.begin(), m_domains_related_to_ctcderiv.end(), p)
-          != m_domains_related_to_ctcderiv.end())
-        {
+        // Notifying that the contractor will be added, if not already done
+        if(!m_domains_related_to_ctcderiv.insert(p).second)
           return; // contractor already added
-        }
 
-        else
-        {
-          // Notifying that the contractor will be added
-          m_domains_related_to_ctcderiv.push_back(p);
-
-          // Then, add the contractor in the following..
-        }
+        // Then, add the contractor in the following..
       }
 
+      // Static contractors may be kept at the tube level (parallel contractions of the slices)
+      bool breakdown = m_static_ctc_breakdown || typeid(dyn_ctc) != typeid(CtcStatic);
+
       // If possible, breaking down the constraint to slices level
-      if(!dyn_ctc.is_intertemporal() && !Domain::all_slices(v_domains))
+      if(breakdown && !dyn_ctc.is_intertemporal() && !Domain::all_slices(v_domains))
       {
         // Not inter-temporal => 
         if(!Domain::all_dyn(v_domains))
@@ -366,6 +370,7 @@ namespace tubex
 
         // Creating what would be this new contractors (namely defined with domains)
         Contractor ctc(dyn_ctc, v_dom_ptr);
+        ctc.m_time_propag = time_propag;
 
         // Getting the actual contractor (maybe the same if not already added)
         Contractor *ctc_ptr = add_ctc(ctc);
@@ -376,6 +381,167 @@ namespace tubex
       }
     }
     
+    void ContractorNetwork::add(const vector<pair<Ctc*,vector<Domain> > >& v_batch)
+    {
+      // Local cache of the domains of the graph, for O(1) deduplication by hashing
+      unordered_map<uintptr_t,Domain*> cache;
+      cache.reserve(2*v_batch.size());
+
+      // Static contractors of the batch, inserted in the graph after the first pass
+      vector<pair<Ctc*,vector<Domain*> > > v_items;
+      vector<ContractorHashcode> v_hash;
+      v_items.reserve(v_batch.size());
+      v_hash.reserve(v_batch.size());
+
+      vector<Domain*> v_dom_ptr;
+
+      // First pass: resolving domains and hashing contractors
+
+      for(const auto& item : v_batch)
+      {
+        assert(item.first != NULL);
+        Ctc& static_ctc = *item.first;
+        const vector<Domain>& v_domains = item.second;
+
+        if(v_domains.empty())
+          throw Exception(__func__, "cannot add a contractor without domains");
+
+        bool dyn_case = false;
+        for(const auto& dom : v_domains)
+          if(dom.type() == Domain::Type::T_SLICE
+            || dom.type() == Domain::Type::T_TUBE || dom.type() == Domain::Type::T_TUBE_VECTOR)
+          {
+            dyn_case = true;
+            break;
+          }
+
+        if(dyn_case) // slices-level breakdown performed by the generic method
+        {
+          add(static_ctc, v_domains);
+          continue;
+        }
+
+        int n = Domain::total_size(v_domains);
+        if(n % static_ctc.nb_var != 0)
+          throw Exception(__func__, "invalid total dimension of domains");
+
+        for(int i = 0 ; i < n/static_ctc.nb_var ; i++) // in case we are dealing with array data
+        {
+          v_dom_ptr.clear();
+
+          for(const auto& dom : v_domains)
+          {
+            switch(dom.type())
+            {
+              case Domain::Type::T_INTERVAL:
+                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
+                v_dom_ptr.push_back(cached_dom(dom, cache));
+                break;
+
+              case Domain::Type::T_INTERVAL_VECTOR:
+                cached_dom(dom, cache); // the vector itself is part of the graph
+                
+                if(n/static_ctc.nb_var == 1) // heterogeneous case
+                {
+                  for(int j = 0 ; j < dom.interval_vector().size() ; j++)
+                    v_dom_ptr.push_back(cached_dom(Domain::vector_component(const_cast<Domain&>(dom), j), cache));
+                }
+
+                else // array data case
+                {
+                  if(dom.interval_vector().size() != n/static_ctc.nb_var)
+                    throw Exception(__func__, "wrong vector dimension");
+                  v_dom_ptr.push_back(cached_dom(Domain::vector_component(const_cast<Domain&>(dom), i), cache));
+                }
+                break;
+
+              default:
+                assert(false && "unhandled case");
+            }
+          }
+
+          assert((int)v_dom_ptr.size() == static_ctc.nb_var);
+
+          v_hash.push_back(ContractorHashcode(Contractor(static_ctc, v_dom_ptr)));
+          v_items.push_back(make_pair(&static_ctc, v_dom_ptr));
+        }
+      }
+
+      // Second pass: merging the contractors in the graph in the order of their
+      // hashcodes, so that each insertion is hinted by the previous one
+
+      vector<size_t> v_order(v_items.size());
+      for(size_t i = 0 ; i < v_order.size() ; i++)
+        v_order[i] = i;
+
+      stable_sort(v_order.begin(), v_order.end(),
+        [&v_hash](size_t a, size_t b) { return v_hash[a] < v_hash[b]; });
+
+      vector<Contractor*> v_new_ctc(v_items.size(), NULL); // NULL if already in the graph (and linked)
+      map<ContractorHashcode,Contractor*>::iterator it_prev = m_map_ctc.end();
+
+      for(size_t i : v_order)
+      {
+        if(it_prev != m_map_ctc.end() && !(it_prev->first < v_hash[i]))
+          continue; // same contractor as the previous one
+
+        map<ContractorHashcode,Contractor*>::iterator it;
+        if(it_prev != m_map_ctc.end()
+          && (next(it_prev) == m_map_ctc.end() || v_hash[i] < next(it_prev)->first))
+          it = next(it_prev); // position right after the previous one
+
+        else
+        {
+          it = m_map_ctc.lower_bound(v_hash[i]);
+          if(it != m_map_ctc.end() && !(v_hash[i] < it->first))
+          {
+            it_prev = it; // already in the graph
+            continue;
+          }
+        }
+
+        m_frozen = false;
+        v_new_ctc[i] = new Contractor(Contractor(*v_items[i].first, v_items[i].second));
+        it_prev = m_map_ctc.emplace_hint(it, std::move(v_hash[i]), v_new_ctc[i]);
+      }
+
+      // Third pass: queuing and linking the new contractors in the order of the batch,
+      // with storage reserved once per domain
+
+      unordered_map<Domain*,size_t> nb_new_links;
+      for(size_t i = 0 ; i < v_new_ctc.size() ; i++)
+        if(v_new_ctc[i] != NULL)
+          for(auto& dom : v_items[i].second)
+            nb_new_links[dom]++;
+
+      for(auto& dom_links : nb_new_links)
+        dom_links.first->contractors().reserve(dom_links.first->contractors().size() + dom_links.second);
+
+      for(size_t i = 0 ; i < v_new_ctc.size() ; i++)
+        if(v_new_ctc[i] != NULL)
+        {
+          add_ctc_to_queue(v_new_ctc[i], m_deque);
+          for(auto& dom : v_items[i].second)
+            dom->add_ctc(v_new_ctc[i]);
+        }
+    }
+
+    void ContractorNetwork::add(const vector<pair<DynCtc*,vector<Domain> > >& v_batch)
+    {
+      // Dynamical contractors may involve specific treatments (CtcEval, CtcDeriv,
+      // breakdown into slices): they are added one by one
+      for(const auto& item : v_batch)
+      {
+        assert(item.first != NULL);
+        add(*item.first, item.second);
+      }
+    }
+
+    void ContractorNetwork::break_down_static_ctc(bool breakdown)
+    {
+      m_static_ctc_breakdown = breakdown;
+    }
+
     void ContractorNetwork::add_data(Tube& tube, double t, const Interval& y)
     {
       Domain *ad = add_dom(Domain(tube));
@@ -390,6 +556,277 @@ namespace tubex
       ad->add_data(t, y, *this);
     }
 
+    // Frozen network
+
+    void ContractorNetwork::freeze()
+    {
+      CompactGraph& g = m_graph;
+
+      g.v_doms.clear(); g.v_ctc.clear();
+      g.dom_start.clear(); g.dom_adj.clear();
+      g.ctc_start.clear(); g.ctc_adj.clear();
+
+      g.v_doms.reserve(m_map_domains.size());
+      for(const auto& dom : m_map_domains)
+      {
+        dom.second->m_graph_index = g.v_doms.size();
+        g.v_doms.push_back(dom.second);
+      }
+
+      g.v_ctc.reserve(m_map_ctc.size());
+      size_t nb_links = 0;
+      for(const auto& ctc : m_map_ctc)
+      {
+        ctc.second->m_graph_index = g.v_ctc.size();
+        g.v_ctc.push_back(ctc.second);
+        nb_links += ctc.second->domains().size();
+      }
+
+      // Rows follow the order of the links, which defines the order of the propagation
+
+      g.dom_start.reserve(g.v_doms.size() + 1);
+      g.dom_adj.reserve(nb_links);
+      for(const auto& dom : g.v_doms)
+      {
+        g.dom_start.push_back(g.dom_adj.size());
+        for(const auto& ctc : dom->contractors())
+          g.dom_adj.push_back(ctc->m_graph_index);
+      }
+      g.dom_start.push_back(g.dom_adj.size());
+
+      g.ctc_start.reserve(g.v_ctc.size() + 1);
+      g.ctc_adj.reserve(nb_links);
+      for(const auto& ctc : g.v_ctc)
+      {
+        g.ctc_start.push_back(g.ctc_adj.size());
+        for(const auto& dom : ctc->domains())
+        {
+          assert(dom->m_graph_index >= 0 && "domain not registered in the network");
+          g.ctc_adj.push_back(dom->m_graph_index);
+        }
+      }
+      g.ctc_start.push_back(g.ctc_adj.size());
+
+      m_frozen = true;
+    }
+
+    bool ContractorNetwork::is_frozen() const
+    {
+      return m_frozen;
+    }
+
+    // Reusing the network (cycles)
+
+    void ContractorNetwork::rebind(Interval& i, const Interval& value)
+    {
+      rebound_dom(Domain(i));
+      i = value;
+    }
+
+    void ContractorNetwork::rebind(IntervalVector& iv, const IntervalVector& value)
+    {
+      if(iv.size() != value.size())
+        throw Exception(__func__, "new value not of same dimension");
+
+      rebound_dom(Domain(iv));
+      iv = value; // same storage, referenced by the components
+    }
+
+    void ContractorNetwork::rebind(Tube& x, const Tube& value)
+    {
+      if(!Tube::same_slicing(x, value))
+        throw Exception(__func__, "new value not of same slicing");
+
+      Domain *dom = rebound_dom(Domain(x));
+      const Interval bounded_domain(-99999.,99999.); // as for tubes added to the CN
+
+      const Slice *s_value = value.first_slice();
+      for(Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        s->set_envelope(s_value->codomain() & bounded_domain, false);
+        s->set_input_gate(s_value->input_gate() & bounded_domain, false);
+        s->set_output_gate(s_value->output_gate() & bounded_domain, false);
+        s_value = s_value->next_slice();
+      }
+
+      // Data of the previous cycle
+      dom->m_traj_lb = Trajectory();
+      dom->m_traj_ub = Trajectory();
+    }
+
+    void ContractorNetwork::rebind(Tube& x, const Interval& codomain)
+    {
+      Domain *dom = rebound_dom(Domain(x));
+      x.set(codomain & Interval(-99999.,99999.));
+
+      dom->m_traj_lb = Trajectory();
+      dom->m_traj_ub = Trajectory();
+    }
+
+    void ContractorNetwork::rebind(TubeVector& x, const TubeVector& value)
+    {
+      if(!TubeVector::same_slicing(x, value))
+        throw Exception(__func__, "new value not of same slicing");
+
+      rebound_dom(Domain(x));
+      for(int i = 0 ; i < x.size() ; i++)
+        rebind(x[i], value[i]);
+    }
+
+    // Sliding window (online estimation)
+
+    void ContractorNetwork::slide_window(double t, bool keep_prior)
+    {
+      m_frozen = false; // links are updated at the window bounds
+
+      const Interval bounded_domain(-99999.,99999.); // as for tubes added to the CN
+
+      // The structure of the tubes is changed: previous states cannot be restored
+      m_trail.clear();
+      m_v_saved_deques.clear();
+
+      // Components of tube vectors are also registered as tube domains
+      vector<Domain*> v_tubes;
+      for(const auto& dom : m_map_domains)
+        if(dom.second->type() == Domain::Type::T_TUBE)
+          v_tubes.push_back(dom.second);
+
+      // Contractors to be applied on the recycled part of the window
+      auto requeue = [&](Contractor *ctc, const Interval& changed_tdomain)
+      {
+        ctc->set_changed_tdomain(ctc->changed_tdomain() | changed_tdomain);
+        if(!ctc->is_active())
+        {
+          ctc->set_active(true);
+          add_ctc_to_queue(ctc, m_deque);
+        }
+      };
+
+      for(auto& dom : v_tubes)
+      {
+        Tube& x = dom->tube();
+
+        Slice *s_first = x.first_slice(), *s_last = x.last_slice();
+        Slice *s_new_first = s_first;
+        while(s_new_first != NULL && s_new_first->tdomain().ub() <= t)
+          s_new_first = s_new_first->next_slice();
+
+        if(s_new_first == s_first)
+          continue; // nothing to evict
+
+        // The slice<->slice dependency at the new window start is broken,
+        // and a new one is created at the end of the tube
+        if(s_new_first != NULL)
+        {
+          Domain *dom_prev = add_dom(Domain(*s_new_first->prev_slice()));
+          Domain *dom_next = add_dom(Domain(*s_new_first));
+
+          for(auto& ctc : dom_next->contractors())
+            if(ctc->type() == Contractor::Type::T_COMPONENT
+              && ctc->domains().size() == 2
+              && find(ctc->domains().begin(), ctc->domains().end(), dom_prev) != ctc->domains().end())
+            {
+              remove_ctc(ctc);
+              break;
+            }
+        }
+
+        x.slide_tdomain(t);
+
+        if(s_new_first != NULL)
+        {
+          Domain *dom_prev = add_dom(Domain(*s_last));
+          Domain *dom_next = add_dom(Domain(*s_first));
+          Contractor *ac_component_slices = add_ctc(Contractor(Contractor::Type::T_COMPONENT, {dom_prev, dom_next}));
+          dom_prev->add_ctc(ac_component_slices);
+          dom_next->add_ctc(ac_component_slices);
+        }
+
+        Interval recycled_tdomain = Interval::EMPTY_SET;
+        if(!keep_prior)
+        {
+          x.first_slice()->set_input_gate(bounded_domain, false);
+          recycled_tdomain = Interval(x.tdomain().lb());
+        }
+
+        // Recycled slices: bounded domains, related contractors to be triggered
+        for(Slice *s = s_first ; s != NULL && s != s_new_first ; s = s->next_slice())
+        {
+          s->set_envelope(bounded_domain, false);
+          s->set_output_gate(bounded_domain, false);
+          recycled_tdomain |= s->tdomain();
+
+          Domain *dom_s = add_dom(Domain(*s));
+          dom_s->set_volume(dom_s->compute_volume());
+
+          // Contractors defined on the evicted slice are retired,
+          // only the links with the tube and the other slices are kept
+          vector<Contractor*> v_slice_ctc;
+          for(auto& ctc : dom_s->contractors())
+            if(ctc->type() != Contractor::Type::T_COMPONENT)
+              v_slice_ctc.push_back(ctc);
+
+          for(auto& ctc : v_slice_ctc)
+            remove_ctc(ctc);
+
+          for(auto& ctc : dom_s->contractors())
+            requeue(ctc, s->tdomain());
+        }
+
+        // Contractors defined on the whole tube (or on a tube vector
+        // containing it) are triggered on the recycled part of the window
+        for(auto& ctc : dom->contractors())
+        {
+          requeue(ctc, recycled_tdomain);
+
+          if(ctc->type() == Contractor::Type::T_COMPONENT)
+            for(auto& dom_vector : ctc->domains())
+              if(dom_vector->type() == Domain::Type::T_TUBE_VECTOR)
+                for(auto& ctc_vector : dom_vector->contractors())
+                  requeue(ctc_vector, recycled_tdomain);
+        }
+
+        // Data streamed before the window are forgotten
+        if(!dom->m_traj_lb.not_defined()
+          && dom->m_traj_lb.tdomain().interior_contains(x.tdomain().lb()))
+        {
+          Interval t_data(x.tdomain().lb(), dom->m_traj_lb.tdomain().ub());
+          dom->m_traj_lb.truncate_tdomain(t_data);
+          dom->m_traj_ub.truncate_tdomain(t_data);
+        }
+      }
+
+      // Retiring evaluation contractors whose time reference is outside the window
+      vector<Contractor*> v_ctc_to_remove;
+      for(const auto& ctc : m_map_ctc)
+        if(ctc.second->type() == Contractor::Type::T_TUBEX
+          && typeid(ctc.second->tubex_ctc()) == typeid(CtcEval))
+        {
+          const vector<Domain*>& v_domains = ctc.second->domains();
+          if(v_domains.size() < 3 || v_domains[0]->type() != Domain::Type::T_INTERVAL)
+            continue;
+
+          Interval tdomain;
+          if(v_domains[2]->type() == Domain::Type::T_TUBE)
+            tdomain = v_domains[2]->tube().tdomain();
+          else if(v_domains[2]->type() == Domain::Type::T_TUBE_VECTOR)
+            tdomain = v_domains[2]->tube_vector().tdomain();
+          else
+            continue;
+
+          if(!v_domains[0]->interval().intersects(tdomain))
+            v_ctc_to_remove.push_back(ctc.second);
+        }
+
+      for(auto& ctc : v_ctc_to_remove)
+        remove_ctc(ctc);
+
+      // Updating volumes of the tubes, now defined on the new window
+      for(const auto& dom : m_map_domains)
+        if(dom.second->type() == Domain::Type::T_TUBE || dom.second->type() == Domain::Type::T_TUBE_VECTOR)
+          dom.second->set_volume(dom.second->compute_volume());
+    }
+
   // Protected methods
 
     Domain* ContractorNetwork::add_dom(const Domain& ad)
@@ -399,11 +836,14 @@ namespace tubex
 
       DomainHashcode hash(ad);
 
-      if(m_map_domains.find(hash) != m_map_domains.end())
-        return m_map_domains[hash];
+      // One single lookup in the map, for both search and insertion
+      map<DomainHashcode,Domain*>::iterator it = m_map_domains.lower_bound(hash);
+      if(it != m_map_domains.end() && !(hash < it->first))
+        return it->second;
     
+      m_frozen = false; // the structure of the graph is changed
       Domain *new_dom = new Domain(ad);
-      m_map_domains[hash] = new_dom;
+      m_map_domains.emplace_hint(it, hash, new_dom);
 
       // And add possible dependencies
 
@@ -414,7 +854,8 @@ namespace tubex
             break;
 
           case Domain::Type::T_SLICE:
-            // nothing to do
+            // The slice will record its values in the trail before any change
+            m_trail.attach(new_dom->slice());
             break;
 
           case Domain::Type::T_TUBE_VECTOR:
@@ -423,6 +864,7 @@ namespace tubex
             v_doms[0] = new_dom;
             for(int i = 0 ; i < new_dom->tube_vector().size() ; i++)
               v_doms[i+1] = add_dom(Domain(new_dom->tube_vector()[i]));
+            new_dom->m_v_components.assign(v_doms.begin() + 1, v_doms.end());
 
             Contractor *ac_component = add_ctc(Contractor(Contractor::Type::T_COMPONENT, v_doms));
 
@@ -476,6 +918,10 @@ namespace tubex
               dom_i1->add_ctc(ac_component_slices);
               dom_i2->add_ctc(ac_component_slices);
             }
+
+            // Changes on the slices are reported in the window of the tube
+            for(Slice *s = new_dom->tube().first_slice() ; s != NULL ; s = s->next_slice())
+              s->m_changed_tdomain = &new_dom->m_changed_tdomain;
           }
           break;
         }
@@ -483,15 +929,44 @@ namespace tubex
       return new_dom;
     }
 
+    Domain* ContractorNetwork::cached_dom(const Domain& ad, unordered_map<uintptr_t,Domain*>& cache)
+    {
+      uintptr_t hash = DomainHashcode::uintptr(ad);
+      unordered_map<uintptr_t,Domain*>::const_iterator it = cache.find(hash);
+
+      if(it != cache.end())
+        return it->second;
+
+      Domain *dom = add_dom(ad);
+      cache.emplace(hash, dom);
+      return dom;
+    }
+
+    Domain* ContractorNetwork::rebound_dom(const Domain& ad)
+    {
+      map<DomainHashcode,Domain*>::const_iterator it = m_map_domains.find(DomainHashcode(ad));
+      if(it == m_map_domains.end())
+        throw Exception(__func__, "rebound domain not involved in the network");
+
+      // Previous values are not recorded: they cannot be restored
+      m_trail.clear();
+      m_v_saved_deques.clear();
+
+      return it->second;
+    }
+
     Contractor* ContractorNetwork::add_ctc(const Contractor& ac)
     {
       ContractorHashcode hash(ac);
-      map<ContractorHashcode,Contractor*>::iterator it = m_map_ctc.find(hash);
 
-      if(it == m_map_ctc.end())
+      // One single lookup in the map, for both search and insertion
+      map<ContractorHashcode,Contractor*>::iterator it = m_map_ctc.lower_bound(hash);
+
+      if(it == m_map_ctc.end() || hash < it->first)
       {
+        m_frozen = false;
         Contractor *new_ctc = new Contractor(ac);
-        m_map_ctc[hash] = new_ctc;
+        m_map_ctc.emplace_hint(it, hash, new_ctc);
         add_ctc_to_queue(new_ctc, m_deque);
         return new_ctc;
       }
@@ -499,4 +974,20 @@ namespace tubex
       else
         return it->second;
     }
+
+    void ContractorNetwork::remove_ctc(Contractor *ac)
+    {
+      assert(ac != NULL);
+      m_frozen = false;
+      m_map_ctc.erase(ContractorHashcode(*ac));
+
+      for(auto& dom : ac->domains())
+      {
+        vector<Contractor*>& v_ctc = dom->contractors();
+        v_ctc.erase(std::remove(v_ctc.begin(), v_ctc.end(), ac), v_ctc.end());
+      }
+
+      m_deque.erase(std::remove(m_deque.begin(), m_deque.end(), ac), m_deque.end());
+      delete ac;
+    }
 }
\ No newline at end of file
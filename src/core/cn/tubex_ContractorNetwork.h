@@ -12,10 +12,16 @@
 #ifndef __TUBEX_CONTRACTORNETWORK_H__
 #define __TUBEX_CONTRACTORNETWORK_H__
 
+#include <set>
 #include <deque>
+#include <unordered_map>
+#include <functional>
 #include <initializer_list>
 #include "ibex_Ctc.h"
 #include "tubex_DynCtc.h"
+#include "tubex_Deadline.h"
+#include "tubex_Trail.h"
+#include "tubex_Tube.h"
 #include "tubex_Domain.h"
 #include "tubex_Contractor.h"
 #include "tubex_CtcDeriv.h"
@@ -35,6 +41,42 @@ namespace tubex
   class DomainHashcode;
   class ContractorHashcode;
 
+  /**
+   * \struct ContractionResult
+   * \brief Outcome of a contraction process that may have been interrupted
+   *        before reaching a fixed point (see ContractorNetwork::contract_during)
+   */
+  struct ContractionResult
+  {
+    bool completed; //!< `true` if a fixed point has been reached, `false` if the process has been interrupted
+    int nb_ctc_in_stack; //!< number of contractors remaining in the queue, processed first during the next call
+    double duration; //!< wall-clock computation time in seconds
+  };
+
+  /**
+   * \enum SearchStrategy
+   * \brief Order in which the nodes of a search tree are explored (see ContractorNetwork::solve)
+   */
+  enum class SearchStrategy
+  {
+    DEPTH_FIRST, ///< depth-first search: states are restored from the trail when backtracking
+    BEST_FIRST ///< nodes whose parent has the smallest volume first (sum of the volumes of the bisected domains after contraction): states are recomputed from the root
+  };
+
+  /**
+   * \struct SolverResult
+   * \brief Solutions and statistics of a branch-and-prune exploration (see ContractorNetwork::solve)
+   */
+  struct SolverResult
+  {
+    std::vector<ibex::IntervalVector> boxes; //!< for each solution, values of the bisected intervals and interval vectors (concatenated), if any
+    std::vector<std::vector<Tube> > tubes; //!< for each solution, values of the bisected tubes, if any
+    int nb_solutions; //!< number of solutions: nodes that cannot be bisected anymore
+    int nb_nodes; //!< number of explored (contracted) nodes of the search tree
+    bool completed; //!< `false` if the exploration has been interrupted by the deadline
+    double duration; //!< wall-clock computation time in seconds
+  };
+
   /**
    * \class ContractorNetwork
    * \brief Graph of contractors and domains that model a problem in the constraint
@@ -193,6 +235,45 @@ namespace tubex
        */
       void add(DynCtc& dyn_ctc, const std::vector<Domain>& v_domains);
 
+      /**
+       * \brief Adds to the graph a batch of static contractors with their related Domains
+       *
+       * This bulk method is suited for large networks (for instance, \f$10^5\f$ contractors
+       * or more). Domains are deduplicated by hashing. Contractors are sorted by hashcode and
+       * merged into the graph with hinted insertions (constant time when the network is
+       * built in one batch, logarithmic for each contractor that does not follow the previous
+       * one in the graph). The graph is then linked in one pass, with storage reserved once
+       * for each domain.
+       *
+       * \note The result is the same as a sequence of calls to add(ibex::Ctc&, const std::vector<Domain>&).
+       *       Items involving dynamical domains are broken down into slices as with this method.
+       *
+       * \param v_batch vector of pairs (pointer to a static contractor, vector of related domains)
+       */
+      void add(const std::vector<std::pair<ibex::Ctc*,std::vector<Domain> > >& v_batch);
+
+      /**
+       * \brief Adds to the graph a batch of dynamic contractors with their related Domains
+       *
+       * \note The result is the same as a sequence of calls to add(DynCtc&, const std::vector<Domain>&).
+       *
+       * \param v_batch vector of pairs (pointer to a dynamic contractor, vector of related domains)
+       */
+      void add(const std::vector<std::pair<DynCtc*,std::vector<Domain> > >& v_batch);
+
+      /**
+       * \brief Specifies whether the static contractors (CtcStatic) added afterwards on tubes
+       *        are broken down into slices or not
+       *
+       * By default, a CtcStatic added on tubes is broken down into one contractor per row
+       * of slices. Otherwise, a single contractor is kept over the whole tubes: the network
+       * is lighter, and the slices can be contracted in parallel (see CtcStatic::set_nb_threads()).
+       * Only the slices concerned by the changes are contracted again during the propagation.
+       *
+       * \param breakdown if `true` (default), one contractor per row of slices
+       */
+      void break_down_static_ctc(bool breakdown = true);
+
       /**
        * \brief Adds continuous data \f$[y]\f$ to a tube \f$[x](\cdot)\f$ at \f$t\f$ (used for realtime applications).
        *
@@ -223,6 +304,113 @@ namespace tubex
        */
       void add_data(TubeVector& x, double t, const ibex::IntervalVector& y);
 
+      /// @}
+      /// \name Frozen network
+      /// @{
+
+      /**
+       * \brief Freezes the structure of the network, once built
+       *
+       * The links between domains and contractors are copied in a compact adjacency
+       * (compressed sparse rows of indices), traversed by the propagation process
+       * instead of the vectors of pointers owned by each node of the graph.
+       *
+       * \note The network can still be modified afterwards (new domains or contractors,
+       *       sliding window): it is then automatically unfrozen, and freeze() has to be
+       *       called again to benefit from the compact representation.
+       */
+      void freeze();
+
+      /**
+       * \brief Returns `true` if the structure of the network is frozen (see freeze())
+       *
+       * \return frozen test
+       */
+      bool is_frozen() const;
+
+      /// @}
+      /// \name Reusing the network (cycles)
+      /// @{
+
+      /**
+       * \brief Resets the value of an Interval domain of the network, for a new cycle
+       *        of computations with the same graph
+       *
+       * The structure of the network (domains, contractors, links, hashes and the compact
+       * graph of a frozen network) is kept as it is: nothing is allocated. The contractors
+       * are not triggered by this method: trigger_all_contractors() has to be called once all
+       * the domains of the cycle have been reset. Saved states (see save_state()) are discarded.
+       *
+       * \param i Interval domain, already involved in the network
+       * \param value new value of the domain
+       */
+      void rebind(ibex::Interval& i, const ibex::Interval& value);
+
+      /**
+       * \brief Resets the value of an IntervalVector domain of the network, for a new cycle
+       *        (see rebind(ibex::Interval&, const ibex::Interval&))
+       *
+       * \param iv IntervalVector domain, already involved in the network
+       * \param value new value of the domain, of same dimension
+       */
+      void rebind(ibex::IntervalVector& iv, const ibex::IntervalVector& value);
+
+      /**
+       * \brief Resets the envelope and the gates of a Tube domain of the network, for a new cycle
+       *        (see rebind(ibex::Interval&, const ibex::Interval&))
+       *
+       * Slices are updated in place. Data provided with add_data() during the previous
+       * cycle are forgotten.
+       *
+       * \param x Tube domain, already involved in the network
+       * \param value new values of the tube, with the same slicing
+       */
+      void rebind(Tube& x, const Tube& value);
+
+      /**
+       * \brief Resets all the slices of a Tube domain of the network to a codomain, for a new cycle
+       *        (see rebind(Tube&, const Tube&))
+       *
+       * \param x Tube domain, already involved in the network
+       * \param codomain new value of the envelopes and gates of the slices
+       */
+      void rebind(Tube& x, const ibex::Interval& codomain);
+
+      /**
+       * \brief Resets the envelopes and the gates of a TubeVector domain of the network, for a new cycle
+       *        (see rebind(Tube&, const Tube&))
+       *
+       * \param x TubeVector domain, already involved in the network
+       * \param value new values of the tube, with the same dimension and slicing
+       */
+      void rebind(TubeVector& x, const TubeVector& value);
+
+      /// @}
+      /// \name Sliding window (online estimation)
+      /// @{
+
+      /**
+       * \brief Moves forward the temporal window of the tubes involved in the network
+       *
+       * For long runs, tubes can be defined on a sliding time horizon, so that memory and
+       * propagation costs remain constant. The slices entirely defined before \f$t\f$ are
+       * evicted from the beginning of each tube and recycled at its end, with unbounded
+       * codomains (see Tube::slide_tdomain()).
+       *
+       * Contractors defined on the whole tubes are triggered on the recycled part of the
+       * window. Contractors defined on evicted slices (for instance static constraints
+       * added slice by slice) are retired from the network: constraints that must hold on
+       * the new slices have to be added again. Evaluation contractors (CtcEval) whose time reference is now outside the window
+       * are retired from the network. Data provided with add_data() before the window
+       * are forgotten. Saved states (see save_state()) are discarded.
+       *
+       * \param t new lower bound of the window, snapped to the next gate of each tube
+       * \param keep_prior if `true` (default), the initial gate of each tube keeps the
+       *        information propagated from the evicted past, as an interval prior; otherwise
+       *        this gate is reset
+       */
+      void slide_window(double t, bool keep_prior = true);
+
       /// @}
       /// \name Contraction process
       /// @{
@@ -241,15 +429,37 @@ namespace tubex
        * \brief Launch the contraction process and stops after \f$dt\f$ seconds
        *
        * Contractions are performed until a fixed point has been obtained on the whole graph,
-       * or if the computation time limit has been reached.
+       * or if the computation time limit has been reached. Time is measured with a
+       * monotonic wall clock.
+       *
+       * The dynamical contractors of the library (CtcDeriv, CtcEval, CtcPicard, CtcLinobs,
+       * CtcStatic, CtcDelay) check the deadline between slices and may yield before
+       * the end of their computations. Static contractors (ibex::Ctc) and user-defined
+       * DynCtc that do not test the deadline are not interruptible: the time limit
+       * is then only checked between two contractions. Interrupted contractors are kept
+       * at the front of the queue together with their window of changes: the next call
+       * resumes the propagation with them. An interrupted contractor does not store
+       * its resume position and is restarted from the beginning of its computations
+       * (the contractions it already achieved are kept).
+       *
+       * \param dt allowed computation time in seconds
+       * \param verbose verbose mode, `false` by default
+       * \return the ContractionResult (completion, remaining contractors, computation time)
+       */
+      ContractionResult contract_during(double dt, bool verbose = false);
+
+      /**
+       * \brief Launch the contraction process until a fixed point is reached or the
+       *        deadline expires
        *
-       * Note that the computation time may slightly exceed \f$dt\f$.
+       * \note The deadline can be cancelled from another thread, which interrupts
+       *       the propagation (see Deadline::cancel()).
        *
-       * \param dt allowed computation time
+       * \param deadline time budget and cancellation token
        * \param verbose verbose mode, `false` by default
-       * \return the computation time in seconds
+       * \return the ContractionResult (completion, remaining contractors, computation time)
        */
-      double contract_during(double dt, bool verbose = false);
+      ContractionResult contract(Deadline& deadline, bool verbose = false);
 
       /**
        * \brief Sets the fixed point ratio defining the end of the propagation process.
@@ -271,7 +481,8 @@ namespace tubex
        * \brief Triggers on all contractors involved in the graph.
        *
        * This method can be used to reset the propagation process when domains have been updated
-       * externally: outside the ContractorNetwork.
+       * externally: outside the ContractorNetwork. The volumes of the domains used for
+       * the fixed point detection are updated accordingly.
        */
       void trigger_all_contractors();
 
@@ -284,6 +495,91 @@ namespace tubex
        */
       int nb_ctc_in_stack() const;
 
+      /// @}
+      /// \name Checkpoints
+      /// @{
+
+      /**
+       * \brief Saves the current state of the domains (checkpoint), before further contractions.
+       *
+       * Nothing is copied at this time: the values of intervals and slices are then
+       * recorded in a trail (undo log) just before being contracted, so that the cost of
+       * restore_state() is proportional to what has been contracted since the checkpoint,
+       * and not to the size of the network. Checkpoints can be nested.
+       *
+       * \note Only changes made by the contractors of the network or by slice setters are
+       *       recorded. Intervals modified from outside the network are not.
+       *
+       * \return the number of saved states, including this one
+       */
+      int save_state();
+
+      /**
+       * \brief Restores the domains as they were during the last call to save_state(),
+       *        together with the queue of active contractors, and forgets this checkpoint
+       */
+      void restore_state();
+
+      /**
+       * \brief Forgets the last checkpoint, while keeping the current values of the domains
+       */
+      void discard_state();
+
+      /**
+       * \brief Returns the number of saved states that can be restored
+       *
+       * \return number of nested checkpoints
+       */
+      int nb_saved_states() const;
+
+      /// @}
+      /// \name Branch and prune
+      /// @{
+
+      /**
+       * \brief Explores a search tree by bisecting some domains of the network, and by using
+       *        the contraction process as pruning operator
+       *
+       * At each node, the largest component (interval, component of an interval vector,
+       * or gate of a tube) is bisected until all of them are smaller than \f$\epsilon\f$.
+       * Nodes leading to an empty set are discarded. States are saved and restored with
+       * the trail of the network (see save_state()): the domains are restored at the end
+       * of the exploration, and the solutions are returned as copies.
+       *
+       * \param v_domains domains to be bisected, already involved in the network:
+       *        intervals, interval vectors or tubes
+       * \param eps precision of the solutions
+       * \param strategy exploration order of the nodes (depth-first by default)
+       * \param timeout allowed computation time in seconds, unbounded by default
+       * \param verbose verbose mode, `false` by default
+       * \return the SolverResult (solutions and statistics)
+       */
+      SolverResult solve(const std::vector<Domain>& v_domains, double eps,
+        SearchStrategy strategy = SearchStrategy::DEPTH_FIRST,
+        double timeout = POS_INFINITY, bool verbose = false);
+
+      /**
+       * \brief Explores a search tree on several threads, each of them handling
+       *        independent branches on its own network
+       *
+       * The networks are built one after the other in the calling thread, so that the
+       * `build` function may create new objects (contractors, domains with create_dom())
+       * at each call. Objects shared by the networks must be thread-safe.
+       * Independent branches are first obtained by a breadth-first exploration.
+       *
+       * \param build function adding the contractors and domains to an empty network,
+       *        and returning the domains to be bisected
+       * \param nb_threads number of threads (and networks)
+       * \param eps precision of the solutions
+       * \param strategy exploration order of the nodes in each branch (depth-first by default)
+       * \param timeout allowed computation time in seconds, unbounded by default
+       * \param verbose verbose mode, `false` by default
+       * \return the SolverResult (solutions and statistics), merged over the threads
+       */
+      static SolverResult solve(const std::function<std::vector<Domain>(ContractorNetwork&)>& build,
+        int nb_threads, double eps, SearchStrategy strategy = SearchStrategy::DEPTH_FIRST,
+        double timeout = POS_INFINITY, bool verbose = false);
+
       /// @}
       /// \name Visualization
       /// @{
@@ -352,6 +648,24 @@ namespace tubex
        */
       Domain* add_dom(const Domain& ad);
 
+      /**
+       * \brief Adds an abstract Domain to the graph, with a local cache for bulk operations
+       *
+       * \param ad abstract Domain object
+       * \param cache hash table of the domains already resolved
+       * \return the pointer to the related Domain object in the graph
+       */
+      Domain* cached_dom(const Domain& ad, std::unordered_map<std::uintptr_t,Domain*>& cache);
+
+      /**
+       * \brief Returns the Domain of the graph whose values are about to be reset by rebind(),
+       *        and discards the saved states
+       *
+       * \param ad abstract Domain object
+       * \return the pointer to the related Domain object in the graph
+       */
+      Domain* rebound_dom(const Domain& ad);
+
       /**
        * \brief Adds an abstract Contractor to the graph
        *
@@ -375,11 +689,101 @@ namespace tubex
       /**
        * \brief Triggers on the contractors related to the given Domain
        *
+       * The window of the changes on tubes is transmitted to the related dynamical
+       * contractors, that are not triggered if they do not depend on it.
+       *
        * \param dom pointer to the Domain
        * \param ctc_to_avoid optional pointer to a Contractor to not activate
        */
       void trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = NULL);
 
+      /**
+       * \brief Returns the temporal window of the changes on a domain since its last trigger
+       *
+       * \param dom pointer to the Domain
+       * \return union of the tdomains of the changed slices for tubes (possibly empty),
+       *         the whole temporal domain for other domains
+       */
+      ibex::Interval changed_tdomain_of(Domain *dom);
+
+      /**
+       * \brief Retires a Contractor from the graph and deletes it
+       *
+       * \param ac pointer to the Contractor to be removed
+       */
+      void remove_ctc(Contractor *ac);
+
+      /**
+       * \struct Decision
+       * \brief Bisection choice that can be replayed on another network built identically
+       */
+      struct Decision
+      {
+        int dom; //!< index of the bisected domain
+        int i; //!< index of the component (interval vector) or of the gate (tube)
+        ibex::Interval value; //!< half of the component kept in this branch
+      };
+
+      /**
+       * \brief Returns the domains of the network corresponding to the ones to be bisected
+       *
+       * \param v_domains abstract domains: intervals, interval vectors or tubes
+       * \return pointers to the Domain objects of the graph
+       */
+      std::vector<Domain*> bisected_domains(const std::vector<Domain>& v_domains);
+
+      /**
+       * \brief Selects the largest bisectable component of the given domains
+       *
+       * \param v_doms bisected domains
+       * \param eps precision: smaller components are not bisected
+       * \param left decision corresponding to the first half
+       * \param right decision corresponding to the second half
+       * \param width diameter of the selected component
+       * \return `false` if no component can be bisected (the node is a solution)
+       */
+      bool select_bisection(const std::vector<Domain*>& v_doms, double eps,
+        Decision& left, Decision& right, double& width) const;
+
+      /**
+       * \brief Contracts a bisected component to the value of the decision (recorded
+       *        in the trail), and triggers the related contractors
+       *
+       * \param v_doms bisected domains
+       * \param d bisection decision
+       */
+      void apply_decision(const std::vector<Domain*>& v_doms, const Decision& d);
+
+      /**
+       * \brief Explores the subtree defined by a list of decisions from the current state
+       *
+       * \param v_doms bisected domains
+       * \param root decisions defining the root node of the subtree
+       * \param eps precision of the solutions
+       * \param strategy exploration order
+       * \param deadline time budget shared by the exploration
+       * \param result solutions and statistics to be completed
+       * \param max_frontier if `v_frontier` is set, the breadth-first exploration stops
+       *        when this number of pending nodes has been reached
+       * \param v_frontier optional output of the pending nodes, as independent branches
+       */
+      void branch_and_prune(const std::vector<Domain*>& v_doms, const std::vector<Decision>& root,
+        double eps, SearchStrategy strategy, Deadline& deadline, SolverResult& result,
+        std::size_t max_frontier = 0, std::vector<std::vector<Decision> > *v_frontier = NULL);
+
+      /**
+       * \struct CompactGraph
+       * \brief Adjacency of a frozen network, stored in compressed sparse rows (CSR):
+       *        the neighbours of the node k are listed in `adj[start[k]]` to `adj[start[k+1]-1]`
+       */
+      struct CompactGraph
+      {
+        std::vector<Domain*> v_doms; //!< domains of the network, by index
+        std::vector<Contractor*> v_ctc; //!< contractors of the network, by index
+        std::vector<int> dom_start, dom_adj; //!< indices of the contractors of each domain
+        std::vector<int> ctc_start, ctc_adj; //!< indices of the domains of each contractor
+      };
+
     protected:
 
       std::map<DomainHashcode,Domain*> m_map_domains; //!< pointers to the abstract Domain objects the graph is made of
@@ -387,10 +791,16 @@ namespace tubex
       std::deque<Contractor*> m_deque; //!< queue of active contractors
 
       float m_fixedpoint_ratio = 0.0001; //!< fixed point ratio for propagation limit
-      double m_contraction_duration_max = std::numeric_limits<double>::infinity(); //!< computation time limit
 
       CtcDeriv *m_ctc_deriv = NULL; //!< optional pointer to a CtcDeriv object that can be automatically added in the graph
-      std::list<std::pair<Domain*,Domain*> > m_domains_related_to_ctcderiv;
+      std::set<std::pair<Domain*,Domain*> > m_domains_related_to_ctcderiv; //!< couples of tubes already linked by m_ctc_deriv
+
+      Trail m_trail; //!< undo log of the domains contracted since the saved states
+      std::vector<std::deque<Contractor*> > m_v_saved_deques; //!< queues of active contractors at the saved states
+
+      bool m_static_ctc_breakdown = true; //!< if `false`, CtcStatic contractors are kept at the tube level
+      bool m_frozen = false; //!< if `true`, the propagation traverses m_graph
+      CompactGraph m_graph; //!< compact adjacency, built by freeze()
 
       friend class Domain;
   };
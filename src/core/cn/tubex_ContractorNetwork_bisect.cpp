@@ -0,0 +1,409 @@
+/** 
+ *  ContractorNetwork class : branch and prune
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <map>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include "tubex_ContractorNetwork.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Public methods
+
+    // Branch and prune
+
+    SolverResult ContractorNetwork::solve(const vector<Domain>& v_domains, double eps,
+      SearchStrategy strategy, double timeout, bool verbose)
+    {
+      assert(eps > 0.);
+
+      Deadline deadline(timeout);
+      SolverResult result;
+      result.nb_solutions = 0; result.nb_nodes = 0; result.completed = true;
+
+      branch_and_prune(bisected_domains(v_domains), vector<Decision>(), eps, strategy, deadline, result);
+      result.duration = deadline.elapsed_time();
+
+      if(verbose)
+        cout << "Branch and prune: " << result.nb_nodes << " nodes, "
+             << result.nb_solutions << " solutions, " << result.duration << "s"
+             << (result.completed ? "" : " (interrupted)") << endl;
+
+      return result;
+    }
+
+    SolverResult ContractorNetwork::solve(const function<vector<Domain>(ContractorNetwork&)>& build,
+      int nb_threads, double eps, SearchStrategy strategy, double timeout, bool verbose)
+    {
+      assert(nb_threads > 0);
+      assert(eps > 0.);
+
+      Deadline deadline(timeout);
+      SolverResult result;
+      result.nb_solutions = 0; result.nb_nodes = 0; result.completed = true;
+
+      // One network per thread, built in the calling thread
+
+        vector<ContractorNetwork*> v_cn(nb_threads);
+        vector<vector<Domain*> > v_doms(nb_threads);
+        for(int k = 0 ; k < nb_threads ; k++)
+        {
+          v_cn[k] = new ContractorNetwork();
+          v_doms[k] = v_cn[k]->bisected_domains(build(*v_cn[k]));
+        }
+
+      // Independent branches
+
+        vector<vector<Decision> > v_branches;
+        v_cn[0]->branch_and_prune(v_doms[0], vector<Decision>(), eps, strategy, deadline, result,
+                                  4*nb_threads, &v_branches);
+
+      // Parallel exploration of the branches
+
+        mutex mtx;
+        size_t next_branch = 0;
+
+        auto explore = [&](int k)
+        {
+          SolverResult local;
+          local.nb_solutions = 0; local.nb_nodes = 0; local.completed = true;
+
+          for(;;)
+          {
+            size_t b;
+            {
+              lock_guard<mutex> lock(mtx);
+              if(next_branch == v_branches.size())
+                break;
+              b = next_branch++;
+            }
+
+            v_cn[k]->branch_and_prune(v_doms[k], v_branches[b], eps, strategy, deadline, local);
+          }
+
+          lock_guard<mutex> lock(mtx);
+          result.boxes.insert(result.boxes.end(), local.boxes.begin(), local.boxes.end());
+          result.tubes.insert(result.tubes.end(), local.tubes.begin(), local.tubes.end());
+          result.nb_solutions += local.nb_solutions;
+          result.nb_nodes += local.nb_nodes;
+          result.completed &= local.completed;
+        };
+
+        vector<thread> v_threads;
+        for(int k = 0 ; k < nb_threads ; k++)
+          v_threads.push_back(thread(explore, k));
+        for(auto& th : v_threads)
+          th.join();
+
+      for(auto& cn : v_cn)
+        delete cn;
+
+      result.duration = deadline.elapsed_time();
+
+      if(verbose)
+        cout << "Branch and prune (" << nb_threads << " threads, " << v_branches.size() << " branches): "
+             << result.nb_nodes << " nodes, " << result.nb_solutions << " solutions, "
+             << result.duration << "s" << (result.completed ? "" : " (interrupted)") << endl;
+
+      return result;
+    }
+
+  // Protected methods
+
+    vector<Domain*> ContractorNetwork::bisected_domains(const vector<Domain>& v_domains)
+    {
+      vector<Domain*> v_doms;
+
+      for(const auto& dom : v_domains)
+      {
+        if(dom.type() != Domain::Type::T_INTERVAL
+          && dom.type() != Domain::Type::T_INTERVAL_VECTOR
+          && dom.type() != Domain::Type::T_TUBE)
+          throw Exception(__func__, "only intervals, interval vectors and tubes can be bisected");
+
+        map<DomainHashcode,Domain*>::const_iterator it = m_map_domains.find(DomainHashcode(dom));
+        if(it == m_map_domains.end())
+          throw Exception(__func__, "bisected domain not involved in the network");
+
+        v_doms.push_back(it->second);
+      }
+
+      return v_doms;
+    }
+
+    bool ContractorNetwork::select_bisection(const vector<Domain*>& v_doms, double eps,
+      Decision& left, Decision& right, double& width) const
+    {
+      int k_max = -1, i_max = -1;
+      const Interval *x_max = NULL;
+      width = 0.;
+
+      auto consider = [&](int k, int i, const Interval& x)
+      {
+        double w = x.diam();
+        if(w >= eps && w > width && x.is_bisectable())
+        {
+          k_max = k; i_max = i; x_max = &x;
+          width = w;
+        }
+      };
+
+      for(size_t k = 0 ; k < v_doms.size() ; k++)
+        switch(v_doms[k]->type())
+        {
+          case Domain::Type::T_INTERVAL:
+            consider(k, 0, v_doms[k]->interval());
+            break;
+
+          case Domain::Type::T_INTERVAL_VECTOR:
+            for(int i = 0 ; i < v_doms[k]->interval_vector().size() ; i++)
+              consider(k, i, v_doms[k]->interval_vector()[i]);
+            break;
+
+          case Domain::Type::T_TUBE:
+          {
+            // Gates are bisected: gate i is the input gate of the ith slice
+            int i = 0;
+            const Slice *s = v_doms[k]->tube().first_slice();
+            for( ; s != NULL ; s = s->next_slice())
+              consider(k, i++, s->input_gate());
+            consider(k, i, v_doms[k]->tube().last_slice()->output_gate());
+          }
+          break;
+
+          default:
+            assert(false && "unhandled bisected domain");
+        }
+
+      if(x_max == NULL)
+        return false;
+
+      pair<Interval,Interval> p = x_max->bisect();
+      left.dom = k_max; left.i = i_max; left.value = p.first;
+      right.dom = k_max; right.i = i_max; right.value = p.second;
+      return true;
+    }
+
+    void ContractorNetwork::apply_decision(const vector<Domain*>& v_doms, const Decision& d)
+    {
+      assert(d.dom >= 0 && d.dom < (int)v_doms.size());
+      Domain *dom = v_doms[d.dom];
+
+      // The contractors are activated whatever the fixed point ratio,
+      // with the temporal window of the change
+      Interval changed_tdomain = Interval::ALL_REALS;
+      auto activate = [this,&changed_tdomain](Domain *dom_to_trigger)
+      {
+        for(auto& ctc : dom_to_trigger->contractors())
+        {
+          ctc->set_changed_tdomain(ctc->changed_tdomain() | changed_tdomain);
+          if(!ctc->is_active())
+          {
+            ctc->set_active(true);
+            add_ctc_to_queue(ctc, m_deque);
+          }
+        }
+      };
+
+      switch(dom->type())
+      {
+        case Domain::Type::T_INTERVAL:
+          m_trail.record(&dom->interval());
+          dom->interval() &= d.value;
+          break;
+
+        case Domain::Type::T_INTERVAL_VECTOR:
+          m_trail.record(&dom->interval_vector()[d.i]);
+          dom->interval_vector()[d.i] &= d.value;
+          break;
+
+        case Domain::Type::T_TUBE:
+        {
+          // Slices record themselves in the trail
+          Tube& x = dom->tube();
+          Slice *s = x.slice(std::min(d.i, x.nb_slices()-1));
+
+          if(d.i < x.nb_slices())
+            s->set_input_gate(s->input_gate() & d.value);
+          else
+            s->set_output_gate(s->output_gate() & d.value);
+
+          changed_tdomain = s->tdomain();
+
+          activate(add_dom(Domain(*s)));
+        }
+        break;
+
+        default:
+          assert(false && "unhandled bisected domain");
+      }
+
+      activate(dom);
+    }
+
+    void ContractorNetwork::branch_and_prune(const vector<Domain*>& v_doms, const vector<Decision>& root,
+      double eps, SearchStrategy strategy, Deadline& deadline, SolverResult& result,
+      size_t max_frontier, vector<vector<Decision> > *v_frontier)
+    {
+      const int base = save_state(); // initial values, restored at the end
+      for(const auto& d : root)
+        apply_decision(v_doms, d);
+
+      Decision left, right;
+      double width, volume = 0.;
+
+      // Processing the current node: returns true if the node has to be bisected
+      auto process_node = [&]() -> bool
+      {
+        if(!contract(deadline).completed)
+        {
+          result.completed = false;
+          return false;
+        }
+
+        result.nb_nodes++;
+
+        if(emptiness())
+          return false;
+
+        if(select_bisection(v_doms, eps, left, right, width))
+        {
+          if(strategy == SearchStrategy::BEST_FIRST)
+          {
+            // Node measure: sum of the volumes of the bisected domains
+            volume = 0.;
+            for(const auto& dom : v_doms)
+              volume += dom->compute_volume();
+          }
+
+          return true;
+        }
+
+        // Solution
+        int n = 0;
+        vector<Tube> v_tubes;
+        for(const auto& dom : v_doms)
+          if(dom->type() == Domain::Type::T_INTERVAL) n++;
+          else if(dom->type() == Domain::Type::T_INTERVAL_VECTOR) n += dom->interval_vector().size();
+          else v_tubes.push_back(dom->tube());
+
+        if(n > 0)
+        {
+          IntervalVector box(n);
+          int i = 0;
+          for(const auto& dom : v_doms)
+            if(dom->type() == Domain::Type::T_INTERVAL)
+              box[i++] = dom->interval();
+            else if(dom->type() == Domain::Type::T_INTERVAL_VECTOR)
+            {
+              box.put(i, dom->interval_vector());
+              i += dom->interval_vector().size();
+            }
+          result.boxes.push_back(box);
+        }
+
+        if(!v_tubes.empty())
+          result.tubes.push_back(v_tubes);
+
+        result.nb_solutions++;
+        return false;
+      };
+
+      if(strategy == SearchStrategy::DEPTH_FIRST && v_frontier == NULL)
+      {
+        // Pending branches, with the number of saved states of their parent node:
+        // backtracking only restores what has been contracted since the parent
+
+        vector<pair<int,Decision> > v_stack;
+
+        if(process_node())
+        {
+          v_stack.push_back(make_pair(nb_saved_states(), right));
+          v_stack.push_back(make_pair(nb_saved_states(), left));
+        }
+
+        while(!v_stack.empty() && !deadline.expired())
+        {
+          pair<int,Decision> branch = v_stack.back();
+          v_stack.pop_back();
+
+          while(nb_saved_states() > branch.first)
+            restore_state();
+
+          save_state();
+          apply_decision(v_doms, branch.second);
+
+          if(process_node())
+          {
+            v_stack.push_back(make_pair(nb_saved_states(), right));
+            v_stack.push_back(make_pair(nb_saved_states(), left));
+          }
+        }
+
+        if(!v_stack.empty())
+          result.completed = false;
+      }
+
+      else
+      {
+        // Pending nodes are defined by their decisions from the root, and recomputed:
+        // best-first (ordered by the volume of their parent node, see process_node())
+        // or breadth-first (insertion order, for frontiers)
+
+        multimap<double,vector<Decision> > m_pending;
+        m_pending.emplace(0., vector<Decision>());
+        double nb_inserted = 0.;
+
+        while(!m_pending.empty() && !deadline.expired())
+        {
+          if(v_frontier != NULL && m_pending.size() >= max_frontier)
+            break;
+
+          vector<Decision> path = m_pending.begin()->second;
+          m_pending.erase(m_pending.begin());
+
+          while(nb_saved_states() > base)
+            restore_state();
+
+          save_state();
+          for(const auto& d : path)
+            apply_decision(v_doms, d);
+
+          if(process_node())
+          {
+            double key = (v_frontier != NULL) ? ++nb_inserted : volume;
+            path.push_back(left);
+            m_pending.emplace(key, path);
+            path.back() = right;
+            m_pending.emplace(key, path);
+          }
+        }
+
+        if(v_frontier != NULL)
+          for(const auto& node : m_pending)
+          {
+            vector<Decision> branch(root);
+            branch.insert(branch.end(), node.second.begin(), node.second.end());
+            v_frontier->push_back(branch);
+          }
+
+        else if(!m_pending.empty())
+          result.completed = false;
+      }
+
+      while(nb_saved_states() >= base)
+        restore_state();
+    }
+}
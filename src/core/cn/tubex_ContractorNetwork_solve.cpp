@@ -8,7 +8,6 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
-#include <time.h>
 #include "tubex_ContractorNetwork.h"
 #include "tubex_Exception.h"
 
@@ -23,36 +22,82 @@ namespace tubex
 
     double ContractorNetwork::contract(bool verbose)
     {
-      clock_t t_start = clock();
+      Deadline unbounded;
+      return contract(unbounded, verbose).duration;
+    }
 
+    ContractionResult ContractorNetwork::contract_during(double dt, bool verbose)
+    {
+      Deadline deadline(dt);
+      return contract(deadline, verbose);
+    }
+
+    ContractionResult ContractorNetwork::contract(Deadline& deadline, bool verbose)
+    {
       if(verbose)
       {
         cout << "Contractor network has " << m_map_ctc.size()
              << " contractors and " << m_map_domains.size() << " domains" << endl;
         cout << "Computing, " << nb_ctc_in_stack() << " contractors currently in stack";
-        if(!std::isinf(m_contraction_duration_max))
-          cout << " during " << m_contraction_duration_max << "s";
+        if(!std::isinf(deadline.remaining_time()))
+          cout << " during " << deadline.remaining_time() << "s";
         cout << endl;
       }
 
-      while(!m_deque.empty()
-        && (double)(clock() - t_start)/CLOCKS_PER_SEC < m_contraction_duration_max)
+      while(!m_deque.empty() && !deadline.expired())
       {
         Contractor *ctc = m_deque.front();
         m_deque.pop_front();
 
-        ctc->contract();
-        ctc->set_active(false);
 
-        for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
+        if(m_trail.is_recording()) // slices record themselves
+          for(auto& ctc_dom : ctc->domains())
+          {
+            if(ctc_dom->type() == Domain::Type::T_INTERVAL)
+              m_trail.record(&ctc_dom->interval());
+
+            else if(ctc_dom->type() == Domain::Type::T_INTERVAL_VECTOR)
+              for(int i = 0 ; i < ctc_dom->interval_vector().size() ; i++)
+                m_trail.record(&ctc_dom->interval_vector()[i]);
+          }
+
+        // Long dynamical contractions may yield between slices. The contraction
+        // may then not have been achieved: the contractor will be called again first
+        const bool interrupted = !ctc->contract(&deadline);
+
+        ctc->set_active(interrupted);
+        if(!interrupted) // the changes have been taken into account
+          ctc->set_changed_tdomain(Interval::EMPTY_SET);
+
+        if(m_frozen) // contiguous traversal of the compact graph
         {
-          // If the domain has "changed" after the contraction
-          trigger_ctc_related_to_dom(ctc_dom, ctc);
+          const int k = ctc->m_graph_index;
+          for(int j = m_graph.ctc_start[k] ; j < m_graph.ctc_start[k+1] ; j++)
+            trigger_ctc_related_to_dom(m_graph.v_doms[m_graph.ctc_adj[j]], ctc);
         }
+
+        else
+          for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
+          {
+            // If the domain has "changed" after the contraction
+            trigger_ctc_related_to_dom(ctc_dom, ctc);
+          }
+
+        if(interrupted)
+          m_deque.push_front(ctc);
       }
 
+      ContractionResult result;
+      result.completed = m_deque.empty();
+      result.nb_ctc_in_stack = nb_ctc_in_stack();
+      result.duration = deadline.elapsed_time();
+
       if(verbose)
-        cout << "  Constraint propagation time: " << (double)(clock() - t_start)/CLOCKS_PER_SEC << "s" << endl;
+      {
+        cout << "  Constraint propagation time: " << result.duration << "s" << endl;
+        if(!result.completed)
+          cout << "  Interrupted, " << result.nb_ctc_in_stack << " contractors remaining in stack" << endl;
+      }
 
       // Emptiness test
       // todo: test only contracted domains?
@@ -64,16 +109,7 @@ namespace tubex
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
-    }
-
-    double ContractorNetwork::contract_during(double dt, bool verbose)
-    {
-      double prev_dt = m_contraction_duration_max;
-      m_contraction_duration_max = dt;
-      double contraction_time = contract(verbose);
-      m_contraction_duration_max = prev_dt;
-      return contraction_time;
+      return result;
     }
 
     void ContractorNetwork::set_fixedpoint_ratio(float r)
@@ -86,9 +122,13 @@ namespace tubex
     {
       m_deque.clear();
 
+      for(const auto& dom : m_map_domains) // fixed point detection from the current values
+        dom.second->set_volume(dom.second->compute_volume());
+
       for(const auto& ctc : m_map_ctc)
       {
         ctc.second->set_active(true);
+        ctc.second->set_changed_tdomain(Interval::ALL_REALS); // domains may have been updated anywhere
         add_ctc_to_queue(ctc.second, m_deque);
       }
     }
@@ -98,6 +138,48 @@ namespace tubex
       return m_deque.size();
     }
 
+    // Checkpoints
+
+    int ContractorNetwork::save_state()
+    {
+      m_v_saved_deques.push_back(m_deque);
+      return m_trail.push_level();
+    }
+
+    void ContractorNetwork::restore_state()
+    {
+      if(m_v_saved_deques.empty())
+        throw Exception(__func__, "no saved state to be restored");
+
+      m_trail.restore_level(); // values and volumes of the domains
+
+      for(auto& ctc : m_deque)
+        ctc->set_active(false);
+
+      m_deque.swap(m_v_saved_deques.back());
+      m_v_saved_deques.pop_back();
+
+      for(auto& ctc : m_deque)
+      {
+        ctc->set_active(true);
+        ctc->set_changed_tdomain(Interval::ALL_REALS); // restored values are not reported
+      }
+    }
+
+    void ContractorNetwork::discard_state()
+    {
+      if(m_v_saved_deques.empty())
+        throw Exception(__func__, "no saved state to be discarded");
+
+      m_trail.pop_level();
+      m_v_saved_deques.pop_back();
+    }
+
+    int ContractorNetwork::nb_saved_states() const
+    {
+      return m_v_saved_deques.size();
+    }
+
   // Protected methods
 
     void ContractorNetwork::add_ctc_to_queue(Contractor *ac, deque<Contractor*>& ctc_deque)
@@ -114,26 +196,83 @@ namespace tubex
     void ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
     {
       double current_volume = dom->compute_volume(); // new volume after contraction
+      bool contracted = current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio;
+
+      // Temporal window of the changes, for sparse propagations on tubes
+      Interval changed_tdomain = changed_tdomain_of(dom);
+      if(changed_tdomain.is_empty() && current_volume != dom->get_saved_volume())
+        changed_tdomain = Interval::ALL_REALS; // changes not reported by the slices
 
-      if(current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio)
+      // We activate each contractor related to these domains, according to graph orientation
+
+      // Local deque, for specific order related to this domain
+      deque<Contractor*> ctc_deque;
+
+      auto trigger = [&](Contractor *ctc_of_dom)
       {
-        // We activate each contractor related to these domains, according to graph orientation
+        if(ctc_of_dom == ctc_to_avoid)
+          return;
 
-        // Local deque, for specific order related to this domain
-        deque<Contractor*> ctc_deque;
+        if(ctc_of_dom->type() == Contractor::Type::T_TUBEX)
+        {
+          if(!changed_tdomain.intersects(ctc_of_dom->dependency_tdomain()))
+            return; // the contractor is not concerned by these changes
 
-        for(auto& ctc_of_dom : dom->contractors()) 
-          if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active())
-          {
-            ctc_of_dom->set_active(true);
-            add_ctc_to_queue(ctc_of_dom, ctc_deque);
-          }
+          // Changes are accumulated until the next contraction, even if not triggered now
+          ctc_of_dom->set_changed_tdomain(ctc_of_dom->changed_tdomain() | changed_tdomain);
+        }
+
+        if(contracted && !ctc_of_dom->is_active())
+        {
+          ctc_of_dom->set_active(true);
+          add_ctc_to_queue(ctc_of_dom, ctc_deque);
+        }
+      };
+
+      if(m_frozen)
+      {
+        const int k = dom->m_graph_index;
+        for(int j = m_graph.dom_start[k] ; j < m_graph.dom_start[k+1] ; j++)
+          trigger(m_graph.v_ctc[m_graph.dom_adj[j]]);
+      }
+
+      else
+        for(auto& ctc_of_dom : dom->contractors())
+          trigger(ctc_of_dom);
+
+      // Merging this local deque in the CN one
+      for(auto& c : ctc_deque)
+        m_deque.push_front(c);
+
+      if(dom->type() == Domain::Type::T_TUBE)
+        dom->m_changed_tdomain = Interval::EMPTY_SET; // changes now transmitted
+
+      if(current_volume != dom->get_saved_volume())
+      {
+        m_trail.record(dom); // the volume is part of the saved states
+        dom->set_volume(current_volume); // updating old volume
+      }
+    }
+
+    Interval ContractorNetwork::changed_tdomain_of(Domain *dom)
+    {
+      switch(dom->type())
+      {
+        case Domain::Type::T_TUBE:
+          return dom->m_changed_tdomain;
+
+        case Domain::Type::T_TUBE_VECTOR:
+        {
+          // Union of the windows of the components, not reset here:
+          // they will be transmitted when the components are triggered
+          Interval changed_tdomain = Interval::EMPTY_SET;
+          for(const auto& dom_i : dom->m_v_components)
+            changed_tdomain |= dom_i->m_changed_tdomain;
+          return changed_tdomain;
+        }
 
-        // Merging this local deque in the CN one
-        for(auto& c : ctc_deque)
-          m_deque.push_front(c);
+        default:
+          return Interval::ALL_REALS; // other domains are not temporal
       }
-      
-      dom->set_volume(current_volume); // updating old volume
     }
 }
\ No newline at end of file
@@ -18,7 +18,7 @@ using namespace ibex;
 
 namespace tubex
 {
-  int Domain::dom_counter = 0;
+  atomic<int> Domain::dom_counter(0);
 
   Domain::Domain()
     : m_type(Type::T_INTERVAL), m_memory_type(MemoryRef::M_DOUBLE)
@@ -29,8 +29,7 @@ namespace tubex
   Domain::Domain(Type type, MemoryRef memory_type)
     : m_type(type), m_memory_type(memory_type)
   {
-    dom_counter++;
-    m_dom_id = dom_counter;
+    m_dom_id = ++dom_counter;
 
     switch(m_type)
     {
@@ -219,6 +218,7 @@ namespace tubex
   {
     m_volume = ad.m_volume;
     m_v_ctc = ad.m_v_ctc;
+    m_v_components = ad.m_v_components;
     m_name = ad.m_name;
     m_dom_id = ad.m_dom_id;
 
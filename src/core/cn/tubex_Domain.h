@@ -12,6 +12,7 @@
 #ifndef __TUBEX_DOMAIN_H__
 #define __TUBEX_DOMAIN_H__
 
+#include <atomic>
 #include <functional>
 #include "ibex_Interval.h"
 #include "ibex_IntervalVector.h"
@@ -157,11 +158,14 @@ namespace tubex
 
       std::vector<Contractor*> m_v_ctc;
       double m_volume = 0.;
+      ibex::Interval m_changed_tdomain = ibex::Interval::EMPTY_SET; //!< window of the slices changed since the last trigger (tubes only)
+      int m_graph_index = -1; //!< index of the domain in the compact graph of a frozen network
+      std::vector<Domain*> m_v_components; //!< domains of the components, registered in the network (tube vectors only)
 
       std::string m_name;
       int m_dom_id;
 
-      static int dom_counter;
+      static std::atomic<int> dom_counter;
 
       friend class ContractorNetwork; // todo: remove this
       friend class DomainHashcode;
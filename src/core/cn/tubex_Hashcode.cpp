@@ -67,6 +67,49 @@ namespace tubex
     }
   }
 
+  ContractorHashcode::ContractorHashcode(const ContractorHashcode& x)
+    : m_n(x.m_n), m_ptr(new std::uintptr_t[x.m_n])
+  {
+    copy(x.m_ptr, x.m_ptr + m_n, m_ptr);
+  }
+
+  ContractorHashcode::ContractorHashcode(ContractorHashcode&& x)
+    : m_n(x.m_n), m_ptr(x.m_ptr)
+  {
+    x.m_n = 0;
+    x.m_ptr = NULL;
+  }
+
+  ContractorHashcode::~ContractorHashcode()
+  {
+    delete[] m_ptr;
+  }
+
+  ContractorHashcode& ContractorHashcode::operator=(const ContractorHashcode& x)
+  {
+    if(this != &x)
+    {
+      delete[] m_ptr;
+      m_n = x.m_n;
+      m_ptr = new std::uintptr_t[m_n];
+      copy(x.m_ptr, x.m_ptr + m_n, m_ptr);
+    }
+
+    return *this;
+  }
+
+  ContractorHashcode& ContractorHashcode::operator=(ContractorHashcode&& x)
+  {
+    if(this != &x)
+    {
+      delete[] m_ptr;
+      m_n = x.m_n; m_ptr = x.m_ptr;
+      x.m_n = 0; x.m_ptr = NULL;
+    }
+
+    return *this;
+  }
+
   bool ContractorHashcode::operator<(const ContractorHashcode& a) const
   {
     for(size_t i = 0 ; i < min(m_n, a.m_n) ; i++)
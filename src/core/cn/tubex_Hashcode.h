@@ -26,6 +26,11 @@ namespace tubex
     public:
 
       ContractorHashcode(const Contractor& ctc);
+      ContractorHashcode(const ContractorHashcode& x);
+      ContractorHashcode(ContractorHashcode&& x);
+      ~ContractorHashcode();
+      ContractorHashcode& operator=(const ContractorHashcode& x);
+      ContractorHashcode& operator=(ContractorHashcode&& x);
       bool operator<(const ContractorHashcode& a) const;
 
     protected:
@@ -0,0 +1,211 @@
+/** 
+ *  Trail class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include "tubex_Trail.h"
+#include "tubex_Slice.h"
+#include "tubex_Domain.h"
+#include "tubex_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Public methods
+
+    // Definition
+
+    Trail::Trail()
+    {
+
+    }
+
+    Trail::~Trail()
+    {
+      for(auto& s : m_attached_slices)
+      {
+        s->m_trail = NULL;
+        s->m_changed_tdomain = NULL;
+      }
+    }
+
+    int Trail::nb_levels() const
+    {
+      return m_v_levels.size();
+    }
+
+    int Trail::size() const
+    {
+      return m_v_entries.size();
+    }
+
+    bool Trail::is_recording() const
+    {
+      return !m_v_levels.empty();
+    }
+
+    // Checkpoints
+
+    int Trail::push_level()
+    {
+      m_v_levels.push_back(m_v_entries.size());
+      return m_v_levels.size();
+    }
+
+    void Trail::restore_level()
+    {
+      assert(is_recording() && "no level to be restored");
+
+      size_t level = m_v_levels.back();
+      m_v_levels.pop_back();
+
+      // Reverse order: the oldest value of an item is the last one written
+      while(m_v_entries.size() > level)
+      {
+        const Entry& e = m_v_entries.back();
+
+        if(e.s != NULL)
+        {
+          if(!m_detached_slices.empty() && m_detached_slices.count(e.s))
+          {
+            m_v_entries.pop_back(); // slice released (and possibly destroyed) since this record
+            continue;
+          }
+
+          // Values are set without calling the setters, that would record them again
+          e.s->m_codomain = e.codomain;
+          *e.s->m_input_gate = e.input_gate;
+          *e.s->m_output_gate = e.output_gate;
+
+          if(e.s->m_synthesis_reference != NULL)
+          {
+            e.s->m_synthesis_reference->request_values_update();
+            e.s->m_synthesis_reference->request_integrals_update();
+          }
+        }
+
+        else if(e.i != NULL)
+          *e.i = e.codomain;
+
+        else
+          e.dom->set_volume(e.volume);
+
+        m_v_entries.pop_back();
+      }
+
+      if(m_v_entries.empty())
+        m_detached_slices.clear();
+    }
+
+    void Trail::pop_level()
+    {
+      assert(is_recording() && "no level to be closed");
+      m_v_levels.pop_back();
+
+      if(m_v_levels.empty()) // nothing will ever be restored
+      {
+        m_v_entries.clear();
+        m_detached_slices.clear();
+      }
+    }
+
+    void Trail::clear()
+    {
+      m_v_levels.clear();
+      m_v_entries.clear();
+      m_detached_slices.clear();
+    }
+
+    // Recording
+
+    void Trail::attach(Slice& s)
+    {
+      if(s.m_trail == this)
+        return;
+
+      if(s.m_trail != NULL) // a slice records its values into one single trail
+        throw Exception(__func__, "slice already involved in another contractor network");
+
+      if(!m_detached_slices.empty() && m_detached_slices.erase(&s))
+      {
+        // New slice at the address of a released one: the remaining
+        // entries of the released slice are removed (rare case)
+        size_t j = 0, k = 0;
+        for(size_t i = 0 ; i < m_v_entries.size() ; i++)
+        {
+          while(k < m_v_levels.size() && m_v_levels[k] == i)
+            m_v_levels[k++] = j;
+
+          if(m_v_entries[i].s != &s)
+            m_v_entries[j++] = m_v_entries[i];
+        }
+
+        while(k < m_v_levels.size())
+          m_v_levels[k++] = j;
+        m_v_entries.resize(j);
+      }
+
+      s.m_trail = this;
+      m_attached_slices.insert(&s);
+    }
+
+    void Trail::detach(Slice& s)
+    {
+      if(s.m_trail != this)
+        return;
+
+      s.m_trail = NULL;
+      s.m_changed_tdomain = NULL;
+      m_attached_slices.erase(&s);
+
+      // Entries related to this slice are not searched now:
+      // they will be ignored when restoring the values
+      if(!m_v_entries.empty())
+        m_detached_slices.insert(&s);
+    }
+
+    void Trail::record(Slice *s)
+    {
+      assert(s != NULL);
+      if(!is_recording())
+        return;
+
+      Entry e;
+      e.s = s; e.i = NULL; e.dom = NULL;
+      e.codomain = s->m_codomain;
+      e.input_gate = *s->m_input_gate;
+      e.output_gate = *s->m_output_gate;
+      m_v_entries.push_back(e);
+    }
+
+    void Trail::record(Interval *i)
+    {
+      assert(i != NULL);
+      if(!is_recording())
+        return;
+
+      Entry e;
+      e.s = NULL; e.i = i; e.dom = NULL;
+      e.codomain = *i;
+      m_v_entries.push_back(e);
+    }
+
+    void Trail::record(Domain *dom)
+    {
+      assert(dom != NULL);
+      if(!is_recording())
+        return;
+
+      Entry e;
+      e.s = NULL; e.i = NULL; e.dom = dom;
+      e.volume = dom->get_saved_volume();
+      m_v_entries.push_back(e);
+    }
+}
@@ -0,0 +1,175 @@
+/** 
+ *  \file
+ *  Trail class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_TRAIL_H__
+#define __TUBEX_TRAIL_H__
+
+#include <vector>
+#include <unordered_set>
+#include "ibex_Interval.h"
+
+namespace tubex
+{
+  class Slice;
+  class Domain;
+
+  /**
+   * \class Trail
+   * \brief Undo log of the values modified since some checkpoints (levels).
+   *
+   * Previous values are recorded just before each change, only when at least
+   * one level is open. Rolling back to a level is then proportional to the number
+   * of changes made since this checkpoint, and not to the size of the data.
+   *
+   * Slices attached to the trail record themselves from their setters.
+   * Intervals and volumes of domains have to be recorded explicitly.
+   *
+   * The trail also keeps track of the slices linked to its network: they are
+   * released when the trail is destroyed, and a destroyed slice releases itself.
+   */
+  class Trail
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates an empty trail, without any level
+       */
+      Trail();
+
+      /**
+       * \brief Trail destructor, releasing the attached slices
+       */
+      ~Trail();
+
+      /**
+       * \brief Returns the number of open levels (checkpoints)
+       *
+       * \return the depth of the trail
+       */
+      int nb_levels() const;
+
+      /**
+       * \brief Returns the number of recorded changes, for all levels
+       *
+       * \return the number of entries
+       */
+      int size() const;
+
+      /**
+       * \brief Returns `true` if changes are currently recorded,
+       *        that is if at least one level is open
+       *
+       * \return recording test
+       */
+      bool is_recording() const;
+
+      /// @}
+      /// \name Checkpoints
+      /// @{
+
+      /**
+       * \brief Opens a new level: next changes will be undone by restore_level()
+       *
+       * \return the depth of the trail, including this new level
+       */
+      int push_level();
+
+      /**
+       * \brief Restores the values recorded since the last open level,
+       *        in reverse order, and closes this level
+       */
+      void restore_level();
+
+      /**
+       * \brief Closes the last level without restoring the values: the changes
+       *        are merged into the previous level, if any
+       */
+      void pop_level();
+
+      /**
+       * \brief Closes all levels and forgets the recorded values
+       */
+      void clear();
+
+      /// @}
+      /// \name Recording
+      /// @{
+
+      /**
+       * \brief Links a slice to this trail: its setters will record the previous values
+       *
+       * \note A slice can be linked to one single trail (that is, one contractor network)
+       *       at a time. An exception is thrown if the slice is already linked to another one.
+       *
+       * \param s the Slice object to be followed
+       */
+      void attach(Slice& s);
+
+      /**
+       * \brief Removes the links between a slice and this trail (and its network), if any
+       *
+       * \note Values recorded for this slice are forgotten. This is done in constant time:
+       *       the related entries are ignored when the levels are restored.
+       *
+       * \param s the Slice object to be released
+       */
+      void detach(Slice& s);
+
+      /**
+       * \brief Records the current envelope and gates of a slice, before a change
+       *
+       * \param s pointer to the Slice object about to be modified
+       */
+      void record(Slice *s);
+
+      /**
+       * \brief Records the current value of an interval, before a change
+       *
+       * \param i pointer to the Interval object about to be modified
+       */
+      void record(ibex::Interval *i);
+
+      /**
+       * \brief Records the current saved volume of a domain, before a change
+       *
+       * \param dom pointer to the Domain object about to be updated
+       */
+      void record(Domain *dom);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \struct Entry
+       * \brief Previous value of one modified item (only one pointer is set)
+       */
+      struct Entry
+      {
+        Slice *s; //!< modified slice, or `NULL`
+        ibex::Interval *i; //!< modified interval, or `NULL`
+        Domain *dom; //!< domain whose volume has been updated, or `NULL`
+        ibex::Interval codomain; //!< previous envelope of the slice, or previous value of the interval
+        ibex::Interval input_gate, output_gate; //!< previous gates of the slice
+        double volume; //!< previous volume of the domain
+      };
+
+      std::vector<Entry> m_v_entries; //!< recorded values, in chronological order
+      std::vector<std::size_t> m_v_levels; //!< positions of the checkpoints in m_v_entries
+      std::unordered_set<Slice*> m_attached_slices; //!< slices linked to this trail
+      std::unordered_set<Slice*> m_detached_slices; //!< released slices that may still have entries
+  };
+}
+
+#endif
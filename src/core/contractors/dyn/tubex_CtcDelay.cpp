@@ -10,6 +10,7 @@
 
 #include "tubex_CtcDelay.h"
 #include "tubex_Domain.h"
+#include "tubex_TubeTreeSynthesis.h"
 #include "tubex_DomainsTypeException.h"
 
 using namespace std;
@@ -56,22 +57,144 @@ namespace tubex
     Interval intv_t = x.tdomain() + a;
     if(!intv_t.intersects(y.tdomain())) return;
 
+    // Thin delay on aligned slicings: evaluations reduce to an index shift
+    if(a.is_degenerated() && contract_shifted_slices(a, x, y))
+      return;
+
+    // Otherwise, evaluations and inversions are computed in logarithmic time with
+    // synthesis trees: the ones of the tubes if enabled, or local ones built for
+    // this contraction (the settings of the tubes are not modified)
+    TubeTreeSynthesis *x_tree = x.synthesis_enabled() ? NULL : local_synthesis_tree(x);
+    TubeTreeSynthesis *y_tree = (&y == &x) ? x_tree : y.synthesis_enabled() ? NULL : local_synthesis_tree(y);
+
+    contract_slices(a, x, y, x_tree, y_tree);
+
+    if(y_tree != x_tree) delete y_tree;
+    delete x_tree;
+  }
+
+  void CtcDelay::contract(Interval& a, TubeVector& x, TubeVector& y)
+  {
+    assert(x.size() == y.size());
+
+    if(a.is_empty() || x.is_empty() || y.is_empty()){
+        a.set_empty();
+        x.set_empty();
+        y.set_empty();
+        return;
+    }
+
+    for(int i = 0 ; i < x.size() ; i++)
+      contract(a, x[i], y[i]);
+
+    if(a.is_empty() || x.is_empty() || y.is_empty()){
+        a.set_empty();
+        x.set_empty();
+        y.set_empty();
+    }
+  }
+
+  bool CtcDelay::contract_shifted_slices(Interval& a, Tube& x, Tube& y)
+  {
+    assert(a.is_degenerated());
+
+    // First slices related by the delay
+
+      Slice *s_x0 = x.slice(std::max(x.tdomain().lb(), std::min(x.tdomain().ub(), y.tdomain().lb() - a.lb())));
+      if(s_x0->tdomain().lb() + a.lb() < y.tdomain().lb())
+        s_x0 = s_x0->next_slice();
+
+      if(s_x0 == NULL || !y.tdomain().contains(s_x0->tdomain().lb() + a.lb()))
+        return false;
+
+      Slice *s_y0 = y.slice(s_x0->tdomain().lb() + a.lb());
+
+    // The slicings must match exactly over the common tdomain
+
+      Slice *s_x = s_x0, *s_y = s_y0;
+      for( ; s_x != NULL && s_y != NULL ; s_x = s_x->next_slice(), s_y = s_y->next_slice())
+        if(s_x->tdomain() + a != s_y->tdomain())
+          return false;
+
+    // Slice to slice contractions
+
+      for(s_x = s_x0, s_y = s_y0 ; s_x != NULL && s_y != NULL && !deadline_expired() ; // the CN may interrupt the contraction
+          s_x = s_x->next_slice(), s_y = s_y->next_slice())
+      {
+        // Only slices related to the changes since the last call are processed
+        if(!s_x->tdomain().intersects(changed_tdomain()) && !s_y->tdomain().intersects(changed_tdomain()))
+          continue;
+
+        const Interval envelope = s_x->codomain() & s_y->codomain();
+        const Interval input_gate = s_x->input_gate() & s_y->input_gate();
+        const Interval output_gate = s_x->output_gate() & s_y->output_gate();
+
+        if(envelope.is_empty() || input_gate.is_empty() || output_gate.is_empty()){
+            a.set_empty();
+            x.set_empty();
+            y.set_empty();
+            return true;
+        }
+
+        for(Slice *s : { s_x, s_y })
+        {
+          s->set_envelope(envelope);
+          s->set_input_gate(input_gate);
+          s->set_output_gate(output_gate);
+        }
+      }
+
+    return true;
+  }
+
+  TubeTreeSynthesis* CtcDelay::local_synthesis_tree(const Tube& x)
+  {
+    vector<const Slice*> v_slices;
+    v_slices.reserve(x.nb_slices());
+    for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
+      v_slices.push_back(s);
+
+    return new TubeTreeSynthesis(&x, 0, v_slices.size() - 1, v_slices);
+  }
+
+  void CtcDelay::contract_slices(Interval& a, Tube& x, Tube& y, TubeTreeSynthesis *x_tree, TubeTreeSynthesis *y_tree)
+  {
+    // Evaluations and inversions with the local trees, if any
+    auto eval = [](const Tube& z, TubeTreeSynthesis *z_tree, const Interval& t) -> Interval
+    {
+      if(z_tree == NULL || t.is_empty() || t.is_degenerated())
+        return z(t);
+      return (*z_tree)(t);
+    };
+
+    auto invert = [](const Tube& z, TubeTreeSynthesis *z_tree, const Interval& z_values, const Interval& t) -> Interval
+    {
+      return z_tree == NULL ? z.invert(z_values, t) : z_tree->invert(z_values, t);
+    };
+
     // iterate over the first tube x
     Slice *s_x = x.first_slice();
-    while(s_x != NULL)
+    while(s_x != NULL && !deadline_expired()) // the CN may interrupt the contraction
     {
       const Interval t_x = s_x->tdomain();
       Interval intv_t = t_x + a;
 
+      // Only slices related to the changes since the last call are processed
+      if(!t_x.intersects(changed_tdomain()) && !intv_t.intersects(changed_tdomain()))
+      {
+        s_x = s_x->next_slice();
+        continue;
+      }
+
       if(intv_t.is_subset(y.tdomain())){
-          const Interval s_y = y(intv_t);
+          const Interval s_y = eval(y, y_tree, intv_t);
           // if the evaluation of the tube y, which we would invert inside [intv_t],
           // is already completely inside the codomain of s_x, no contraction for [a] can
           // be achieved and we can avoid the inversion to save computation time
           if(s_y.is_interior_subset(s_x->codomain())){
               s_x->set_envelope(s_x->codomain() & s_y);
           } else {
-              const Interval t_y = y.invert(s_x->codomain(),intv_t);
+              const Interval t_y = invert(y, y_tree, s_x->codomain(), intv_t);
               a &= t_y - t_x;
 
               if(a.is_empty()){
@@ -80,17 +203,17 @@ namespace tubex
                   return;
               }
               intv_t = t_x + a;
-              s_x->set_envelope(s_x->codomain() & y(intv_t));
+              s_x->set_envelope(s_x->codomain() & eval(y, y_tree, intv_t));
           }
       }
 
       intv_t = t_x.lb() + a;
       if(intv_t.is_subset(y.tdomain()))
-          s_x->set_input_gate(s_x->input_gate() & y(intv_t));
+          s_x->set_input_gate(s_x->input_gate() & eval(y, y_tree, intv_t));
 
       intv_t = t_x.ub() + a;
       if(intv_t.is_subset(y.tdomain()))
-          s_x->set_output_gate(s_x->output_gate() & y(intv_t));
+          s_x->set_output_gate(s_x->output_gate() & eval(y, y_tree, intv_t));
 
       if(s_x->is_empty()){
           a.set_empty();
@@ -104,20 +227,27 @@ namespace tubex
 
     // iterate over the second tube y
     Slice *s_y = y.first_slice();
-    while(s_y != NULL)
+    while(s_y != NULL && !deadline_expired()) // the CN may interrupt the contraction
     {
       const Interval t_y = s_y->tdomain();
       Interval intv_t = t_y - a;
 
+      // Only slices related to the changes since the last call are processed
+      if(!t_y.intersects(changed_tdomain()) && !intv_t.intersects(changed_tdomain()))
+      {
+        s_y = s_y->next_slice();
+        continue;
+      }
+
       if(intv_t.is_subset(x.tdomain())){
-          const Interval s_x = x(intv_t);
+          const Interval s_x = eval(x, x_tree, intv_t);
           // if the evaluation of the tube x, which we would invert inside [intv_t],
           // is already completely inside the codomain of s_y, no contraction for [a] can
           // be achieved and we can avoid the inversion to save computation time
           if(s_x.is_interior_subset(s_y->codomain())){
               s_y->set_envelope(s_y->codomain() & s_x);
           } else {
-              const Interval t_x = x.invert(s_y->codomain(),intv_t);
+              const Interval t_x = invert(x, x_tree, s_y->codomain(), intv_t);
               a &= t_y - t_x;
 
               if(a.is_empty()){
@@ -126,17 +256,17 @@ namespace tubex
                   return;
               }
               intv_t = t_y - a;
-              s_y->set_envelope(s_y->codomain() & x(intv_t));
+              s_y->set_envelope(s_y->codomain() & eval(x, x_tree, intv_t));
           }
       }
 
       intv_t = t_y.lb() - a;
       if(intv_t.is_subset(x.tdomain()))
-          s_y->set_input_gate(s_y->input_gate() & x(intv_t));
+          s_y->set_input_gate(s_y->input_gate() & eval(x, x_tree, intv_t));
 
       intv_t = t_y.ub() - a;
       if(intv_t.is_subset(x.tdomain()))
-          s_y->set_output_gate(s_y->output_gate() & x(intv_t));
+          s_y->set_output_gate(s_y->output_gate() & eval(x, x_tree, intv_t));
 
       if(s_y->is_empty()){
           a.set_empty();
@@ -154,25 +284,4 @@ namespace tubex
         y.set_empty();
     }
   }
-
-  void CtcDelay::contract(Interval& a, TubeVector& x, TubeVector& y)
-  {
-    assert(x.size() == y.size());
-
-    if(a.is_empty() || x.is_empty() || y.is_empty()){
-        a.set_empty();
-        x.set_empty();
-        y.set_empty();
-        return;
-    }
-
-    for(int i = 0 ; i < x.size() ; i++)
-      contract(a, x[i], y[i]);
-
-    if(a.is_empty() || x.is_empty() || y.is_empty()){
-        a.set_empty();
-        x.set_empty();
-        y.set_empty();
-    }
-  }
 }
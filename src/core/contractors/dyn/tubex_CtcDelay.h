@@ -16,6 +16,8 @@
 
 namespace tubex
 {
+  class TubeTreeSynthesis;
+
   /**
    * \class CtcDelay
    * \brief \f$\mathcal{C}_{delay}\f$ that contracts the tubes \f$[x](\cdot)\f$ and \f$[y](\cdot)\f$
@@ -64,6 +66,39 @@ namespace tubex
 
     protected:
 
+      /**
+       * \brief Fast contraction for a thin delay on aligned slicings: each slice of
+       *        \f$[x](\cdot)\f$ is exactly shifted onto a slice of \f$[y](\cdot)\f$
+       *
+       * \param a the thin delay value \f$\tau\f$
+       * \param x the scalar tube \f$[x](\cdot)\f$ to be contracted
+       * \param y the scalar tube \f$[y](\cdot)\f$ to be contracted
+       * \return `false` if the slicings do not match (nothing has been done)
+       */
+      bool contract_shifted_slices(ibex::Interval& a, Tube& x, Tube& y);
+
+      /**
+       * \brief General contraction, slice by slice, based on evaluations and inversions
+       *        of the tubes
+       *
+       * \param a the delay value \f$\tau\f$ to be contracted
+       * \param x the scalar tube \f$[x](\cdot)\f$ to be contracted
+       * \param y the scalar tube \f$[y](\cdot)\f$ to be contracted
+       * \param x_tree local synthesis tree of \f$[x](\cdot)\f$, or `NULL` to evaluate the tube itself
+       * \param y_tree local synthesis tree of \f$[y](\cdot)\f$, or `NULL` to evaluate the tube itself
+       */
+      void contract_slices(ibex::Interval& a, Tube& x, Tube& y, TubeTreeSynthesis *x_tree, TubeTreeSynthesis *y_tree);
+
+      /**
+       * \brief Builds a synthesis tree on the slices of a tube, without attaching it to the tube
+       *
+       * \note The tube must not have its own synthesis tree.
+       *
+       * \param x the scalar tube
+       * \return a pointer to the new tree, to be deleted by the caller
+       */
+      static TubeTreeSynthesis* local_synthesis_tree(const Tube& x);
+
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
       friend class ContractorNetwork;
@@ -77,16 +77,34 @@ namespace tubex
   {
     assert(x.tdomain() == v.tdomain());
     assert(Tube::same_slicing(x, v));
+
+    // Sparse propagation: slices before (resp. after) the changes are not impacted
+    // by a forward (resp. backward) propagation, and the propagation stops as soon as
+    // a gate outside the changes remains the same
+    const Interval& changed = changed_tdomain();
+    if(changed.is_empty())
+      return;
     
     if(t_propa & TimePropag::FORWARD)
     {
       Slice *s_x = x.first_slice();
       const Slice *s_v = v.first_slice();
 
-      while(s_x != NULL)
+      if(changed.lb() > x.tdomain().lb())
+      {
+        s_x = x.slice(std::min(changed.lb(), x.tdomain().ub()));
+        s_v = v.slice(std::min(changed.lb(), v.tdomain().ub()));
+      }
+
+      while(s_x != NULL && !deadline_expired()) // the CN may interrupt the contraction
       {
         assert(s_v != NULL);
+        const Interval outgate = s_x->output_gate();
         contract(*s_x, *s_v, t_propa);
+
+        if(s_x->tdomain().lb() > changed.ub() && s_x->output_gate() == outgate)
+          break; // next slices will not be impacted
+
         s_x = s_x->next_slice();
         s_v = s_v->next_slice();
       }
@@ -97,10 +115,21 @@ namespace tubex
       Slice *s_x = x.last_slice();
       const Slice *s_v = v.last_slice();
 
-      while(s_x != NULL)
+      if(changed.ub() < x.tdomain().ub())
+      {
+        s_x = x.slice(std::max(changed.ub(), x.tdomain().lb()));
+        s_v = v.slice(std::max(changed.ub(), v.tdomain().lb()));
+      }
+
+      while(s_x != NULL && !deadline_expired()) // the CN may interrupt the contraction
       {
         assert(s_v != NULL);
+        const Interval ingate = s_x->input_gate();
         contract(*s_x, *s_v, t_propa);
+
+        if(s_x->tdomain().ub() < changed.lb() && s_x->input_gate() == ingate)
+          break; // previous slices will not be impacted
+
         s_x = s_x->prev_slice();
         s_v = s_v->prev_slice();
       }
@@ -76,6 +76,20 @@ namespace tubex
     m_propagation_enabled = enable_propagation;
   }
 
+  bool CtcEval::time_propag_enabled() const
+  {
+    return m_propagation_enabled && (context() == NULL || context()->time_propag);
+  }
+
+  const Interval CtcEval::dependency_tdomain(const vector<Domain*>& v_domains) const
+  {
+    // Without temporal propagation, only the slices around [t] are involved
+    if(time_propag_enabled() || v_domains.empty() || v_domains[0]->type() != Domain::Type::T_INTERVAL)
+      return Interval::ALL_REALS;
+
+    return v_domains[0]->interval();
+  }
+
   void CtcEval::contract(double t, Interval& z, Tube& y, Tube& w)
   {
     assert(!std::isnan(t));
@@ -91,19 +105,22 @@ namespace tubex
       return;
     }
 
-    bool merge_after_ctc = m_preserve_slicing && !y.gate_exists(t);
+    bool merge_after_ctc = slicing_preserved() && !y.gate_exists(t);
 
     z &= y.interpol(t, w);
     y.set(z, t);
     w.sample(t); // w is also sampled to stay compliant with y
     assert(Tube::same_slicing(y, w));
 
-    if(m_propagation_enabled)
+    if(time_propag_enabled())
     {
       CtcDeriv ctc_deriv;
       ctc_deriv.restrict_tdomain(m_restricted_tdomain);
       ctc_deriv.set_fast_mode(m_fast_mode);
+      ctc_deriv.set_changed_tdomain(changed_tdomain() | Interval(t)); // previous changes and evaluation
+      ctc_deriv.set_deadline(deadline()); // the CN may interrupt the propagation
       ctc_deriv.contract(y, w);
+      deadline_expired(); // reports the interruption to the CN, if any
     }
 
     else if(merge_after_ctc)
@@ -173,7 +190,7 @@ namespace tubex
       if(!z.is_empty())
       {
         vector<double> v_gates_to_remove;
-        if(m_preserve_slicing)
+        if(slicing_preserved())
         {
           if(!y.gate_exists(t.lb())) // will exist then
             v_gates_to_remove.push_back(t.lb());
@@ -189,6 +206,8 @@ namespace tubex
         CtcDeriv ctc_deriv;
         ctc_deriv.restrict_tdomain(m_restricted_tdomain);
         ctc_deriv.set_fast_mode(m_fast_mode);
+        ctc_deriv.set_changed_tdomain(changed_tdomain() | t); // previous changes and evaluation
+        ctc_deriv.set_deadline(deadline()); // the CN may interrupt the propagation
 
         Interval front_gate(y.size());
         list<Interval> l_gates;
@@ -244,7 +263,8 @@ namespace tubex
 
           s_y->set_output_gate(l_gates.front() | front_gate);
 
-          while(s_y != NULL && s_y->tdomain().lb() >= t.lb())
+          while(s_y != NULL && s_y->tdomain().lb() >= t.lb()
+                && !deadline_expired()) // the CN may interrupt the contraction
           {
             // Backward propagation of the evaluation
             front_gate -= s_y->tdomain().diam() * s_w->codomain(); // projection
@@ -263,8 +283,11 @@ namespace tubex
 
         // 3. Envelopes contraction
 
-          if(m_propagation_enabled)
+          if(time_propag_enabled())
+          {
             ctc_deriv.contract(y, w);
+            deadline_expired(); // reports the interruption to the CN, if any
+          }
 
         // 4. Evaluation contraction
 
@@ -45,11 +45,22 @@ namespace tubex
        * \brief Enables a forward/backward temporal propagation of the contraction
        *
        * \note If disabled, then the contraction will only affect the slices over \f$[t]\f$.
+       * \note In a ContractorNetwork, the propagation is also disabled for the evaluations
+       *       registered with the derivative tube (a CtcDeriv is then added by the network),
+       *       without modifying this object.
        *
        * \param enable_propagation if true, the contractions will be propagated as far as possible across \f$[t_0,t_f]\f$
        */
       void enable_time_propag(bool enable_propagation);
 
+      /**
+       * \brief Returns the temporal window on which the contractor depends
+       *
+       * \param v_domains vector of Domain pointers
+       * \return \f$[t]\f$ if the temporal propagation is disabled, the whole temporal domain otherwise
+       */
+      const ibex::Interval dependency_tdomain(const std::vector<Domain*>& v_domains) const;
+
       /**
        * \brief \f$\mathcal{C}_\textrm{eval}\big(t,[z],[y](\cdot),[w](\cdot)\big)\f$:
        *        contracts the tube \f$[y](\cdot)\f$ and the evaluation \f$[z]\f$.
@@ -124,6 +135,14 @@ namespace tubex
 
     protected:
 
+      /**
+       * \brief Tests if the current contraction has to be propagated in time,
+       *        according to this object and to the context of the call
+       *
+       * \return `true` if a complete temporal propagation will be performed
+       */
+      bool time_propag_enabled() const;
+
       bool m_propagation_enabled = true; //!< if `true`, a complete temporal propagation will be performed
 
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
@@ -8,9 +8,12 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cmath>
+#include <mutex>
 #include "tubex_CtcLinobs.h"
 #include "tubex_Domain.h"
 #include "tubex_polygon_arithmetic.h"
+#include "tubex_zonotope_arithmetic.h"
 #include "tubex_DomainsTypeException.h"
 
 using namespace std;
@@ -21,9 +24,8 @@ namespace tubex
   CtcLinobs::CtcLinobs(const Matrix& A, const Vector& b, IntervalMatrix (*exp_At)(const Matrix& A, const Interval& t))
     : DynCtc(), m_A(A), m_b(b), m_exp_At(exp_At)
   {
-    assert(A.nb_cols() == 2 && A.nb_rows() == 2);
-    assert(b.size() == 2);
-
+    assert(A.nb_cols() == A.nb_rows());
+    assert(b.size() == A.nb_rows());
   }
 
   // Static members for contractor signature (mainly used for CN Exceptions)
@@ -45,8 +47,9 @@ namespace tubex
 
   void CtcLinobs::contract(TubeVector& x, const Tube& u, TimePropag t_propa)
   {
-    vector<ConvexPolygon> v_p_k;
-    contract(x, u, v_p_k, t_propa);
+    vector<double> v_t;
+    vector<IntervalVector> v_y;
+    contract(v_t, v_y, x, u, t_propa);
   }
 
   void CtcLinobs::contract(TubeVector& x, const Tube& u, vector<ConvexPolygon>& v_p_k, TimePropag t_propa)
@@ -58,8 +61,12 @@ namespace tubex
 
   void CtcLinobs::contract(double& t, IntervalVector& y, TubeVector& x, const Tube& u, TimePropag t_propa)
   {
-    vector<ConvexPolygon> v_p_k;
-    contract(t, y, x, u, v_p_k, t_propa);
+    vector<double> v_t(1, t);
+    vector<IntervalVector> v_y(1, y);
+
+    contract(v_t, v_y, x, u, t_propa);
+
+    y &= v_y[0];
   }
 
   void CtcLinobs::contract(double& t, IntervalVector& y, TubeVector& x, const Tube& u, vector<ConvexPolygon>& v_p_k, TimePropag t_propa)
@@ -74,8 +81,18 @@ namespace tubex
 
   void CtcLinobs::contract(vector<double>& v_t, vector<IntervalVector>& v_y, TubeVector& x, const Tube& u, TimePropag t_propa)
   {
-    vector<ConvexPolygon> v_p_k;
-    contract(v_t, v_y, x, u, v_p_k, t_propa);
+    // Polygons are finer enclosures in two dimensions
+    if(x.size() == 2)
+    {
+      vector<ConvexPolygon> v_p_k;
+      contract(v_t, v_y, x, u, v_p_k, t_propa);
+    }
+
+    else
+    {
+      vector<Zonotope> v_z_k;
+      contract(v_t, v_y, x, u, v_z_k, t_propa);
+    }
   }
 
   void CtcLinobs::contract(vector<double>& v_t, vector<IntervalVector>& v_y, TubeVector& x, const Tube& u, vector<ConvexPolygon>& v_p_k, TimePropag t_propa)
@@ -126,17 +143,21 @@ namespace tubex
         s1 = x[1].first_slice();
         su = u.first_slice();
 
-        while(s0 != NULL)
+        while(s0 != NULL && !deadline_expired()) // the CN may interrupt the contraction
         {
           const Interval tkm1_tk = s0->tdomain(); // [t_{k-1},t_k]
 
           if(tkm1_tk.intersects(m_restricted_tdomain))
           {
-            ctc_fwd_gate(v_p_k[i], v_p_k[i-1], tkm1_tk.diam(), m_A, m_b, su->codomain());
+            const ExpAtEnclosures& e = exp_At_enclosures(tkm1_tk.diam());
+            ctc_fwd_gate(v_p_k[i], v_p_k[i-1], tkm1_tk.diam(), e, su->codomain());
 
             for(size_t j = 0 ; j < v_t.size() ; j++) // observations at uncertain times
               if(tkm1_tk.contains(v_t[j]))
-                ctc_fwd_gate(v_p_k[i], ConvexPolygon(v_y[j]), tkm1_tk.ub()-v_t[j], m_A, m_b, su->codomain());
+              {
+                double dt = tkm1_tk.ub()-v_t[j];
+                ctc_fwd_gate(v_p_k[i], ConvexPolygon(v_y[j]), dt, compute_exp_At(dt), su->codomain());
+              }
             // todo: contraction of the observations
 
             IntervalVector ouputgate_box = v_p_k[i].box();
@@ -151,7 +172,7 @@ namespace tubex
 
             else
             {
-              IntervalVector envelope_box = polygon_envelope(v_p_k[i-1], tkm1_tk.diam(), m_A, m_b, su->codomain()).box();
+              IntervalVector envelope_box = polygon_envelope(v_p_k[i-1], tkm1_tk.diam(), e, su->codomain()).box();
               s0->set_envelope(envelope_box[0]);
               s1->set_envelope(envelope_box[1]);
             }
@@ -171,24 +192,28 @@ namespace tubex
         s1 = x[1].last_slice();
         su = u.last_slice();
 
-        while(s0 != NULL)
+        while(s0 != NULL && !deadline_expired()) // the CN may interrupt the contraction
         {
           const Interval tk_kp1 = s0->tdomain(); // [t_k,t_{k+1}]
 
           if(tk_kp1.intersects(m_restricted_tdomain))
           {
-            ctc_bwd_gate(v_p_k[i], v_p_k[i+1], tk_kp1.diam(), m_A, m_b, su->codomain());
+            const ExpAtEnclosures& e = exp_At_enclosures(tk_kp1.diam());
+            ctc_bwd_gate(v_p_k[i], v_p_k[i+1], tk_kp1.diam(), e, su->codomain());
 
             for(size_t j = 0 ; j < v_t.size() ; j++) // observations at uncertain times
               if(tk_kp1.contains(v_t[j]))
-                ctc_bwd_gate(v_p_k[i], ConvexPolygon(v_y[j]), v_t[j]-tk_kp1.lb(), m_A, m_b, su->codomain());
+              {
+                double dt = v_t[j]-tk_kp1.lb();
+                ctc_bwd_gate(v_p_k[i], ConvexPolygon(v_y[j]), dt, compute_exp_At(dt), su->codomain());
+              }
             // todo: contraction of the observations
 
             IntervalVector polybox = v_p_k[i].box();
             s0->set_input_gate(polybox[0]);
             s1->set_input_gate(polybox[1]);
 
-            IntervalVector envelope_box = polygon_envelope(v_p_k[i], tk_kp1.diam(), m_A, m_b, su->codomain()).box();
+            IntervalVector envelope_box = polygon_envelope(v_p_k[i], tk_kp1.diam(), e, su->codomain()).box();
             s0->set_envelope(envelope_box[0]);
             s1->set_envelope(envelope_box[1]);
           }
@@ -199,23 +224,238 @@ namespace tubex
       }
   }
 
+  void CtcLinobs::clear_exp_At_cache()
+  {
+    lock_guard<mutex> lock(m_exp_At_mutex);
+    m_exp_At_cache.clear();
+  }
+
+  void CtcLinobs::contract(TubeVector& x, const Tube& u, vector<Zonotope>& v_z_k, TimePropag t_propa)
+  {
+    vector<double> v_t;
+    vector<IntervalVector> v_y;
+    contract(v_t, v_y, x, u, v_z_k, t_propa);
+  }
+
+  void CtcLinobs::contract(double& t, IntervalVector& y, TubeVector& x, const Tube& u, vector<Zonotope>& v_z_k, TimePropag t_propa)
+  {
+    vector<double> v_t(1, t);
+    vector<IntervalVector> v_y(1, y);
+
+    contract(v_t, v_y, x, u, v_z_k, t_propa);
+
+    y &= v_y[0];
+  }
+
+  void CtcLinobs::contract(vector<double>& v_t, vector<IntervalVector>& v_y, TubeVector& x, const Tube& u, vector<Zonotope>& v_z_k, TimePropag t_propa)
+  {
+    assert(x.size() == m_A.nb_rows() && "A and x are not of same dimension");
+    assert(v_t.size() == v_y.size());
+    #ifdef DEBUG
+    for(int i = 0 ; i < x.size() ; i++)
+      assert(Tube::same_slicing(x[i], u));
+    for(const auto& t : v_t)
+      assert(x.tdomain().contains(t));
+    for(const auto& y : v_y)
+      assert(y.size() == x.size());
+    #endif
+
+    int n = x.size();
+    int k = x[0].nb_slices();
+
+    // Creating a vector of (k+1) zonotopes, from the gates
+    // (no need to bound them: unbounded sets are supported)
+
+      v_z_k.clear();
+      v_z_k.reserve(k+1);
+
+      vector<Slice*> v_s(n);
+      IntervalVector gate(n);
+      const Slice *su;
+
+      for(int j = 0 ; j < n ; j++)
+      {
+        v_s[j] = x[j].first_slice();
+        gate[j] = v_s[j]->input_gate();
+      }
+      v_z_k.push_back(Zonotope(gate));
+
+      while(v_s[0] != NULL)
+      {
+        for(int j = 0 ; j < n ; j++)
+        {
+          gate[j] = v_s[j]->output_gate();
+          v_s[j] = v_s[j]->next_slice();
+        }
+        v_z_k.push_back(Zonotope(gate));
+      }
+      assert((int)v_z_k.size() == k+1);
+
+    // Forward contractions
+
+      if(t_propa & TimePropag::FORWARD)
+      {
+        int i = 1;
+        for(int j = 0 ; j < n ; j++)
+          v_s[j] = x[j].first_slice();
+        su = u.first_slice();
+
+        while(v_s[0] != NULL && !deadline_expired()) // the CN may interrupt the contraction
+        {
+          const Interval tkm1_tk = v_s[0]->tdomain(); // [t_{k-1},t_k]
+
+          if(tkm1_tk.intersects(m_restricted_tdomain))
+          {
+            const ExpAtEnclosures& e = exp_At_enclosures(tkm1_tk.diam());
+            ctc_fwd_gate(v_z_k[i], v_z_k[i-1], tkm1_tk.diam(), e, su->codomain());
+
+            for(size_t j = 0 ; j < v_t.size() ; j++) // observations at uncertain times
+              if(tkm1_tk.contains(v_t[j]))
+              {
+                double dt = tkm1_tk.ub()-v_t[j];
+                ctc_fwd_gate(v_z_k[i], Zonotope(v_y[j]), dt, compute_exp_At(dt), su->codomain());
+              }
+            // todo: contraction of the observations
+
+            IntervalVector outputgate_box = v_z_k[i].box();
+            for(int j = 0 ; j < n ; j++)
+              v_s[j]->set_output_gate(v_s[j]->output_gate() & outputgate_box[j]);
+
+            if(t_propa & TimePropag::BACKWARD)
+            {
+              // The slice envelope can be computed only from the gates,
+              // and so it will be computed during the backward process.
+            }
+
+            else
+            {
+              IntervalVector envelope_box = zonotope_envelope(v_z_k[i-1], tkm1_tk.diam(), e, su->codomain()).box();
+              for(int j = 0 ; j < n ; j++)
+                v_s[j]->set_envelope(v_s[j]->codomain() & envelope_box[j]);
+            }
+          }
+
+          for(int j = 0 ; j < n ; j++)
+            v_s[j] = v_s[j]->next_slice();
+          su = su->next_slice();
+          i++;
+        }
+      }
+
+    // Backward contractions
+
+      if(t_propa & TimePropag::BACKWARD)
+      {
+        int i = k-1;
+        for(int j = 0 ; j < n ; j++)
+          v_s[j] = x[j].last_slice();
+        su = u.last_slice();
+
+        while(v_s[0] != NULL && !deadline_expired()) // the CN may interrupt the contraction
+        {
+          const Interval tk_kp1 = v_s[0]->tdomain(); // [t_k,t_{k+1}]
+
+          if(tk_kp1.intersects(m_restricted_tdomain))
+          {
+            const ExpAtEnclosures& e = exp_At_enclosures(tk_kp1.diam());
+            ctc_bwd_gate(v_z_k[i], v_z_k[i+1], tk_kp1.diam(), e, su->codomain());
+
+            for(size_t j = 0 ; j < v_t.size() ; j++) // observations at uncertain times
+              if(tk_kp1.contains(v_t[j]))
+              {
+                double dt = v_t[j]-tk_kp1.lb();
+                ctc_bwd_gate(v_z_k[i], Zonotope(v_y[j]), dt, compute_exp_At(dt), su->codomain());
+              }
+            // todo: contraction of the observations
+
+            IntervalVector inputgate_box = v_z_k[i].box();
+            for(int j = 0 ; j < n ; j++)
+              v_s[j]->set_input_gate(v_s[j]->input_gate() & inputgate_box[j]);
+
+            IntervalVector envelope_box = zonotope_envelope(v_z_k[i], tk_kp1.diam(), e, su->codomain()).box();
+            for(int j = 0 ; j < n ; j++)
+              v_s[j]->set_envelope(v_s[j]->codomain() & envelope_box[j]);
+          }
+
+          for(int j = 0 ; j < n ; j++)
+            v_s[j] = v_s[j]->prev_slice();
+          su = su->prev_slice();
+          i--;
+        }
+      }
+  }
+
+  CtcLinobs::ExpAtEnclosures CtcLinobs::compute_exp_At(const Interval& dt) const
+  {
+    ExpAtEnclosures e = {
+      m_exp_At(m_A, dt), m_exp_At(m_A, Interval(0.,dt.ub())),
+      m_exp_At(-m_A, dt), m_exp_At(-m_A, Interval(0.,dt.ub()))
+    };
+    return e;
+  }
+
+  const CtcLinobs::ExpAtEnclosures& CtcLinobs::exp_At_enclosures(double dt)
+  {
+    // The widths of uniform slices may differ by a few ulps: they are gathered
+    // in small intervals (of relative width 2^-32) enclosing all of them,
+    // so that uniform slicings only require a couple of computations
+
+    int exponent;
+    double mantissa = frexp(dt, &exponent);
+    double key = ldexp(floor(ldexp(mantissa, 32)), exponent-32);
+
+    // The cache may be filled by several threads sharing this contractor.
+    // References to its items remain valid after other insertions.
+    {
+      lock_guard<mutex> lock(m_exp_At_mutex);
+      map<double,ExpAtEnclosures>::const_iterator it = m_exp_At_cache.find(key);
+      if(it != m_exp_At_cache.end())
+        return it->second;
+    }
+
+    ExpAtEnclosures e = compute_exp_At(Interval(key, key+ldexp(1., exponent-32))); // computed without lock
+
+    lock_guard<mutex> lock(m_exp_At_mutex);
+    return m_exp_At_cache.insert(make_pair(key, e)).first->second; // no effect if inserted meanwhile
+  }
+
   void CtcLinobs::ctc_fwd_gate(ConvexPolygon& p_k, const ConvexPolygon& p_km1,
-    double dt_km1_k, const Matrix& A, const Vector& b, const Interval& u_km1)
+    double dt_km1_k, const ExpAtEnclosures& e, const Interval& u_km1)
   {
-    p_k = p_k & (m_exp_At(A,dt_km1_k)*p_km1 + dt_km1_k*m_exp_At(A,Interval(0.,dt_km1_k))*(u_km1*b));
+    p_k = p_k & (e.exp_At*p_km1 + dt_km1_k*e.exp_A0t*(u_km1*m_b));
     p_k.simplify(m_polygon_max_edges);
   }
 
   void CtcLinobs::ctc_bwd_gate(ConvexPolygon& p_k, const ConvexPolygon& p_kp1,
-    double dt_k_kp1, const Matrix& A, const Vector& b, const Interval& u_k)
+    double dt_k_kp1, const ExpAtEnclosures& e, const Interval& u_k)
   {
-    p_k = p_k & (m_exp_At(-A,dt_k_kp1)*p_kp1 - dt_k_kp1*m_exp_At(-A,Interval(0.,dt_k_kp1))*(u_k*b));
+    p_k = p_k & (e.exp_mAt*p_kp1 - dt_k_kp1*e.exp_mA0t*(u_k*m_b));
     p_k.simplify(m_polygon_max_edges);
   }
 
   ConvexPolygon CtcLinobs::polygon_envelope(const ConvexPolygon& p_k,
-    double dt_k_kp1, const Matrix& A, const Vector& b, const Interval& u_k)
+    double dt_k_kp1, const ExpAtEnclosures& e, const Interval& u_k)
+  {
+    return e.exp_A0t*p_k + Interval(0.,dt_k_kp1)*e.exp_A0t*(u_k*m_b);
+  }
+
+  void CtcLinobs::ctc_fwd_gate(Zonotope& z_k, const Zonotope& z_km1,
+    double dt_km1_k, const ExpAtEnclosures& e, const Interval& u_km1)
+  {
+    z_k = z_k & (e.exp_At*z_km1 + dt_km1_k*(e.exp_A0t*(u_km1*m_b)));
+    z_k.reduce(m_zonotope_max_order*z_k.size());
+  }
+
+  void CtcLinobs::ctc_bwd_gate(Zonotope& z_k, const Zonotope& z_kp1,
+    double dt_k_kp1, const ExpAtEnclosures& e, const Interval& u_k)
+  {
+    z_k = z_k & (e.exp_mAt*z_kp1 - dt_k_kp1*(e.exp_mA0t*(u_k*m_b)));
+    z_k.reduce(m_zonotope_max_order*z_k.size());
+  }
+
+  Zonotope CtcLinobs::zonotope_envelope(const Zonotope& z_k,
+    double dt_k_kp1, const ExpAtEnclosures& e, const Interval& u_k)
   {
-    return m_exp_At(A,Interval(0.,dt_k_kp1))*p_k + Interval(0.,dt_k_kp1)*m_exp_At(A,Interval(0.,dt_k_kp1))*(u_k*b);
+    return e.exp_A0t*z_k + Interval(0.,dt_k_kp1)*(e.exp_A0t*(u_k*m_b));
   }
 }
\ No newline at end of file
@@ -13,15 +13,26 @@
 #define __TUBEX_CTCLINOBS_H__
 
 #include <map>
+#include <mutex>
 #include <vector>
 #include <functional>
 #include "tubex_DynCtc.h"
 #include "tubex_ConvexPolygon.h"
+#include "tubex_Zonotope.h"
 
 namespace tubex
 {
   /**
    * \class CtcLinobs
+   * \brief Contractor for linear systems \f$\dot{\mathbf{x}}=\mathbf{A}\mathbf{x}+\mathbf{b}u\f$
+   *
+   * Gates are enclosed by convex polygons for 2d systems, and by zonotopes
+   * in any dimension. The latter support unbounded initial sets.
+   *
+   * \note The enclosures of \f$e^{\mathbf{A}t}\f$ are computed once per slice width
+   *       and kept from one contraction to the other: see clear_exp_At_cache().
+   *       This cache is protected by a mutex, so that the object can be shared
+   *       by contractions running in parallel.
    */
   class CtcLinobs : public DynCtc
   {
@@ -45,13 +56,49 @@ namespace tubex
       void contract(std::vector<double>& v_t, std::vector<ibex::IntervalVector>& v_y, TubeVector& x, const Tube& u, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
       void contract(std::vector<double>& v_t, std::vector<ibex::IntervalVector>& v_y, TubeVector& x, const Tube& u, std::vector<ConvexPolygon>& v_p_k, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
 
+      // n-dimensional systems
+      void contract(TubeVector& x, const Tube& u, std::vector<Zonotope>& v_z_k, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
+      void contract(double& t, ibex::IntervalVector& y, TubeVector& x, const Tube& u, std::vector<Zonotope>& v_z_k, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
+      void contract(std::vector<double>& v_t, std::vector<ibex::IntervalVector>& v_y, TubeVector& x, const Tube& u, std::vector<Zonotope>& v_z_k, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
+
+
+      /**
+       * \brief Forgets the enclosures of \f$e^{\mathbf{A}t}\f$ computed so far
+       *
+       * \note To be called if the matrix \f$\mathbf{A}\f$ has been modified,
+       *       while no contraction is running
+       */
+      void clear_exp_At_cache();
+
 
     protected:
 
-      void ctc_fwd_gate(ConvexPolygon& p_k, const ConvexPolygon& p_km1, double dt_km1_k, const ibex::Matrix& A, const ibex::Vector& b, const ibex::Interval& u_km1);
-      void ctc_bwd_gate(ConvexPolygon& p_k, const ConvexPolygon& p_kp1, double dt_k_kp1, const ibex::Matrix& A, const ibex::Vector& b, const ibex::Interval& u_k);
+      /**
+       * \struct ExpAtEnclosures
+       * \brief Enclosures of the exponential matrices related to a time step dt
+       *
+       * \note dt may be an interval enclosing several close time steps
+       */
+      struct ExpAtEnclosures
+      {
+        ibex::IntervalMatrix exp_At; //!< \f$e^{\mathbf{A}dt}\f$
+        ibex::IntervalMatrix exp_A0t; //!< \f$e^{\mathbf{A}[0,dt]}\f$
+        ibex::IntervalMatrix exp_mAt; //!< \f$e^{-\mathbf{A}dt}\f$
+        ibex::IntervalMatrix exp_mA0t; //!< \f$e^{-\mathbf{A}[0,dt]}\f$
+      };
+
+      ExpAtEnclosures compute_exp_At(const ibex::Interval& dt) const;
+      const ExpAtEnclosures& exp_At_enclosures(double dt);
+
+      void ctc_fwd_gate(ConvexPolygon& p_k, const ConvexPolygon& p_km1, double dt_km1_k, const ExpAtEnclosures& e, const ibex::Interval& u_km1);
+      void ctc_bwd_gate(ConvexPolygon& p_k, const ConvexPolygon& p_kp1, double dt_k_kp1, const ExpAtEnclosures& e, const ibex::Interval& u_k);
+
+      ConvexPolygon polygon_envelope(const ConvexPolygon& p_k, double dt_k_kp1, const ExpAtEnclosures& e, const ibex::Interval& u_k);
+
+      void ctc_fwd_gate(Zonotope& z_k, const Zonotope& z_km1, double dt_km1_k, const ExpAtEnclosures& e, const ibex::Interval& u_km1);
+      void ctc_bwd_gate(Zonotope& z_k, const Zonotope& z_kp1, double dt_k_kp1, const ExpAtEnclosures& e, const ibex::Interval& u_k);
 
-      ConvexPolygon polygon_envelope(const ConvexPolygon& p_k, double dt_k_kp1, const ibex::Matrix& A, const ibex::Vector& b, const ibex::Interval& u_k);
+      Zonotope zonotope_envelope(const Zonotope& z_k, double dt_k_kp1, const ExpAtEnclosures& e, const ibex::Interval& u_k);
 
     protected:
 
@@ -60,6 +107,9 @@ namespace tubex
       ibex::IntervalMatrix (*m_exp_At)(const ibex::Matrix& A, const ibex::Interval& t);
 
       const int m_polygon_max_edges = 15;
+      const int m_zonotope_max_order = 2; //!< maximum number of generators per dimension
+      std::map<double,ExpAtEnclosures> m_exp_At_cache; //!< enclosures of e^At, for the encountered slice widths
+      std::mutex m_exp_At_mutex; //!< protects the cache against concurrent contractions
 
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
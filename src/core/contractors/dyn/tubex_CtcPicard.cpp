@@ -57,14 +57,14 @@ namespace tubex
     else
     {
       TubeVector *first_slicing = NULL;
-      if(m_preserve_slicing)
+      if(slicing_preserved())
         first_slicing = new TubeVector(x);
 
       if(t_propa & TimePropag::FORWARD)
       {
         int nb_slices = x.nb_slices();
 
-        for(int k = 0 ; k < nb_slices ; k++)
+        for(int k = 0 ; k < nb_slices && !deadline_expired() ; k++) // the CN may interrupt the contraction
         {
           if(!x(k).is_unbounded())
             continue;
@@ -88,7 +88,7 @@ namespace tubex
 
       if(t_propa & TimePropag::BACKWARD)
       {
-        for(int k = x.nb_slices() - 1 ; k >= 0 ; k--)
+        for(int k = x.nb_slices() - 1 ; k >= 0 && !deadline_expired() ; k--) // the CN may interrupt the contraction
         {
           if(!x(k).is_unbounded())
             continue;
@@ -8,6 +8,9 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <thread>
+#include <atomic>
+#include <algorithm>
 #include "tubex_CtcStatic.h"
 #include "tubex_DomainsTypeException.h"
 
@@ -22,16 +25,67 @@ namespace tubex
 
   }
 
+  void CtcStatic::set_nb_threads(int nb_threads, const vector<Ctc*>& v_thread_ctc)
+  {
+    assert(nb_threads > 0);
+
+    if(nb_threads > 1 && (int)v_thread_ctc.size() != nb_threads)
+      throw Exception(__func__, "one contractor per thread is expected");
+
+    for(const auto& ctc : v_thread_ctc)
+      if(ctc == NULL || ctc == &m_static_ctc || ctc->nb_var != m_static_ctc.nb_var)
+        throw Exception(__func__, "thread contractors must be distinct copies of the static contractor");
+
+    vector<Ctc*> v_sorted_ctc(v_thread_ctc);
+    sort(v_sorted_ctc.begin(), v_sorted_ctc.end());
+    if(adjacent_find(v_sorted_ctc.begin(), v_sorted_ctc.end()) != v_sorted_ctc.end())
+      throw Exception(__func__, "thread contractors must be distinct copies of the static contractor");
+
+    m_nb_threads = nb_threads;
+    m_v_thread_ctc = nb_threads > 1 ? v_thread_ctc : vector<Ctc*>();
+  }
+
+  int CtcStatic::nb_threads() const
+  {
+    return m_nb_threads;
+  }
+
   // Static members for contractor signature (mainly used for CN Exceptions)
   const string CtcStatic::m_ctc_name = "CtcStatic";
   vector<string> CtcStatic::m_str_expected_doms(
   {
-    "Slice[, Slice..]"
+    "Slice[, Slice..]",
+    "Tube|TubeVector[, Tube|TubeVector..]"
   });
 
   void CtcStatic::contract(vector<Domain*>& v_domains)
   {
     assert(!v_domains.empty());
+
+    // Tube case: contractor kept at the tube level in a CN
+    // (see ContractorNetwork::break_down_static_ctc)
+    if(v_domains[0]->type() == Domain::Type::T_TUBE || v_domains[0]->type() == Domain::Type::T_TUBE_VECTOR)
+    {
+      vector<Slice*> v_x_slices;
+
+      for(auto& dom : v_domains)
+      {
+        if(dom->type() == Domain::Type::T_TUBE)
+          v_x_slices.push_back(dom->tube().first_slice());
+
+        else if(dom->type() == Domain::Type::T_TUBE_VECTOR)
+          for(int i = 0 ; i < dom->tube_vector().size() ; i++)
+            v_x_slices.push_back(dom->tube_vector()[i].first_slice());
+
+        else
+          throw DomainsTypeException(m_ctc_name, v_domains, m_str_expected_doms);
+      }
+
+      assert((int)v_x_slices.size()+m_dynamic_ctc == m_static_ctc.nb_var);
+      contract(v_x_slices.data(), v_x_slices.size());
+      return;
+    }
+
     assert(!m_dynamic_ctc && "not implemented for inter-temporal constraints");
 
     for(size_t i = 0 ; i < v_domains.size() ; i++)
@@ -43,8 +97,9 @@ namespace tubex
         assert(v_domains[i]->slice().tdomain() == v_domains[i-1]->slice().tdomain());
     }
 
-    // If these slices should not be impacted by the contractor
-    if(!v_domains[0]->slice().tdomain().intersects(m_restricted_tdomain))
+    // If these slices should not be impacted by the contractor, or have not changed
+    if(!v_domains[0]->slice().tdomain().intersects(m_restricted_tdomain)
+      || !v_domains[0]->slice().tdomain().intersects(changed_tdomain()))
       return;
 
     int n = v_domains.size();
@@ -173,13 +228,20 @@ namespace tubex
 
   void CtcStatic::contract(Slice **v_x_slices, int n)
   {
+    if(m_nb_threads > 1)
+    {
+      contract_parallel(v_x_slices, n);
+      return;
+    }
+
     IntervalVector envelope(n + m_dynamic_ctc);
     IntervalVector ingate(n + m_dynamic_ctc);
 
-    while(v_x_slices[0] != NULL)
+    while(v_x_slices[0] != NULL && !deadline_expired()) // the CN may interrupt the contraction
     {
-      // If these slices should not be impacted by the contractor
-      if(!v_x_slices[0]->tdomain().intersects(m_restricted_tdomain))
+      // If these slices should not be impacted by the contractor, or have not changed
+      if(!v_x_slices[0]->tdomain().intersects(m_restricted_tdomain)
+        || !v_x_slices[0]->tdomain().intersects(changed_tdomain()))
       {
         for(int i = 0 ; i < n ; i++)
           v_x_slices[i] = v_x_slices[i]->next_slice();
@@ -235,4 +297,120 @@ namespace tubex
           v_x_slices[i] = v_x_slices[i]->next_slice();
     }
   }
-}
\ No newline at end of file
+
+  void CtcStatic::contract_parallel(Slice **v_x_slices, int n)
+  {
+    const int m = n + m_dynamic_ctc;
+
+    // Gathering the rows of slices to be contracted (sequential traversal of the tubes)
+
+      vector<Slice*> v_rows; // n slices per row
+      vector<Slice*> v_s(v_x_slices, v_x_slices + n);
+      bool last_row = false; // output gates to be contracted
+
+      while(v_s[0] != NULL)
+      {
+        // If these slices should not be impacted by the contractor, or have not changed
+        if(v_s[0]->tdomain().intersects(m_restricted_tdomain)
+          && v_s[0]->tdomain().intersects(changed_tdomain()))
+        {
+          v_rows.insert(v_rows.end(), v_s.begin(), v_s.end());
+          last_row = (v_s[0]->next_slice() == NULL);
+        }
+
+        for(int i = 0 ; i < n ; i++)
+          v_s[i] = v_s[i]->next_slice();
+      }
+
+      const size_t nb_rows = v_rows.size() / n;
+      if(nb_rows == 0)
+        return;
+
+      // Envelopes and input gates, row by row
+      vector<Interval> v_envelope(nb_rows*m), v_ingate(nb_rows*m);
+
+      for(size_t r = 0 ; r < nb_rows ; r++)
+      {
+        if(m_dynamic_ctc)
+        {
+          v_envelope[r*m] = v_rows[r*n]->tdomain();
+          v_ingate[r*m] = v_rows[r*n]->tdomain().lb();
+        }
+
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_envelope[r*m+i+m_dynamic_ctc] = v_rows[r*n+i]->codomain();
+          v_ingate[r*m+i+m_dynamic_ctc] = v_rows[r*n+i]->input_gate();
+        }
+      }
+
+    // Contractions of ranges of rows, without any access to the slices
+
+      // The context of the call is specific to this thread
+      const Deadline *ctc_deadline = deadline();
+      atomic<bool> interrupted(false);
+
+      auto contract_rows = [&](int k, size_t r_begin, size_t r_end)
+      {
+        Ctc& ctc = *m_v_thread_ctc[k]; // IBEX contractors are not shared by the threads
+        IntervalVector box(m);
+
+        for(size_t r = r_begin ; r < r_end ; r++)
+        {
+          if(ctc_deadline != NULL && ctc_deadline->expired()) // the CN may interrupt the contraction
+          {
+            interrupted = true;
+            break;
+          }
+
+          for(Interval *values : { &v_envelope[r*m], &v_ingate[r*m] })
+          {
+            for(int i = 0 ; i < m ; i++)
+              box[i] = values[i];
+            ctc.contract(box);
+            for(int i = 0 ; i < m ; i++)
+              values[i] = box[i];
+          }
+        }
+      };
+
+      const int nb_threads = (int)std::min((size_t)m_nb_threads, nb_rows);
+      const size_t chunk = (nb_rows + nb_threads - 1) / nb_threads;
+
+      vector<thread> v_threads;
+      for(int k = 1 ; k < nb_threads ; k++)
+        v_threads.push_back(thread(contract_rows, k, std::min(k*chunk, nb_rows), std::min((k+1)*chunk, nb_rows)));
+      contract_rows(0, 0, chunk);
+      for(auto& th : v_threads)
+        th.join();
+
+      if(interrupted)
+        set_interrupted();
+
+    // Updating the slices (setters are not thread-safe: synthesis trees, CN notifications)
+
+      for(size_t r = 0 ; r < nb_rows ; r++)
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_rows[r*n+i]->set_envelope(v_envelope[r*m+i+m_dynamic_ctc]);
+          v_rows[r*n+i]->set_input_gate(v_ingate[r*m+i+m_dynamic_ctc]);
+        }
+
+      if(last_row && !deadline_expired())
+      {
+        IntervalVector outgate(m);
+        Slice **v_last = &v_rows[(nb_rows-1)*n];
+
+        if(m_dynamic_ctc)
+          outgate[0] = v_last[0]->tdomain().ub();
+
+        for(int i = 0 ; i < n ; i++)
+          outgate[i+m_dynamic_ctc] = v_last[i]->output_gate();
+
+        m_static_ctc.contract(outgate);
+
+        for(int i = 0 ; i < n ; i++)
+          v_last[i]->set_output_gate(outgate[i+m_dynamic_ctc]);
+      }
+  }
+}
@@ -37,6 +37,28 @@ namespace tubex
        */
       CtcStatic(ibex::Ctc& ibex_ctc, bool dynamic_ctc = false);
 
+      /**
+       * \brief Distributes the contractions of the slices over several threads,
+       *        each of them dealing with a range of slices
+       *
+       * \note IBEX contractors are usually not thread-safe (for instance, CtcFwdBwd
+       *       evaluates the function in internal buffers): they are never shared by the
+       *       threads. One contractor per thread has to be provided, equivalent to the one
+       *       of this object, otherwise an exception is thrown.
+       *
+       * \param nb_threads number of threads, 1 for sequential contractions
+       * \param v_thread_ctc contractors used by each thread (`nb_threads` distinct items),
+       *        not needed for sequential contractions
+       */
+      void set_nb_threads(int nb_threads, const std::vector<ibex::Ctc*>& v_thread_ctc = std::vector<ibex::Ctc*>());
+
+      /**
+       * \brief Returns the number of threads used for the contractions
+       *
+       * \return the number of threads, 1 by default
+       */
+      int nb_threads() const;
+
       /*
        * \brief Contracts a set of abstract domains
        *
@@ -122,8 +144,21 @@ namespace tubex
 
     protected:
 
+      /**
+       * \brief Contracts an array of slices on several threads
+       *
+       * The values of the slices are gathered, contracted by the threads in
+       * separate ranges, and then written back in the slices by the calling thread.
+       *
+       * \param v_x_slices the first slices of the tubes to be contracted
+       * \param n the dimension of the array
+       */
+      void contract_parallel(Slice **v_x_slices, int n);
+
       ibex::Ctc& m_static_ctc; //!< related static contractor
       int m_dynamic_ctc; //!< specifies either the temporal tdomain is part of the contraction or not
+      int m_nb_threads = 1; //!< number of threads for the contractions of the slices
+      std::vector<ibex::Ctc*> m_v_thread_ctc; //!< optional contractors of the threads
 
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
@@ -0,0 +1,73 @@
+/** 
+ *  Deadline class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <cassert>
+#include "tubex_Deadline.h"
+
+using namespace std;
+
+namespace tubex
+{
+  Deadline::Deadline()
+    : m_t_start(chrono::steady_clock::now()), m_cancelled(false)
+  {
+
+  }
+
+  Deadline::Deadline(double dt)
+    : Deadline()
+  {
+    assert(!std::isnan(dt) && dt >= 0. && "invalid time budget");
+
+    if(dt < 1.e9) // beyond, considered as unbounded (avoids clock overflows)
+    {
+      m_bounded = true;
+      m_t_end = m_t_start + chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::duration<double>(dt));
+    }
+  }
+
+  void Deadline::cancel()
+  {
+    m_cancelled.store(true, memory_order_relaxed);
+  }
+
+  bool Deadline::is_cancelled() const
+  {
+    return m_cancelled.load(memory_order_relaxed);
+  }
+
+  bool Deadline::expired() const
+  {
+    if(is_cancelled())
+      return true;
+
+    return m_bounded && chrono::steady_clock::now() >= m_t_end;
+  }
+
+  double Deadline::elapsed_time() const
+  {
+    return chrono::duration<double>(chrono::steady_clock::now() - m_t_start).count();
+  }
+
+  double Deadline::remaining_time() const
+  {
+    if(is_cancelled())
+      return 0.;
+
+    if(!m_bounded)
+      return numeric_limits<double>::infinity();
+
+    return max(0., chrono::duration<double>(m_t_end - chrono::steady_clock::now()).count());
+  }
+}
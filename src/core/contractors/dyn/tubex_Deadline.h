@@ -0,0 +1,93 @@
+/** 
+ *  \file
+ *  Deadline class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_DEADLINE_H__
+#define __TUBEX_DEADLINE_H__
+
+#include <chrono>
+#include <atomic>
+
+namespace tubex
+{
+  /**
+   * \class Deadline
+   * \brief Time budget and cancellation token shared between a ContractorNetwork
+   *        and the dynamical contractors it involves.
+   *
+   * Time is measured with a monotonic wall clock (`std::chrono::steady_clock`),
+   * not with the CPU time of the process. Long contractors can test `expired()`
+   * between two slices in order to yield before the end of their computation.
+   */
+  class Deadline
+  {
+    public:
+
+      /**
+       * \brief Creates an unbounded deadline, that can only expire by cancellation
+       */
+      Deadline();
+
+      /**
+       * \brief Creates a deadline expiring \f$dt\f$ seconds after its creation
+       *
+       * \param dt allowed computation time in seconds, possibly infinite
+       */
+      explicit Deadline(double dt);
+
+      /**
+       * \brief Cancels the related computations, whatever the remaining time
+       *
+       * \note This method can be called from another thread.
+       */
+      void cancel();
+
+      /**
+       * \brief Returns `true` if the deadline has been cancelled
+       *
+       * \return cancellation test
+       */
+      bool is_cancelled() const;
+
+      /**
+       * \brief Returns `true` if the time budget has been exceeded or if the
+       *        deadline has been cancelled
+       *
+       * \note For unbounded deadlines, the clock is not queried.
+       *
+       * \return expiration test
+       */
+      bool expired() const;
+
+      /**
+       * \brief Returns the wall-clock time elapsed since the creation of the deadline
+       *
+       * \return elapsed time in seconds
+       */
+      double elapsed_time() const;
+
+      /**
+       * \brief Returns the wall-clock time remaining before the expiration
+       *
+       * \return remaining time in seconds, infinite for unbounded deadlines
+       *         and 0 for cancelled ones
+       */
+      double remaining_time() const;
+
+    protected:
+
+      const std::chrono::steady_clock::time_point m_t_start; //!< creation time
+      std::chrono::steady_clock::time_point m_t_end; //!< expiration time (if bounded)
+      bool m_bounded = false; //!< `false` if the deadline can only expire by cancellation
+      std::atomic<bool> m_cancelled; //!< cancellation token
+  };
+}
+
+#endif
@@ -15,6 +15,9 @@ using namespace ibex;
 
 namespace tubex
 {
+  thread_local const DynCtc *DynCtc::s_context_ctc = NULL;
+  thread_local const ContractionContext *DynCtc::s_context = NULL;
+
   DynCtc::DynCtc(bool intertemporal)
     : m_intertemporal(intertemporal)
   {
@@ -26,6 +29,31 @@ namespace tubex
 
   }
 
+  void DynCtc::contract(vector<Domain*>& v_domains, const ContractionContext& context)
+  {
+    // Contexts are stacked, for contractors calling other ones
+    const DynCtc *prev_ctc = s_context_ctc;
+    const ContractionContext *prev_context = s_context;
+
+    s_context_ctc = this;
+    s_context = &context;
+
+    try
+    {
+      contract(v_domains);
+    }
+
+    catch(...)
+    {
+      s_context_ctc = prev_ctc;
+      s_context = prev_context;
+      throw;
+    }
+
+    s_context_ctc = prev_ctc;
+    s_context = prev_context;
+  }
+
   void DynCtc::preserve_slicing(bool preserve)
   {
     m_preserve_slicing = preserve;
@@ -45,4 +73,69 @@ namespace tubex
   {
     return m_intertemporal;
   }
+
+  void DynCtc::set_deadline(const Deadline *deadline)
+  {
+    m_deadline = deadline;
+  }
+
+  void DynCtc::set_changed_tdomain(const Interval& changed_tdomain)
+  {
+    m_changed_tdomain = changed_tdomain;
+  }
+
+  const Interval DynCtc::dependency_tdomain(const vector<Domain*>& v_domains) const
+  {
+    return Interval::ALL_REALS;
+  }
+
+  const Interval DynCtc::dependency_tdomain(const vector<Domain*>& v_domains, const ContractionContext& context) const
+  {
+    const DynCtc *prev_ctc = s_context_ctc;
+    const ContractionContext *prev_context = s_context;
+
+    s_context_ctc = this;
+    s_context = &context;
+    const Interval dependency = dependency_tdomain(v_domains);
+    s_context_ctc = prev_ctc;
+    s_context = prev_context;
+
+    return dependency;
+  }
+
+  bool DynCtc::deadline_expired() const
+  {
+    const Deadline *d = deadline();
+    if(d == NULL || !d->expired())
+      return false;
+
+    set_interrupted();
+    return true;
+  }
+
+  void DynCtc::set_interrupted() const
+  {
+    if(context() != NULL)
+      context()->interrupted = true;
+  }
+
+  const Deadline* DynCtc::deadline() const
+  {
+    return context() != NULL ? context()->deadline : m_deadline;
+  }
+
+  bool DynCtc::slicing_preserved() const
+  {
+    return context() != NULL ? context()->preserve_slicing : m_preserve_slicing;
+  }
+
+  const Interval& DynCtc::changed_tdomain() const
+  {
+    return context() != NULL ? context()->changed_tdomain : m_changed_tdomain;
+  }
+
+  const ContractionContext* DynCtc::context() const
+  {
+    return s_context_ctc == this ? s_context : NULL;
+  }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 
 #include "tubex_Tube.h"
 #include "tubex_TubeVector.h"
+#include "tubex_Deadline.h"
 
 namespace tubex
 {
@@ -53,9 +54,33 @@ namespace tubex
   inline TimePropag operator|(TimePropag a, TimePropag b)
   { return static_cast<TimePropag>(static_cast<int>(a) | static_cast<int>(b)); }
 
+  /**
+   * \struct ContractionContext
+   * \brief Settings of a contraction that are specific to one registration of
+   *        a contractor in a ContractorNetwork
+   *
+   * These settings are not stored in the contractor object, so that a same
+   * object can be shared by several networks, possibly running in parallel.
+   */
+  struct ContractionContext
+  {
+    bool preserve_slicing = true; //!< if `true`, tube's slicing will not be affected by the contractor
+    bool time_propag = true; //!< if `false`, contractors such as CtcEval will not perform complete temporal propagations
+    const Deadline *deadline = NULL; //!< optional deadline for interrupting long contractions
+    ibex::Interval changed_tdomain = ibex::Interval::ALL_REALS; //!< window of the changes since the last call
+    mutable bool interrupted = false; //!< set by the contractor if it stopped before the end of its computations
+  };
+
   /**
    * \class DynCtc
    * \brief Contractor interface
+   *
+   * \note The contractors provided by the library do not modify their own
+   *       state when contracting: a same object can be used by several threads,
+   *       for instance through several ContractorNetwork objects, as long as its
+   *       settings (preserve_slicing(), set_fast_mode(), ...) are not modified meanwhile.
+   *       The only exception is the cache of CtcLinobs (and CtcChain), filled during
+   *       the contractions and protected by a mutex.
    */
   class DynCtc
   {
@@ -83,6 +108,18 @@ namespace tubex
        */
       virtual void contract(std::vector<Domain*>& v_domains) = 0;
 
+      /**
+       * \brief Contracts a set of abstract domains with the settings of a given context
+       *
+       * The context overrides the related settings of the contractor (slicing
+       * preservation, deadline, window of changes) during this call only, and
+       * for the current thread only. It is used by the ContractorNetwork.
+       *
+       * \param v_domains vector of Domain pointers
+       * \param context settings of this contraction
+       */
+      void contract(std::vector<Domain*>& v_domains, const ContractionContext& context);
+
       /**
        * \brief Specifies whether the contractor can impact the tube's slicing or not
        *
@@ -113,12 +150,114 @@ namespace tubex
        */
       bool is_intertemporal() const;
 
+      /**
+       * \brief Sets a deadline that long contractions may check between slices
+       *
+       * \note When the deadline expires, the contractor may stop before the end of
+       *       its computations. The result remains a valid (but weaker) contraction.
+       *       No resume position is stored: a next call starts the computations
+       *       again from the beginning. The deadline is automatically set by a
+       *       ContractorNetwork, that is notified of the interruptions (see ContractionContext).
+       *
+       * \param deadline pointer to a Deadline object, or `NULL` for unbounded computations
+       */
+      void set_deadline(const Deadline *deadline);
+
+      /**
+       * \brief Restricts the next contractions to the parts of the tubes that may be
+       *        impacted by changes that occurred in the given temporal window
+       *
+       * \note The window is automatically set by a ContractorNetwork, with the union
+       *       of the tdomains of the slices modified since the last call of this
+       *       contractor. By default, the whole temporal domain is considered.
+       *
+       * \param changed_tdomain window of the changes, possibly empty
+       */
+      void set_changed_tdomain(const ibex::Interval& changed_tdomain);
+
+      /**
+       * \brief Returns the temporal window on which the contractor depends, for the
+       *        given domains: changes outside this window will not trigger it in a CN
+       *
+       * \param v_domains vector of Domain pointers
+       * \return the temporal dependency, the whole temporal domain by default
+       */
+      virtual const ibex::Interval dependency_tdomain(const std::vector<Domain*>& v_domains) const;
+
+      /**
+       * \brief Returns the temporal window on which the contractor depends, for the
+       *        given domains and with the settings of a given context
+       *
+       * \param v_domains vector of Domain pointers
+       * \param context settings of the contractions
+       * \return the temporal dependency
+       */
+      const ibex::Interval dependency_tdomain(const std::vector<Domain*>& v_domains, const ContractionContext& context) const;
+
+    protected:
+
+      /**
+       * \brief Tests whether the current contraction has to be interrupted
+       *
+       * \note A contractor stopping because of this test is reported as interrupted
+       *       in the context of the contraction, if any (see set_interrupted()).
+       *
+       * \return `true` if a deadline has been set and has expired
+       */
+      bool deadline_expired() const;
+
+      /**
+       * \brief Reports that the current contraction stopped before the end of its
+       *        computations, for deadlines tested without deadline_expired()
+       *
+       * \note To be called from the thread that called the contractor
+       */
+      void set_interrupted() const;
+
+      /**
+       * \brief Returns the deadline of the current contraction
+       *
+       * \note To be evaluated before spawning worker threads, the context
+       *       of a contraction being specific to the thread that called it
+       *
+       * \return a pointer to the Deadline object, or `NULL`
+       */
+      const Deadline* deadline() const;
+
+      /**
+       * \brief Tests if the tube's slicing has to be preserved by the current contraction
+       *
+       * \return `true` if the slicing will not be affected
+       */
+      bool slicing_preserved() const;
+
+      /**
+       * \brief Returns the window of the changes since the last call of the contractor
+       *
+       * \return the temporal window, possibly empty
+       */
+      const ibex::Interval& changed_tdomain() const;
+
+      /**
+       * \brief Returns the context of the current contraction of this contractor
+       *
+       * \return a pointer to the ContractionContext object, or `NULL` if the
+       *         contractor is not called through contract(v_domains, context)
+       *         in the current thread
+       */
+      const ContractionContext* context() const;
+
     protected:
 
       bool m_preserve_slicing = true; //!< if `true`, tube's slicing will not be affected by the contractor
       bool m_fast_mode = false; //!< some contractors may propose more pessimistic but faster execution modes
       ibex::Interval m_restricted_tdomain; //!< limits the contractions to the specified temporal domain
       const bool m_intertemporal = true; //!< defines if the related constraint is inter-temporal or not (true by default)
+      const Deadline *m_deadline = NULL; //!< optional deadline for interrupting long contractions
+      ibex::Interval m_changed_tdomain = ibex::Interval::ALL_REALS; //!< window of the changes since the last call (see ContractorNetwork)
+
+      static thread_local const DynCtc *s_context_ctc; //!< contractor currently called with a context, in this thread
+      static thread_local const ContractionContext *s_context; //!< context of this call
   };
 }
 
@@ -17,25 +17,29 @@ using namespace ibex;
 namespace tubex
 {
   CtcFunction::CtcFunction(const Function& f)
-    : CtcFwdBwd(*new Function(f))
+    : CtcFwdBwd(*new Function(f)),
+      m_tape(f), m_y(f.image_dim(), Interval(0.)), m_batched_contraction(m_tape.is_supported())
   {
     // todo: clean delete
   }
 
   CtcFunction::CtcFunction(const Function& f, const Domain& y)
-    : CtcFwdBwd(*new Function(f), y)
+    : CtcFwdBwd(*new Function(f), y),
+      m_tape(f), m_y(f.image_dim()), m_batched_contraction(false)
   {
     // todo: clean delete
   }
   
   CtcFunction::CtcFunction(const Function& f, const Interval& y)
-    : CtcFwdBwd(*new Function(f), y)
+    : CtcFwdBwd(*new Function(f), y),
+      m_tape(f), m_y(1, y), m_batched_contraction(m_tape.is_supported())
   {
     // todo: clean delete
   }
 
   CtcFunction::CtcFunction(const Function& f, const IntervalVector& y)
-    : CtcFwdBwd(*new Function(f), y)
+    : CtcFwdBwd(*new Function(f), y),
+      m_tape(f), m_y(y), m_batched_contraction(m_tape.is_supported())
   {
     // todo: clean delete
   }
@@ -50,84 +54,78 @@ namespace tubex
   {
     assert(x.size() == nb_var);
 
-    Slice **v_x_slices = new Slice*[x.size()];
+    vector<Slice*> v_x_slices(x.size());
     for(int i = 0 ; i < x.size() ; i++)
       v_x_slices[i] = x[i].first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1)
   {
     assert(nb_var == 1);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2)
   {
     assert(nb_var == 2);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3)
   {
     assert(nb_var == 3);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4)
   {
     assert(nb_var == 4);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
     v_x_slices[3] = x4.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4, Tube& x5)
   {
     assert(nb_var == 5);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
     v_x_slices[3] = x4.first_slice();
     v_x_slices[4] = x5.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4, Tube& x5, Tube& x6)
   {
     assert(nb_var == 6);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
@@ -135,15 +133,14 @@ namespace tubex
     v_x_slices[4] = x5.first_slice();
     v_x_slices[5] = x6.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4, Tube& x5, Tube& x6, Tube& x7)
   {
     assert(nb_var == 7);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
@@ -152,15 +149,14 @@ namespace tubex
     v_x_slices[5] = x6.first_slice();
     v_x_slices[6] = x7.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4, Tube& x5, Tube& x6, Tube& x7, Tube& x8)
   {
     assert(nb_var == 8);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
@@ -170,15 +166,14 @@ namespace tubex
     v_x_slices[6] = x7.first_slice();
     v_x_slices[7] = x8.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4, Tube& x5, Tube& x6, Tube& x7, Tube& x8, Tube& x9)
   {
     assert(nb_var == 9);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
@@ -189,15 +184,14 @@ namespace tubex
     v_x_slices[7] = x8.first_slice();
     v_x_slices[8] = x9.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Tube& x1, Tube& x2, Tube& x3, Tube& x4, Tube& x5, Tube& x6, Tube& x7, Tube& x8, Tube& x9, Tube& x10)
   {
     assert(nb_var == 10);
 
-    Slice **v_x_slices = new Slice*[nb_var];
+    vector<Slice*> v_x_slices(nb_var);
     v_x_slices[0] = x1.first_slice();
     v_x_slices[1] = x2.first_slice();
     v_x_slices[2] = x3.first_slice();
@@ -209,11 +203,76 @@ namespace tubex
     v_x_slices[8] = x9.first_slice();
     v_x_slices[9] = x10.first_slice();
 
-    contract(v_x_slices);
-    delete v_x_slices;
+    contract(v_x_slices.data());
   }
 
   void CtcFunction::contract(Slice **v_x_slices)
+  {
+    if(!m_batched_contraction)
+    {
+      contract_slice_by_slice(v_x_slices);
+      return;
+    }
+
+    // The envelopes and input gates of a block of slices are gathered
+    // variable by variable, contracted at once, and then set back
+
+    int n = nb_var;
+    vector<Slice*> v_block(n*m_block_size);
+    vector<Interval> v_x(2*n*m_block_size), v_values;
+    bool last_block = false;
+
+    while(!last_block)
+    {
+      int nb_slices = 0;
+
+      while(nb_slices < m_block_size && !last_block)
+      {
+        for(int i = 0 ; i < n ; i++)
+          v_block[i*m_block_size+nb_slices] = v_x_slices[i];
+        nb_slices++;
+
+        if(v_x_slices[0]->next_slice() == NULL)
+          last_block = true;
+
+        else
+          for(int i = 0 ; i < n ; i++)
+            v_x_slices[i] = v_x_slices[i]->next_slice();
+      }
+
+      int b = 2*nb_slices; // envelopes, then input gates
+
+      for(int i = 0 ; i < n ; i++)
+        for(int k = 0 ; k < nb_slices ; k++)
+        {
+          v_x[i*b+k] = v_block[i*m_block_size+k]->codomain();
+          v_x[i*b+nb_slices+k] = v_block[i*m_block_size+k]->input_gate();
+        }
+
+      m_tape.contract(v_x, b, m_y, v_values);
+
+      for(int k = 0 ; k < nb_slices ; k++)
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_block[i*m_block_size+k]->set_envelope(v_x[i*b+k]);
+          v_block[i*m_block_size+k]->set_input_gate(v_x[i*b+nb_slices+k]);
+        }
+    }
+
+    // Output gate of the last slices
+
+    IntervalVector outgate(n);
+
+    for(int i = 0 ; i < n ; i++)
+      outgate[i] = v_x_slices[i]->output_gate();
+
+    CtcFwdBwd::contract(outgate);
+
+    for(int i = 0 ; i < n ; i++)
+      v_x_slices[i]->set_output_gate(outgate[i]);
+  }
+
+  void CtcFunction::contract_slice_by_slice(Slice **v_x_slices)
   {
     IntervalVector envelope(nb_var);
     IntervalVector ingate(nb_var);
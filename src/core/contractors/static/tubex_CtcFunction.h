@@ -17,6 +17,7 @@
 #include "ibex_CtcFwdBwd.h"
 #include "ibex_Domain.h"
 #include "tubex_TubeVector.h"
+#include "tubex_FunctionTape.h"
 
 namespace tubex
 {
@@ -25,6 +26,10 @@ namespace tubex
    * \brief Generic static \f$\mathcal{C}\f$ that contracts a box \f$[\mathbf{x}]\f$ or a tube \f$[\mathbf{x}](\cdot)\f$
    *        according to the constraint \f$\mathbf{f}(\mathbf{x})=\mathbf{0}\f$ or \f$\mathbf{f}(\mathbf{x})\in[\mathbf{y}]\f$.
    *        It stands on the CtcFwdBwd of IBEX (HC4Revise).
+   *
+   * \note Tubes are contracted by blocks of slices: one forward-backward pass
+   *       is performed on all the envelopes and gates of a block at once
+   *       (see FunctionTape), when the expression of \f$\mathbf{f}\f$ allows it.
    */
   class CtcFunction : public ibex::CtcFwdBwd
   {
@@ -201,6 +206,22 @@ namespace tubex
        * \param v_x_slices the slices to be contracted
        */
       void contract(Slice **v_x_slices);
+
+    protected:
+
+      /**
+       * \brief Contracts an array of slices, one slice after the other
+       *
+       * Used when the expression cannot be processed by a FunctionTape.
+       *
+       * \param v_x_slices the slices to be contracted
+       */
+      void contract_slice_by_slice(Slice **v_x_slices);
+
+      const FunctionTape m_tape; //!< flattened expression of f, for batched contractions
+      const ibex::IntervalVector m_y; //!< image set of the constraint
+      const bool m_batched_contraction; //!< false if the slices are contracted one by one
+      static const int m_block_size = 256; //!< number of slices contracted at once
   };
 }
 
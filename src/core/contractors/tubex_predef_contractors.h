@@ -19,6 +19,17 @@
 
 namespace tubex
 {
+  /**
+   * \namespace ctc
+   * \brief Predefined contractors
+   *
+   * \note These objects are not modified by their contractions, nor by the
+   *       ContractorNetwork objects they are added to (the settings of each
+   *       registration are stored in the network): they can be shared by
+   *       several networks running in parallel threads. Their own settings
+   *       (preserve_slicing(), set_fast_mode(), ...) should not be modified
+   *       meanwhile.
+   */
   namespace ctc
   {
     extern CtcDelay delay; // delay constraint (a,x,y)
@@ -11,6 +11,7 @@
 #include <iomanip>
 #include "tubex_Slice.h"
 #include "tubex_CtcDeriv.h"
+#include "tubex_Trail.h"
 
 using namespace std;
 using namespace ibex;
@@ -37,6 +38,9 @@ namespace tubex
 
     Slice::~Slice()
     {
+      if(m_trail != NULL)
+        m_trail->detach(*this);
+
       // Links to other slices are destroyed
       if(m_prev_slice != NULL) m_prev_slice->m_next_slice = NULL;
       if(m_next_slice != NULL) m_next_slice->m_prev_slice = NULL;
@@ -53,11 +57,22 @@ namespace tubex
 
     const Slice& Slice::operator=(const Slice& x)
     {
+      if(m_trail != NULL)
+        m_trail->record(this);
+
+      Interval prev_envelope, prev_input_gate, prev_output_gate; // copied only if changes are reported
+      if(m_changed_tdomain != NULL)
+      {
+        prev_envelope = m_codomain; prev_input_gate = *m_input_gate; prev_output_gate = *m_output_gate;
+      }
+
       m_tdomain = x.m_tdomain;
       m_codomain = x.m_codomain;
       *m_input_gate = *x.m_input_gate;
       *m_output_gate = *x.m_output_gate;
       
+      report_changes(prev_envelope, prev_input_gate, prev_output_gate);
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -225,14 +240,7 @@ namespace tubex
 
     const Interval Slice::invert(const Interval& y, const Interval& search_tdomain) const
     {
-      Slice v(tdomain(), Interval::ALL_REALS); // todo: optimize this
-      return invert(y, v, search_tdomain);
-    }
-
-    const Interval Slice::invert(const Interval& y, const Slice& v, const Interval& search_tdomain) const
-    {
-      assert(tdomain() == v.tdomain());
-      // todo: use enclosed bounds also? in order to speed up computations
+      // No derivative information: the envelope is the only knowledge inside the slice
 
       if(!m_tdomain.intersects(search_tdomain))
         return Interval::EMPTY_SET;
@@ -256,13 +264,23 @@ namespace tubex
           return Interval::EMPTY_SET;
       }
 
-      else if(v.codomain() == Interval::all_reals())
-      {
-        if(y.intersects(m_codomain))
-          return search_tdomain & m_tdomain;
-        else
-          return Interval::EMPTY_SET;
-      }
+      else if(y.intersects(m_codomain))
+        return search_tdomain & m_tdomain;
+
+      else
+        return Interval::EMPTY_SET;
+    }
+
+    const Interval Slice::invert(const Interval& y, const Slice& v, const Interval& search_tdomain) const
+    {
+      assert(tdomain() == v.tdomain());
+      // todo: use enclosed bounds also? in order to speed up computations
+
+      if(v.codomain() == Interval::all_reals()
+        || !m_tdomain.intersects(search_tdomain)
+        || search_tdomain == m_tdomain.lb() || search_tdomain == m_tdomain.ub()
+        || ((m_tdomain & search_tdomain) == m_tdomain && m_codomain.is_subset(y)))
+        return invert(y, search_tdomain);
 
       else
       {
@@ -394,6 +412,15 @@ namespace tubex
 
     void Slice::set(const Interval& y)
     {
+      if(m_trail != NULL)
+        m_trail->record(this);
+
+      Interval prev_envelope, prev_input_gate, prev_output_gate; // copied only if changes are reported
+      if(m_changed_tdomain != NULL)
+      {
+        prev_envelope = m_codomain; prev_input_gate = *m_input_gate; prev_output_gate = *m_output_gate;
+      }
+
       m_codomain = y;
 
       *m_input_gate = y;
@@ -404,6 +431,8 @@ namespace tubex
       if(next_slice() != NULL)
         *m_output_gate &= next_slice()->codomain();
 
+      report_changes(prev_envelope, prev_input_gate, prev_output_gate);
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -418,6 +447,15 @@ namespace tubex
 
     void Slice::set_envelope(const Interval& envelope, bool slice_consistency)
     {
+      if(m_trail != NULL)
+        m_trail->record(this);
+
+      Interval prev_envelope, prev_input_gate, prev_output_gate; // copied only if changes are reported
+      if(m_changed_tdomain != NULL)
+      {
+        prev_envelope = m_codomain; prev_input_gate = *m_input_gate; prev_output_gate = *m_output_gate;
+      }
+
       m_codomain = envelope;
 
       if(slice_consistency)
@@ -426,6 +464,8 @@ namespace tubex
         *m_output_gate &= m_codomain;
       }
 
+      report_changes(prev_envelope, prev_input_gate, prev_output_gate);
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -435,6 +475,15 @@ namespace tubex
 
     void Slice::set_input_gate(const Interval& input_gate, bool slice_consistency)
     {
+      if(m_trail != NULL)
+        m_trail->record(this);
+
+      Interval prev_envelope, prev_input_gate, prev_output_gate; // copied only if changes are reported
+      if(m_changed_tdomain != NULL)
+      {
+        prev_envelope = m_codomain; prev_input_gate = *m_input_gate; prev_output_gate = *m_output_gate;
+      }
+
       *m_input_gate = input_gate;
 
       if(slice_consistency)
@@ -444,6 +493,8 @@ namespace tubex
           *m_input_gate &= prev_slice()->codomain();
       }
 
+      report_changes(prev_envelope, prev_input_gate, prev_output_gate);
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -453,6 +504,15 @@ namespace tubex
 
     void Slice::set_output_gate(const Interval& output_gate, bool slice_consistency)
     {
+      if(m_trail != NULL)
+        m_trail->record(this);
+
+      Interval prev_envelope, prev_input_gate, prev_output_gate; // copied only if changes are reported
+      if(m_changed_tdomain != NULL)
+      {
+        prev_envelope = m_codomain; prev_input_gate = *m_input_gate; prev_output_gate = *m_output_gate;
+      }
+
       *m_output_gate = output_gate;
 
       if(slice_consistency)
@@ -462,6 +522,8 @@ namespace tubex
           *m_output_gate &= next_slice()->codomain();
       }
 
+      report_changes(prev_envelope, prev_input_gate, prev_output_gate);
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -508,6 +570,13 @@ namespace tubex
       }
     }
 
+    void Slice::report_changes(const Interval& prev_envelope, const Interval& prev_input_gate, const Interval& prev_output_gate)
+    {
+      if(m_changed_tdomain != NULL
+        && (m_codomain != prev_envelope || *m_input_gate != prev_input_gate || *m_output_gate != prev_output_gate))
+        *m_changed_tdomain |= m_tdomain;
+    }
+
     // Slices structure
 
     void Slice::chain_slices(Slice *first_slice, Slice *second_slice)
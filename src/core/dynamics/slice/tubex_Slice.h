@@ -25,6 +25,7 @@ namespace tubex
 
   class Tube;
   class Trajectory;
+  class Trail;
 
   /**
    * \class Slice
@@ -664,6 +665,16 @@ namespace tubex
        */
       const ibex::IntervalVector codomain_box() const;
 
+      /**
+       * \brief Extends the optional window of changes with the tdomain of this slice,
+       *        if its envelope or gates have been modified by a setter
+       *
+       * \param prev_envelope envelope before the change
+       * \param prev_input_gate input gate before the change
+       * \param prev_output_gate output gate before the change
+       */
+      void report_changes(const ibex::Interval& prev_envelope, const ibex::Interval& prev_input_gate, const ibex::Interval& prev_output_gate);
+
       // Class variables:
 
         ibex::Interval m_tdomain; //!< temporal domain \f$[t_0,t_f]\f$ of the slice
@@ -671,11 +682,17 @@ namespace tubex
         ibex::Interval *m_input_gate = NULL, *m_output_gate = NULL; //!< input and output gates
         Slice *m_prev_slice = NULL, *m_next_slice = NULL; //!< pointers to previous and next slices of the related tube
         mutable TubeTreeSynthesis *m_synthesis_reference = NULL; //!< pointer to a leaf of the optional synthesis tree of the related tube
+        Trail *m_trail = NULL; //!< optional undo log recording the values of this slice before any change
+        ibex::Interval *m_changed_tdomain = NULL; //!< optional window of the changes on the related tube (see ContractorNetwork)
 
       friend class Tube;
       friend class TubeTreeSynthesis;
       friend class CtcEval;
+      friend class Trail;
+      friend class ContractorNetwork;
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
+      friend void tube_from_columns(Tube& tube, const double *v_t, const double *v_lb, const double *v_ub,
+                                    const double *v_glb, const double *v_gub, size_t k0, size_t k1);
   };
 }
 
@@ -9,6 +9,7 @@
  */
 
 #include <sstream>
+#include <algorithm>
 #include "tubex_Trajectory.h"
 
 using namespace std;
@@ -23,7 +24,7 @@ namespace tubex
     Trajectory::Trajectory()
       : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
-      m_map_values = map<double,double>();
+
     }
 
     Trajectory::Trajectory(const Trajectory& traj)
@@ -40,6 +41,7 @@ namespace tubex
       // todo: check thickness of f? (only thin functions should be allowed)
 
       m_codomain = m_function->eval(tdomain);
+      m_function->compile(); // for fast point evaluations
     }
 
     Trajectory::Trajectory(const Interval& tdomain, const TFunction& f, double timestep)
@@ -50,19 +52,36 @@ namespace tubex
     }
 
     Trajectory::Trajectory(const map<double,double>& map_values)
-      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_map_values(map_values)
+      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
       assert(!map_values.empty());
 
+      m_v_t.reserve(map_values.size());
+      m_v_y.reserve(map_values.size());
+      for(const auto& it : map_values)
+      {
+        m_v_t.push_back(it.first);
+        m_v_y.push_back(it.second);
+      }
+
       // Temporal domain:
-      map<double,double>::const_iterator
-        last_it = map_values.end(); last_it--; // accessing last value
-      m_tdomain = Interval(map_values.begin()->first, last_it->first);
+      m_tdomain = Interval(m_v_t.front(), m_v_t.back());
 
       // Codomain:
       compute_codomain();
     }
 
+    Trajectory::Trajectory(const vector<double>& v_t, const vector<double>& v_y)
+      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_v_t(v_t), m_v_y(v_y)
+    {
+      assert(!v_t.empty() && v_t.size() == v_y.size());
+      for(size_t k = 1 ; k < v_t.size() ; k++)
+        assert(v_t[k-1] < v_t[k] && "temporal keys must be strictly increasing");
+
+      m_tdomain = Interval(m_v_t.front(), m_v_t.back());
+      compute_codomain();
+    }
+
     Trajectory::~Trajectory()
     {
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC && m_function != NULL)
@@ -83,7 +102,11 @@ namespace tubex
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          m_map_values = x.m_map_values;
+          x.merge_pending();
+          m_v_t = x.m_v_t;
+          m_v_y = x.m_v_y;
+          m_map_pending.clear();
+          samples_updated();
           break;
 
         default:
@@ -112,8 +135,32 @@ namespace tubex
 
     const map<double,double>& Trajectory::sampled_map() const
     {
+      merge_pending();
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
-      return m_map_values;
+
+      if(!m_map_view_updated)
+      {
+        m_map_view.clear();
+        for(size_t k = 0 ; k < m_v_t.size() ; k++)
+          m_map_view.emplace_hint(m_map_view.end(), m_v_t[k], m_v_y[k]);
+        m_map_view_updated = true;
+      }
+
+      return m_map_view;
+    }
+
+    const vector<double>& Trajectory::sampled_times() const
+    {
+      merge_pending();
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+      return m_v_t;
+    }
+
+    const vector<double>& Trajectory::sampled_values() const
+    {
+      merge_pending();
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+      return m_v_y;
     }
 
     const TFunction* Trajectory::tfunction() const
@@ -129,30 +176,26 @@ namespace tubex
 
     double Trajectory::operator()(double t) const
     {
+      merge_pending();
       assert(tdomain().contains(t));
 
       switch(m_traj_def_type)
       {
         case TrajDefnType::ANALYTIC_FNC:
-          return m_function->eval(t).mid(); // /!\ an approximation is made here
+          return m_function->eval_point(t); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          if(m_map_values.find(t) != m_map_values.end()) // key exists
-            return m_map_values.at(t);
-            // todo: optimize this to avoid double reading of the map?
+        {
+          size_t k = sample_index(t);
 
-          else
-          {
-            typename map<double,double>::const_iterator it_lower, it_upper;
-            it_lower = m_map_values.lower_bound(t);
-            it_upper = it_lower;
-            it_lower--;
-
-            // Linear interpolation
-            return it_lower->second +
-                   (t - it_lower->first) * (it_upper->second - it_lower->second) /
-                   (it_upper->first - it_lower->first);
-          }
+          if(m_v_t[k] == t) // key exists
+            return m_v_y[k];
+
+          else // linear interpolation
+            return m_v_y[k-1] +
+                   (t - m_v_t[k-1]) * (m_v_y[k] - m_v_y[k-1]) /
+                   (m_v_t[k] - m_v_t[k-1]);
+        }
 
         default:
           assert(false && "unhandled case");
@@ -162,6 +205,7 @@ namespace tubex
 
     const Interval Trajectory::operator()(const Interval& t) const
     {
+      merge_pending();
       assert(tdomain().is_superset(t));
 
       if(m_tdomain == t)
@@ -176,13 +220,16 @@ namespace tubex
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
+        {
           eval |= (*this)(t.lb());
           eval |= (*this)(t.ub());
 
-          for(map<double,double>::const_iterator it = m_map_values.lower_bound(t.lb()) ;
-              it != m_map_values.upper_bound(t.ub()) ; it++)
-            eval |= it->second;
+          size_t k0 = sample_index(t.lb()), k1 = sample_index(t.ub());
+          if(k1 < m_v_t.size() && m_v_t[k1] == t.ub())
+            k1++;
+          eval |= sampled_hull(k0, k1);
           break;
+        }
 
         default:
           assert(false && "unhandled case");
@@ -191,15 +238,41 @@ namespace tubex
       return eval;
     }
     
+    const vector<double> Trajectory::sample_values(const vector<double>& v_t) const
+    {
+      vector<double> v_y;
+
+      switch(m_traj_def_type)
+      {
+        case TrajDefnType::ANALYTIC_FNC:
+          for(size_t j = 0 ; j < v_t.size() ; j++)
+            assert(tdomain().contains(v_t[j]));
+          m_function->eval_points(v_t, v_y);
+          break;
+
+        case TrajDefnType::MAP_OF_VALUES:
+          v_y.reserve(v_t.size());
+          for(size_t j = 0 ; j < v_t.size() ; j++)
+            v_y.push_back((*this)(v_t[j]));
+          break;
+
+        default:
+          assert(false && "unhandled case");
+      }
+
+      return v_y;
+    }
+    
     double Trajectory::first_value() const
     {
+      merge_pending();
       switch(m_traj_def_type)
       {
         case TrajDefnType::ANALYTIC_FNC:
-          return m_function->eval(m_tdomain.lb()).mid(); // /!\ an approximation is made here
+          return (*this)(m_tdomain.lb()); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.begin()->second;
+          return m_v_y.front();
 
         default:
           assert(false && "unhandled case");
@@ -209,13 +282,14 @@ namespace tubex
 
     double Trajectory::last_value() const
     {
+      merge_pending();
       switch(m_traj_def_type)
       {
         case TrajDefnType::ANALYTIC_FNC:
-          return m_function->eval(m_tdomain.ub()).mid(); // /!\ an approximation is made here
+          return (*this)(m_tdomain.ub()); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.rbegin()->second;
+          return m_v_y.back();
 
         default:
           assert(false && "unhandled case");
@@ -227,13 +301,14 @@ namespace tubex
 
     bool Trajectory::not_defined() const
     {
+      merge_pending();
       switch(m_traj_def_type)
       {
         case TrajDefnType::ANALYTIC_FNC:
           return m_function == NULL;
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.empty();
+          return m_v_t.empty();
 
         default:
           assert(false && "unhandled case");
@@ -251,13 +326,16 @@ namespace tubex
         if(m_tdomain != x.tdomain() || m_codomain != x.codomain())
           return false;
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = m_map_values.begin() ; it_map != m_map_values.end() ; it_map++)
+        merge_pending();
+        x.merge_pending();
+        for(size_t k = 0 ; k < m_v_t.size() ; k++)
         {
-          if(x.sampled_map().find(it_map->first) == x.sampled_map().end())
+          size_t i = x.sample_index(m_v_t[k]);
+
+          if(i == x.m_v_t.size() || x.m_v_t[i] != m_v_t[k])
             return false;
 
-          if(it_map->second != x.sampled_map().at(it_map->first))
+          if(m_v_y[k] != x.m_v_y[i])
             return false;
         }
 
@@ -284,11 +362,34 @@ namespace tubex
       
       m_tdomain |= t;
 
-      bool update_codomain = m_map_values.find(t) != m_map_values.end() // key already exists
-            && m_codomain.contains(m_map_values.at(t)); // and new value inside codomain hull
+      // Values appended in time order are simply pushed back, other new
+      // keys are buffered and merged on the next access (see merge_pending())
+      size_t k = lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+      double *prev_y = NULL; // previous value at t, if the key already exists
+
+      if(k == m_v_t.size())
+      {
+        m_v_t.push_back(t);
+        m_v_y.push_back(y);
+      }
+
+      else if(m_v_t[k] == t)
+        prev_y = &m_v_y[k];
 
-      m_map_values.erase(t);
-      m_map_values.emplace(t, y);
+      else
+      {
+        pair<map<double,double>::iterator,bool> it = m_map_pending.emplace(t, y);
+        if(!it.second)
+          prev_y = &it.first->second;
+      }
+
+      bool update_codomain = prev_y != NULL // key already exists
+            && m_codomain.contains(*prev_y); // and new value inside codomain hull
+
+      if(prev_y != NULL)
+        *prev_y = y;
+
+      samples_updated();
 
       if(update_codomain) // the new codomain may be a subset of the old one
         compute_codomain();
@@ -299,6 +400,7 @@ namespace tubex
 
     Trajectory& Trajectory::truncate_tdomain(const Interval& t)
     {
+      merge_pending();
       assert(valid_tdomain(t));
       assert(tdomain().is_superset(t));
 
@@ -307,15 +409,29 @@ namespace tubex
         double y_lb = (*this)(t.lb());
         double y_ub = (*this)(t.ub());
 
-        map<double,double>::iterator it = m_map_values.begin();
-        while(it != m_map_values.end())
+        size_t k_lb = sample_index(t.lb()), k_ub = sample_index(t.ub());
+        if(k_ub < m_v_t.size() && m_v_t[k_ub] == t.ub())
+          k_ub++;
+
+        m_v_t = vector<double>(m_v_t.begin() + k_lb, m_v_t.begin() + k_ub);
+        m_v_y = vector<double>(m_v_y.begin() + k_lb, m_v_y.begin() + k_ub);
+
+        // Clean truncation
+        if(m_v_t.empty() || m_v_t.front() != t.lb())
+        {
+          m_v_t.insert(m_v_t.begin(), t.lb());
+          m_v_y.insert(m_v_y.begin(), y_lb);
+        }
+        m_v_y.front() = y_lb;
+
+        if(m_v_t.back() != t.ub())
         {
-          if(!t.contains(it->first)) it = m_map_values.erase(it);
-          else ++it;
+          m_v_t.push_back(t.ub());
+          m_v_y.push_back(y_ub);
         }
+        m_v_y.back() = y_ub;
 
-        m_map_values[t.lb()] = y_lb; // clean truncation
-        m_map_values[t.ub()] = y_ub;
+        samples_updated();
       }
 
       m_tdomain &= t;
@@ -325,13 +441,12 @@ namespace tubex
       
     Trajectory& Trajectory::shift_tdomain(double shift_ref)
     {
+      merge_pending();
       if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
       {
-        map<double,double> map_temp = m_map_values;
-        m_map_values.clear();
-
-        for(map<double,double>::iterator it = map_temp.begin() ; it != map_temp.end() ; it++)
-          m_map_values.emplace(it->first + shift_ref, it->second);
+        for(auto& t : m_v_t)
+          t += shift_ref;
+        samples_updated();
       }
 
       m_tdomain += shift_ref;
@@ -343,55 +458,31 @@ namespace tubex
     {
       assert(dt > 0.);
 
-      map<double,double> new_map;
-      
-      if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
-
-      double t;
-      for(t = m_tdomain.lb() ; t < m_tdomain.ub() ; t+=dt)
-        if(new_map.find(t) == new_map.end()) // if key does not exist already
-          new_map[t] = (*this)(t); // evaluation/interpolation
-      new_map[m_tdomain.ub()] = (*this)(m_tdomain.ub());
-
-      if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
-      {
-        m_traj_def_type = TrajDefnType::MAP_OF_VALUES;
-        delete m_function;
-      }
+      vector<double> v_t;
+      for(double t = m_tdomain.lb() ; t < m_tdomain.ub() ; t+=dt)
+        v_t.push_back(t);
+      v_t.push_back(m_tdomain.ub());
 
-      m_map_values = new_map;
+      merge_samples(v_t);
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
     
     Trajectory& Trajectory::sample(const Trajectory& x)
     {
+      merge_pending();
       assert(tdomain() == x.tdomain());
       assert(x.m_traj_def_type == TrajDefnType::MAP_OF_VALUES && "trajectory x has to be sampled");
       
-      map<double,double> new_map;
-
-      if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
-
-      for(auto const& it : x.sampled_map())
-        if(new_map.find(it.first) == new_map.end()) // if key does not exist already
-          new_map[it.first] = (*this)(it.first); // evaluation/interpolation
-
-      if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
-      {
-        m_traj_def_type = TrajDefnType::MAP_OF_VALUES;
-        delete m_function;
-      }
-
-      m_map_values = new_map;
+      x.merge_pending();
+      merge_samples(x.m_v_t);
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
     
     Trajectory& Trajectory::make_continuous()
     {
+      merge_pending();
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES
         && "not usable for trajectories defined by TFunction");
 
@@ -399,24 +490,20 @@ namespace tubex
       m_codomain = Interval::EMPTY_SET;
 
       double prev_value = 0., value_mod = 0.;
-      map<double,double> m_continuous_values(m_map_values);
 
-      for(const auto& it : m_map_values)
+      for(auto& y : m_v_y)
       {
-        if(!m_continuous_values.empty())
-        {
-          if(prev_value - it.second > periodicity.diam()*0.9)
-            value_mod += periodicity.diam();
-          else if(prev_value - it.second < -periodicity.diam()*0.9)
-            value_mod -= periodicity.diam();
-        }
-
-        prev_value = it.second;
-        m_continuous_values[it.first] += value_mod;
-        m_codomain |= m_continuous_values[it.first];
+        if(prev_value - y > periodicity.diam()*0.9)
+          value_mod += periodicity.diam();
+        else if(prev_value - y < -periodicity.diam()*0.9)
+          value_mod -= periodicity.diam();
+
+        prev_value = y;
+        y += value_mod;
+        m_codomain |= y;
       }
 
-      m_map_values = m_continuous_values;
+      samples_updated();
       return *this;
     }
 
@@ -424,21 +511,22 @@ namespace tubex
     
     const Trajectory Trajectory::primitive(double c) const
     {
+      merge_pending();
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES
         && "integration timestep requested for trajectories defined by TFunction");
       
       double val;
       Trajectory x;
 
-      for(map<double,double>::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
+      for(size_t k = 0 ; k < m_v_t.size() ; k++)
       {
-        if(it == m_map_values.begin())
+        if(k == 0)
           val = c;
 
         else
-          val += (prev(it)->second + it->second) * (it->first - prev(it)->first) / 2.;
+          val += (m_v_y[k-1] + m_v_y[k]) * (m_v_t[k] - m_v_t[k-1]) / 2.;
 
-        x.set(val, it->first);
+        x.set(val, m_v_t[k]);
       }
 
       return x;
@@ -470,6 +558,7 @@ namespace tubex
 
     const Trajectory Trajectory::diff() const
     {
+      merge_pending();
       Trajectory d;
 
       switch(m_traj_def_type)
@@ -479,10 +568,10 @@ namespace tubex
           break;
 
         case TrajDefnType::MAP_OF_VALUES: // finite difference computation
-          assert(m_map_values.size() > 1);
+          assert(m_v_t.size() > 1);
           
-          for(map<double,double>::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
-            d.set(finite_diff(it->first), it->first);
+          for(size_t k = 0 ; k < m_v_t.size() ; k++)
+            d.set(finite_diff(m_v_t[k]), m_v_t[k]);
 
           assert(d.tdomain() == tdomain());
           break;
@@ -496,37 +585,23 @@ namespace tubex
 
     double Trajectory::finite_diff(double t) const
     {
+      merge_pending();
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
-      assert(m_map_values.find(t) != m_map_values.end()); // key exists
-      assert(m_map_values.size() > 2);
+      assert(m_v_t.size() > 2);
 
-      double h = next(m_map_values.begin())->first - m_map_values.begin()->first;
+      size_t k = sample_index(t);
+      assert(k < m_v_t.size() && m_v_t[k] == t); // key exists
 
-      vector<double> fwd;
-      map<double,double>::const_iterator it_fwd = m_map_values.find(t);
-      double x = it_fwd->second;
+      double h = m_v_t[1] - m_v_t[0];
+      double x = m_v_y[k];
 
-      it_fwd++;
-      while(fwd.size() < 4 && it_fwd != m_map_values.end())
-      {
-        fwd.push_back(it_fwd->second);
-        it_fwd++;
-      }
+      vector<double> fwd;
+      for(size_t i = k+1 ; fwd.size() < 4 && i < m_v_y.size() ; i++)
+        fwd.push_back(m_v_y[i]);
 
       vector<double> bwd;
-      map<double,double>::const_iterator it_bwd = m_map_values.find(t);
-
-      if(it_bwd != m_map_values.begin())
-      {
-        it_bwd--;
-        while(bwd.size() < 4)
-        {
-          bwd.push_back(it_bwd->second);
-          if(it_bwd == m_map_values.begin())
-            break;
-          it_bwd--;
-        }
-      }
+      for(size_t i = k ; bwd.size() < 4 && i > 0 ; i--)
+        bwd.push_back(m_v_y[i-1]);
 
       if(fwd.size() == bwd.size()) // central finite difference
         switch(fwd.size())
@@ -590,16 +665,17 @@ namespace tubex
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          if(x.m_map_values.size() < 10)
+          x.merge_pending();
+          if(x.m_v_t.size() < 10)
           {
-            str << ", " << x.m_map_values.size() << " pts: { ";
-            for(map<double,double>::const_iterator it = x.m_map_values.begin() ; it != x.m_map_values.end() ; it++)
-              str << "(" << it->first << "," << it->second << ") ";
+            str << ", " << x.m_v_t.size() << " pts: { ";
+            for(size_t k = 0 ; k < x.m_v_t.size() ; k++)
+              str << "(" << x.m_v_t[k] << "," << x.m_v_y[k] << ") ";
             str << "} ";
           }
 
           else
-            str << ", " << x.m_map_values.size() << " points";
+            str << ", " << x.m_v_t.size() << " points";
 
           break;
 
@@ -621,6 +697,7 @@ namespace tubex
 
     void Trajectory::compute_codomain()
     {
+      merge_pending();
       switch(m_traj_def_type)
       {
         case TrajDefnType::ANALYTIC_FNC:
@@ -629,12 +706,171 @@ namespace tubex
 
         case TrajDefnType::MAP_OF_VALUES:
           m_codomain = Interval::EMPTY_SET;
-          for(map<double,double>::iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
-            m_codomain |= it->second;
+          for(size_t k = 0 ; k < m_v_y.size() ; k++)
+            m_codomain |= m_v_y[k];
           break;
 
         default:
           assert(false && "unhandled case");
       }
     }
+
+    size_t Trajectory::sample_index(double t) const
+    {
+      merge_pending();
+      const size_t n = m_v_t.size();
+      if(n == 0 || t <= m_v_t.front())
+        return 0;
+      if(t > m_v_t.back())
+        return n;
+
+      // Guess by linear interpolation (exact for a uniform sampling),
+      // then exponential search around the guess: m_v_t[lb] < t <= m_v_t[ub]
+
+        size_t k = std::min(n-1,
+          (size_t)((t - m_v_t.front()) / (m_v_t.back() - m_v_t.front()) * (n-1)));
+        size_t lb, ub, step = 1;
+
+        if(m_v_t[k] < t)
+        {
+          lb = k; ub = std::min(n-1, k+1);
+          while(m_v_t[ub] < t)
+          {
+            lb = ub; step *= 2;
+            ub = std::min(n-1, ub+step);
+          }
+        }
+
+        else
+        {
+          ub = k; lb = k > step ? k-step : 0;
+          while(m_v_t[lb] >= t)
+          {
+            ub = lb; step *= 2;
+            lb = lb > step ? lb-step : 0;
+          }
+        }
+
+      return lower_bound(m_v_t.begin() + lb, m_v_t.begin() + ub + 1, t) - m_v_t.begin();
+    }
+
+    void Trajectory::merge_samples(const vector<double>& v_t)
+    {
+      merge_pending();
+      vector<double> v_y = sample_values(v_t); // evaluation/interpolation
+      vector<double> v_merged_t, v_merged_y;
+      v_merged_t.reserve(m_v_t.size() + v_t.size());
+      v_merged_y.reserve(m_v_t.size() + v_t.size());
+
+      if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
+      {
+        m_traj_def_type = TrajDefnType::MAP_OF_VALUES;
+        delete m_function;
+        m_function = NULL;
+        m_v_t.clear(); m_v_y.clear();
+      }
+
+      // Existing samples are kept in case of identical keys
+
+        size_t i = 0, j = 0;
+        while(i < m_v_t.size() || j < v_t.size())
+        {
+          if(j == v_t.size() || (i < m_v_t.size() && m_v_t[i] <= v_t[j]))
+          {
+            if(j < v_t.size() && m_v_t[i] == v_t[j])
+              j++;
+            v_merged_t.push_back(m_v_t[i]);
+            v_merged_y.push_back(m_v_y[i]);
+            i++;
+          }
+
+          else
+          {
+            v_merged_t.push_back(v_t[j]);
+            v_merged_y.push_back(v_y[j]);
+            j++;
+          }
+        }
+
+      m_v_t.swap(v_merged_t);
+      m_v_y.swap(v_merged_y);
+      samples_updated();
+    }
+
+    const Interval Trajectory::sampled_hull(size_t k0, size_t k1) const
+    {
+      merge_pending();
+      assert(k0 <= k1 && k1 <= m_v_y.size());
+
+      Interval hull = Interval::EMPTY_SET;
+
+      if(k1 - k0 < 64) // small ranges are not worth the tree
+      {
+        for(size_t k = k0 ; k < k1 ; k++)
+          hull |= m_v_y[k];
+        return hull;
+      }
+
+      const size_t n = m_v_y.size();
+
+      if(m_v_hulls.empty())
+      {
+        // Bottom-up segment tree: the leaves are stored from index n,
+        // the node i is the hull of the nodes 2i and 2i+1
+
+          m_v_hulls.resize(2*n);
+          for(size_t k = 0 ; k < n ; k++)
+            m_v_hulls[n+k] = Interval(m_v_y[k]);
+          for(size_t i = n-1 ; i > 0 ; i--)
+            m_v_hulls[i] = m_v_hulls[2*i] | m_v_hulls[2*i+1];
+      }
+
+      for(k0 += n, k1 += n ; k0 < k1 ; k0 /= 2, k1 /= 2)
+      {
+        if(k0 & 1) hull |= m_v_hulls[k0++];
+        if(k1 & 1) hull |= m_v_hulls[--k1];
+      }
+
+      return hull;
+    }
+
+    void Trajectory::merge_pending() const
+    {
+      if(m_map_pending.empty())
+        return;
+
+      // One linear merge of the buffered keys (sorted by the map) into the arrays
+
+      vector<double> v_t, v_y;
+      v_t.reserve(m_v_t.size() + m_map_pending.size());
+      v_y.reserve(m_v_t.size() + m_map_pending.size());
+
+      size_t k = 0;
+      for(const auto& it : m_map_pending)
+      {
+        for( ; k < m_v_t.size() && m_v_t[k] < it.first ; k++)
+        {
+          v_t.push_back(m_v_t[k]);
+          v_y.push_back(m_v_y[k]);
+        }
+
+        assert((k == m_v_t.size() || m_v_t[k] != it.first) && "buffered keys are new keys");
+        v_t.push_back(it.first);
+        v_y.push_back(it.second);
+      }
+
+      v_t.insert(v_t.end(), m_v_t.begin() + k, m_v_t.end());
+      v_y.insert(v_y.end(), m_v_y.begin() + k, m_v_y.end());
+
+      m_v_t.swap(v_t);
+      m_v_y.swap(v_y);
+      m_map_pending.clear();
+    }
+
+    void Trajectory::samples_updated()
+    {
+      m_map_view_updated = false;
+      m_map_view.clear();
+      m_v_hulls.clear();
+    }
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #define __TUBEX_TRAJECTORY_H__
 
 #include <map>
+#include <vector>
 #include "tubex_DynamicalItem.h"
 #include "tubex_TFunction.h"
 #include "tubex_traj_arithmetic.h"
@@ -29,6 +30,10 @@ namespace tubex
    * \brief One dimensional trajectory \f$x(\cdot)\f$, defined as a temporal map of values
    *
    * \note Use TrajectoryVector for the multi-dimensional case
+   * \note The const methods reading the samples are not thread-safe: they may
+   *       merge the samples buffered by set() (see sampled_times()), or build
+   *       internal caches (see sampled_map()). Concurrent calls on a same
+   *       trajectory have to be synchronized by the caller.
    */
   class Trajectory : public DynamicalItem
   {
@@ -69,6 +74,14 @@ namespace tubex
        */
       explicit Trajectory(const std::map<double,double>& m_map_values);
 
+      /**
+       * \brief Creates a scalar trajectory \f$x(\cdot)\f$ from sampled values
+       *
+       * \param v_t the temporal keys, in strictly increasing order
+       * \param v_y the values: \f$x(t_k)=y_k\f$
+       */
+      Trajectory(const std::vector<double>& v_t, const std::vector<double>& v_y);
+
       /**
        * \brief Creates a copy of a scalar trajectory \f$x(\cdot)\f$
        *
@@ -117,10 +130,28 @@ namespace tubex
       /**
        * \brief Returns the map of values, if the object is defined as a map
        *
+       * \note The values are stored in flat arrays (see sampled_times() and
+       *       sampled_values()): this map is a view built on demand, and kept
+       *       until the next update of the trajectory.
+       *
        * \return a map<t,y> of values, or an empty map
        */
       const std::map<double,double>& sampled_map() const;
 
+      /**
+       * \brief Returns the temporal keys, if the object is defined as a map
+       *
+       * \return the times of the samples, in increasing order
+       */
+      const std::vector<double>& sampled_times() const;
+
+      /**
+       * \brief Returns the sampled values, if the object is defined as a map
+       *
+       * \return the values of the samples, related to sampled_times()
+       */
+      const std::vector<double>& sampled_values() const;
+
       /**
        * \brief Returns the temporal function, if the object is an analytic trajectory
        *
@@ -156,6 +187,19 @@ namespace tubex
        */
       const ibex::Interval operator()(const ibex::Interval& t) const;
 
+      /**
+       * \brief Returns the evaluations of this trajectory at several times
+       *
+       * \note In case of a definition from an analytic function, the values are
+       *       computed at once with floating-point arithmetic (approximation,
+       *       see operator()(double)), which is much faster than successive
+       *       interval evaluations.
+       *
+       * \param v_t the temporal keys (must belong to the trajectory's tdomain)
+       * \return the real values \f$x(t_j)\f$
+       */
+      const std::vector<double> sample_values(const std::vector<double>& v_t) const;
+
       /**
        * \brief Returns the value \f$x(t_0)\f$
        *
@@ -206,6 +250,8 @@ namespace tubex
        * \brief Sets a value \f$y\f$ at \f$t\f$: \f$x(t)=y\f$
        *
        * \note The trajectory must not be defined from an analytic function
+       * \note Values set in increasing time order are appended in constant time.
+       *       Other new keys are buffered, and merged at once on the next access.
        *
        * \param y local value of the trajectory
        * \param t the temporal key (double, must belong to the trajectory's tdomain)
@@ -430,6 +476,59 @@ namespace tubex
        */
       void compute_codomain();
 
+      /**
+       * \brief Returns the index of the first sample whose time is not lower than \f$t\f$
+       *
+       * The index is first guessed by interpolation (exact for uniform
+       * samplings), then refined by a local search.
+       *
+       * \param t the temporal key
+       * \return the index of the sample, or the number of samples if \f$t\f$
+       *         is greater than the last temporal key
+       */
+      size_t sample_index(double t) const;
+
+      /**
+       * \brief Adds samples at some times, keeping the existing ones
+       *
+       * \note If the trajectory is defined as an analytic function, then the object is
+       *       transformed into a map of values and the TFunction object is deleted.
+       *
+       * \param v_t the new temporal keys, in increasing order
+       */
+      void merge_samples(const std::vector<double>& v_t);
+
+      /**
+       * \brief Returns the hull of the sampled values of indices \f$k_0\leqslant k<k_1\f$
+       *
+       * For large ranges, a segment tree of the hulls of the values is built
+       * on the first call (\f$\mathcal{O}(N)\f$), and then queried in
+       * \f$\mathcal{O}(\log N)\f$. This tree is cleared by any update of
+       * the samples.
+       *
+       * \note The tree being built on demand, concurrent calls on a same
+       *       trajectory are not thread-safe
+       *
+       * \param k0 first index
+       * \param k1 index after the last one
+       * \return the hull of the values
+       */
+      const ibex::Interval sampled_hull(size_t k0, size_t k1) const;
+
+      /**
+       * \brief Merges the samples buffered by set() into the sorted arrays
+       *
+       * \note Called by the methods reading the samples: a sequence of set() calls
+       *       in any time order costs \f$\mathcal{O}(N\log N)\f$ instead of
+       *       \f$\mathcal{O}(N^2)\f$ with insertions in the arrays.
+       */
+      void merge_pending() const;
+
+      /**
+       * \brief Clears the data derived from the samples, after an update
+       */
+      void samples_updated();
+
       // Class variables:
 
         ibex::Interval m_tdomain = ibex::Interval::EMPTY_SET; //!< temporal domain \f$[t_0,t_f]\f$ of the trajectory
@@ -441,9 +540,15 @@ namespace tubex
         //union
         //{
           TFunction *m_function = NULL; //!< optional pointer to the analytic expression of this trajectory
-          std::map<double,double> m_map_values; //!< optional map of values <t,y>: \f$x(t)=y\f$
+          mutable std::vector<double> m_v_t; //!< optional temporal keys of the values, in increasing order
+          mutable std::vector<double> m_v_y; //!< optional values: \f$x(t_k)=y_k\f$
         //};
 
+        mutable std::map<double,double> m_map_pending; //!< new keys set out of time order, not yet merged into m_v_t and m_v_y
+        mutable std::map<double,double> m_map_view; //!< map of values, built by sampled_map()
+        mutable bool m_map_view_updated = false; //!< true if m_map_view matches the samples
+        mutable std::vector<ibex::Interval> m_v_hulls; //!< segment tree of the hulls of the values, built by sampled_hull()
+
       friend void deserialize_Trajectory(std::ifstream& bin_file, Trajectory *&traj);
       friend void deserialize_TrajectoryVector(std::ifstream& bin_file, TrajectoryVector *&traj);
   };
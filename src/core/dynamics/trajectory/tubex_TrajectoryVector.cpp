@@ -9,7 +9,9 @@
  */
 
 #include <sstream>
+#include <algorithm>
 #include "tubex_TrajectoryVector.h"
+#include "tubex_Exception.h"
 
 using namespace std;
 using namespace ibex;
@@ -59,8 +61,6 @@ namespace tubex
              || size() == it_map->second.size()) && "vectors of map_values of different dimensions");
         set(it_map->second, it_map->first);
       }
-
-      // todo: optimize this by building Trajectory objects here directly?
     }
 
     TrajectoryVector::TrajectoryVector(const vector<map<double,double> >& v_map_values)
@@ -71,6 +71,18 @@ namespace tubex
         (*this)[i] = Trajectory(v_map_values[i]);
     }
 
+    TrajectoryVector::TrajectoryVector(int n, const vector<double>& v_t, const vector<double>& v_values)
+      : TrajectoryVector(n)
+    {
+      assert(v_values.size() == v_t.size()*n);
+      for(size_t k = 1 ; k < v_t.size() ; k++)
+        assert(v_t[k-1] < v_t[k] && "temporal keys must be strictly increasing");
+
+      m_shared_time_axis = true;
+      m_v_t = v_t;
+      m_v_values = v_values;
+    }
+
     TrajectoryVector::TrajectoryVector(int n, const Trajectory& x)
       : TrajectoryVector(n)
     {
@@ -108,7 +120,11 @@ namespace tubex
       
       m_v_trajs = new Trajectory[m_n];
       for(int i = 0 ; i < size() ; i++)
-        (*this)[i] = x[i]; // copy of each component
+        m_v_trajs[i] = x.m_v_trajs[i]; // copy of each component
+
+      m_shared_time_axis = x.m_shared_time_axis;
+      m_v_t = x.m_v_t;
+      m_v_values = x.m_v_values;
 
       return *this;
     }
@@ -125,6 +141,8 @@ namespace tubex
       if(n == size())
         return;
 
+      if(m_shared_time_axis)
+        throw Exception(__func__, "not available on a shared time axis, see unshare_time_axis()");
       Trajectory *new_vec = new Trajectory[n];
 
       int i = 0;
@@ -146,6 +164,17 @@ namespace tubex
       assert(start_index >= 0);
       assert(end_index < size());
       assert(start_index <= end_index);
+
+      if(m_shared_time_axis) // columns extracted from the matrix
+      {
+        const int n = end_index - start_index + 1;
+        vector<double> v_values(m_v_t.size()*n);
+        for(size_t k = 0 ; k < m_v_t.size() ; k++)
+          for(int i = 0 ; i < n ; i++)
+            v_values[k*n+i] = m_v_values[k*size()+start_index+i];
+        return TrajectoryVector(n, m_v_t, v_values);
+      }
+
       TrajectoryVector subvec(end_index - start_index + 1);
       for(int i = 0 ; i < subvec.size() ; i++)
         subvec[i] = (*this)[i + start_index];
@@ -156,14 +185,106 @@ namespace tubex
     {
       assert(start_index >= 0);
       assert(start_index + subvec.size() <= size());
+
+      if(m_shared_time_axis)
+      {
+        if(!subvec.m_shared_time_axis || subvec.m_v_t != m_v_t)
+          throw Exception(__func__, "subvec must be sampled on the same shared time axis");
+
+        for(size_t k = 0 ; k < m_v_t.size() ; k++)
+          for(int i = 0 ; i < subvec.size() ; i++)
+            m_v_values[k*size()+start_index+i] = subvec.m_v_values[k*subvec.size()+i];
+        return;
+      }
+
       for(int i = 0 ; i < subvec.size() ; i++)
         (*this)[i + start_index] = subvec[i];
     }
 
+    TrajectoryVector& TrajectoryVector::share_time_axis()
+    {
+      if(m_shared_time_axis)
+        return *this;
+
+      assert(same_tdomain_forall_components());
+
+      // Union of the temporal keys
+
+        vector<double> v_t;
+        for(int i = 0 ; i < size() ; i++)
+        {
+          assert(m_v_trajs[i].definition_type() == TrajDefnType::MAP_OF_VALUES);
+          const vector<double>& v_ti = m_v_trajs[i].sampled_times();
+          vector<double> v_union;
+          v_union.reserve(v_t.size() + v_ti.size());
+          set_union(v_t.begin(), v_t.end(), v_ti.begin(), v_ti.end(), back_inserter(v_union));
+          v_t.swap(v_union);
+        }
+
+      m_v_values.resize(v_t.size()*size());
+      for(int i = 0 ; i < size() ; i++)
+      {
+        vector<double> v_yi = m_v_trajs[i].sample_values(v_t); // evaluation/interpolation
+        for(size_t k = 0 ; k < v_t.size() ; k++)
+          m_v_values[k*size()+i] = v_yi[k];
+        m_v_trajs[i] = Trajectory(); // only the matrix is kept
+      }
+
+      m_v_t.swap(v_t);
+      m_shared_time_axis = true;
+      return *this;
+    }
+
+    TrajectoryVector& TrajectoryVector::unshare_time_axis()
+    {
+      if(m_shared_time_axis)
+      {
+        for(int i = 0 ; i < size() ; i++)
+          m_v_trajs[i] = component(i);
+
+        m_shared_time_axis = false;
+        m_v_t = vector<double>(); // memory released
+        m_v_values = vector<double>();
+      }
+
+      return *this;
+    }
+
+    bool TrajectoryVector::time_axis_shared() const
+    {
+      return m_shared_time_axis;
+    }
+
+    const vector<double>& TrajectoryVector::sampled_times() const
+    {
+      assert(m_shared_time_axis);
+      return m_v_t;
+    }
+
+    const double* TrajectoryVector::sampled_row(size_t k) const
+    {
+      assert(m_shared_time_axis);
+      assert(k < m_v_t.size());
+      return &m_v_values[k*size()];
+    }
+
+    const vector<double> TrajectoryVector::sampled_column(int i) const
+    {
+      assert(m_shared_time_axis);
+      assert(i >= 0 && i < size());
+      vector<double> v_yi(m_v_t.size());
+      for(size_t k = 0 ; k < m_v_t.size() ; k++)
+        v_yi[k] = m_v_values[k*size()+i];
+      return v_yi;
+    }
+
     // Accessing values
 
     const Interval TrajectoryVector::tdomain() const
     {
+      if(m_shared_time_axis)
+        return m_v_t.empty() ? Interval::EMPTY_SET : Interval(m_v_t.front(), m_v_t.back());
+
       return (*this)[0].tdomain();
     }
 
@@ -175,21 +296,57 @@ namespace tubex
     Trajectory& TrajectoryVector::operator[](int index)
     {
       assert(index >= 0 && index < size());
-      return const_cast<Trajectory&>(static_cast<const TrajectoryVector&>(*this).operator[](index));
+      if(m_shared_time_axis)
+        throw Exception(__func__, "no Trajectory object on a shared time axis, see component() or unshare_time_axis()");
+      return m_v_trajs[index];
     }
 
     const Trajectory& TrajectoryVector::operator[](int index) const
     {
       assert(index >= 0 && index < size());
+      if(m_shared_time_axis)
+        throw Exception(__func__, "no Trajectory object on a shared time axis, see component() or unshare_time_axis()");
       return m_v_trajs[index];
     }
 
+    const Trajectory TrajectoryVector::component(int index) const
+    {
+      assert(index >= 0 && index < size());
+      if(!m_shared_time_axis)
+        return m_v_trajs[index];
+
+      if(m_v_t.empty())
+        return Trajectory();
+      return Trajectory(m_v_t, sampled_column(index));
+    }
+
     const Vector TrajectoryVector::operator()(double t) const
     {
       assert(tdomain().contains(t));
       Vector v(size());
-      for(int i = 0 ; i < size() ; i++)
-        v[i] = (*this)[i](t);
+
+      if(m_shared_time_axis) // one temporal search, then contiguous rows
+      {
+        size_t k = lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+        const double *row = &m_v_values[k*size()];
+
+        if(m_v_t[k] == t) // key exists
+          for(int i = 0 ; i < size() ; i++)
+            v[i] = row[i];
+
+        else // linear interpolation
+        {
+          const double *prev_row = row - size();
+          double a = (t - m_v_t[k-1]) / (m_v_t[k] - m_v_t[k-1]);
+          for(int i = 0 ; i < size() ; i++)
+            v[i] = prev_row[i] + a * (row[i] - prev_row[i]);
+        }
+      }
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = (*this)[i](t);
+
       return v;
     }
     
@@ -197,13 +354,53 @@ namespace tubex
     {
       assert(tdomain().is_superset(t));
       IntervalVector v(size());
-      for(int i = 0 ; i < size() ; i++)
-        v[i] = (*this)[i](t);
+
+      if(m_shared_time_axis) // bounds of t, then the rows strictly inside t
+      {
+        const Vector y_lb = (*this)(t.lb()), y_ub = (*this)(t.ub());
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = Interval(y_lb[i]) | y_ub[i];
+
+        size_t k0 = upper_bound(m_v_t.begin(), m_v_t.end(), t.lb()) - m_v_t.begin();
+        size_t k1 = lower_bound(m_v_t.begin(), m_v_t.end(), t.ub()) - m_v_t.begin();
+        for(size_t k = k0 ; k < k1 ; k++)
+          for(int i = 0 ; i < size() ; i++)
+            v[i] |= m_v_values[k*size()+i];
+      }
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = (*this)[i](t);
+
       return v;
     }
     
+    const vector<Vector> TrajectoryVector::sample_values(const vector<double>& v_t) const
+    {
+      if(m_shared_time_axis)
+      {
+        vector<Vector> v_y;
+        v_y.reserve(v_t.size());
+        for(size_t j = 0 ; j < v_t.size() ; j++)
+          v_y.push_back((*this)(v_t[j]));
+        return v_y;
+      }
+
+      vector<Vector> v_y(v_t.size(), Vector(size()));
+      for(int i = 0 ; i < size() ; i++)
+      {
+        vector<double> v_yi = (*this)[i].sample_values(v_t);
+        for(size_t j = 0 ; j < v_t.size() ; j++)
+          v_y[j][i] = v_yi[j];
+      }
+      return v_y;
+    }
+    
     const Vector TrajectoryVector::first_value() const
     {
+      if(m_shared_time_axis)
+        return (*this)(m_v_t.front());
+
       Vector v(size());
       for(int i = 0 ; i < size() ; i++)
         v[i] = (*this)[i].first_value();
@@ -212,6 +409,9 @@ namespace tubex
 
     const Vector TrajectoryVector::last_value() const
     {
+      if(m_shared_time_axis)
+        return (*this)(m_v_t.back());
+
       Vector v(size());
       for(int i = 0 ; i < size() ; i++)
         v[i] = (*this)[i].last_value();
@@ -222,6 +422,9 @@ namespace tubex
 
     bool TrajectoryVector::not_defined() const
     {
+      if(m_shared_time_axis)
+        return m_v_t.empty();
+
       for(int i = 0 ; i < size() ; i++)
         if((*this)[i].not_defined())
           return true;
@@ -232,20 +435,28 @@ namespace tubex
     {
       if(size() != x.size())
         return false;
+
+      if(m_shared_time_axis && x.m_shared_time_axis)
+        return m_v_t == x.m_v_t && m_v_values == x.m_v_values;
+
       for(int i = 0 ; i < size() ; i++)
-        if((*this)[i] != x[i])
+      {
+        if(!m_shared_time_axis && !x.m_shared_time_axis)
+        {
+          if((*this)[i] != x[i])
+            return false;
+        }
+
+        else if(component(i) != x.component(i))
           return false;
+      }
+
       return true;
     }
     
     bool TrajectoryVector::operator!=(const TrajectoryVector& x) const
     {
-      if(size() != x.size())
-        return true;
-      for(int i = 0 ; i < size() ; i++)
-        if((*this)[i] != x[i])
-          return true;
-      return false;
+      return !(*this == x);
     }
 
     // Setting values
@@ -259,14 +470,61 @@ namespace tubex
       }
 
       assert(size() == y.size());
-      for(int i = 0 ; i < size() ; i++)
-        (*this)[i].set(y[i], t);
+
+      if(m_shared_time_axis)
+      {
+        // Values appended in time order are simply pushed back
+        size_t k = lower_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin();
+
+        if(k == m_v_t.size() || m_v_t[k] != t)
+        {
+          m_v_t.insert(m_v_t.begin() + k, t);
+          m_v_values.insert(m_v_values.begin() + k*size(), size(), 0.);
+        }
+
+        for(int i = 0 ; i < size() ; i++)
+          m_v_values[k*size()+i] = y[i];
+      }
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          (*this)[i].set(y[i], t);
     }
 
     TrajectoryVector& TrajectoryVector::truncate_tdomain(const Interval& t)
     {
       assert(valid_tdomain(t));
       assert(tdomain().is_superset(t));
+
+      if(m_shared_time_axis) // values at the bounds of t, then the rows strictly inside t
+      {
+        const Vector y_lb = (*this)(t.lb()), y_ub = (*this)(t.ub());
+        size_t k0 = upper_bound(m_v_t.begin(), m_v_t.end(), t.lb()) - m_v_t.begin();
+        size_t k1 = lower_bound(m_v_t.begin(), m_v_t.end(), t.ub()) - m_v_t.begin();
+
+        vector<double> v_t, v_values;
+        v_t.reserve(k1 - k0 + 2);
+        v_values.reserve((k1 - k0 + 2)*size());
+
+        v_t.push_back(t.lb());
+        for(int i = 0 ; i < size() ; i++)
+          v_values.push_back(y_lb[i]);
+
+        v_t.insert(v_t.end(), m_v_t.begin() + k0, m_v_t.begin() + k1);
+        v_values.insert(v_values.end(), m_v_values.begin() + k0*size(), m_v_values.begin() + k1*size());
+
+        if(t.ub() != t.lb())
+        {
+          v_t.push_back(t.ub());
+          for(int i = 0 ; i < size() ; i++)
+            v_values.push_back(y_ub[i]);
+        }
+
+        m_v_t.swap(v_t);
+        m_v_values.swap(v_values);
+        return *this;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         if(!(*this)[i].not_defined())
           (*this)[i].truncate_tdomain(t);
@@ -275,6 +533,13 @@ namespace tubex
 
     TrajectoryVector& TrajectoryVector::shift_tdomain(double shift_ref)
     {
+      if(m_shared_time_axis)
+      {
+        for(auto& t : m_v_t)
+          t += shift_ref;
+        return *this;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].shift_tdomain(shift_ref);
       return *this;
@@ -282,6 +547,9 @@ namespace tubex
     
     bool TrajectoryVector::same_tdomain_forall_components() const
     {
+      if(m_shared_time_axis)
+        return true;
+
       for(int i = 1 ; i < size() ; i++)
         if((*this)[i].tdomain() != (*this)[0].tdomain())
           return false;
@@ -290,6 +558,17 @@ namespace tubex
 
     TrajectoryVector& TrajectoryVector::sample(double dt)
     {
+      if(m_shared_time_axis)
+      {
+        assert(dt > 0.);
+        vector<double> v_t;
+        for(double t = tdomain().lb() ; t < tdomain().ub() ; t+=dt)
+          v_t.push_back(t);
+        v_t.push_back(tdomain().ub());
+        merge_shared_samples(v_t);
+        return *this;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(dt);
       return *this;
@@ -297,6 +576,14 @@ namespace tubex
 
     TrajectoryVector& TrajectoryVector::sample(const Trajectory& x)
     {
+      if(m_shared_time_axis)
+      {
+        assert(tdomain() == x.tdomain());
+        assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES && "trajectory x has to be sampled");
+        merge_shared_samples(x.sampled_times());
+        return *this;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(x);
       return *this;
@@ -305,6 +592,25 @@ namespace tubex
     TrajectoryVector& TrajectoryVector::sample(const TrajectoryVector& x)
     {
       assert(size() == x.size());
+
+      if(m_shared_time_axis)
+      {
+        if(x.m_shared_time_axis)
+          merge_shared_samples(x.m_v_t);
+        else
+          for(int i = 0 ; i < size() ; i++)
+            sample(x[i]);
+        return *this;
+      }
+
+      if(x.m_shared_time_axis) // only the shared temporal keys are used
+      {
+        const Trajectory x_keys = x.component(0);
+        for(int i = 0 ; i < size() ; i++)
+          (*this)[i].sample(x_keys);
+        return *this;
+      }
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(x[i]);
       return *this;
@@ -318,7 +624,7 @@ namespace tubex
       TrajectoryVector x(size());
 
       for(int i = 0 ; i < size() ; i++)
-        x[i] = (*this)[i].primitive(c[i]);
+        x[i] = component(i).primitive(c[i]);
 
       return x;
     }
@@ -330,7 +636,7 @@ namespace tubex
       TrajectoryVector x(size());
 
       for(int i = 0 ; i < size() ; i++)
-        x[i] = (*this)[i].primitive(c[i], dt);
+        x[i] = component(i).primitive(c[i], dt);
 
       return x;
     }
@@ -340,7 +646,7 @@ namespace tubex
       TrajectoryVector x(size());
 
       for(int i = 0 ; i < size() ; i++)
-        x[i] = (*this)[i].diff();
+        x[i] = component(i).diff();
 
       return x;
     }
@@ -356,11 +662,41 @@ namespace tubex
 
   // Protected methods
 
+    void TrajectoryVector::merge_shared_samples(const vector<double>& v_t)
+    {
+      assert(m_shared_time_axis);
+
+      vector<double> v_union;
+      v_union.reserve(m_v_t.size() + v_t.size());
+      set_union(m_v_t.begin(), m_v_t.end(), v_t.begin(), v_t.end(), back_inserter(v_union));
+      if(v_union.size() == m_v_t.size()) // no new key
+        return;
+
+      vector<double> v_values(v_union.size()*size());
+      for(size_t k = 0 ; k < v_union.size() ; k++)
+      {
+        const Vector y = (*this)(v_union[k]); // evaluation/interpolation
+        for(int i = 0 ; i < size() ; i++)
+          v_values[k*size()+i] = y[i];
+      }
+
+      m_v_t.swap(v_union);
+      m_v_values.swap(v_values);
+    }
+
     const IntervalVector TrajectoryVector::codomain_box() const
     {
       IntervalVector box(size(), Interval::EMPTY_SET);
-      for(int i = 0 ; i < size() ; i++)
-        box[i] |= (*this)[i].codomain();
+
+      if(m_shared_time_axis)
+        for(size_t k = 0 ; k < m_v_t.size() ; k++)
+          for(int i = 0 ; i < size() ; i++)
+            box[i] |= m_v_values[k*size()+i];
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          box[i] |= (*this)[i].codomain();
+
       return box;
     }
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #define __TUBEX_TRAJECTORYVECTOR_H__
 
 #include <map>
+#include <vector>
 #include <initializer_list>
 #include "ibex_Vector.h"
 #include "ibex_Interval.h"
@@ -31,6 +32,13 @@ namespace tubex
    * \class TrajectoryVector
    * \brief n-dimensional trajectory \f$\mathbf{x}(\cdot)\f$, defined as a temporal map of vector values
    *
+   * The components are either stored as n independent Trajectory objects (by
+   * default), or sampled on a shared time axis: one array of times and one
+   * row-major matrix of values. The second storage is an explicit choice (see
+   * share_time_axis()), suited to vector values such as sensor logs. The
+   * components are then read with sampled_row() or sampled_column(), and not
+   * with operator[].
+   *
    * \note Use Trajectory for the one-dimensional case
    */
   class TrajectoryVector : public DynamicalItem
@@ -79,6 +87,16 @@ namespace tubex
        */
       explicit TrajectoryVector(const std::vector<std::map<double,double> >& v_map_values);
 
+      /**
+       * \brief Creates a n-dimensional trajectory \f$\mathbf{x}(\cdot)\f$ from values
+       *        sampled on a shared time axis (see share_time_axis())
+       *
+       * \param n dimension of this trajectory
+       * \param v_t the temporal keys, in strictly increasing order
+       * \param v_values the values, row-major: \f$x_i(t_k)\f$ is v_values[k*n+i]
+       */
+      TrajectoryVector(int n, const std::vector<double>& v_t, const std::vector<double>& v_values);
+
       /**
        * \brief Creates a n-dimensional trajectory \f$\mathbf{x}(\cdot)\f$ from a list of Trajectory objects
        *
@@ -155,6 +173,66 @@ namespace tubex
        */
       void put(int start_index, const TrajectoryVector& subvec);
 
+      /**
+       * \brief Stores the samples of the components on a shared time axis
+       *
+       * The components are sampled on the union of their temporal keys, and
+       * the values are stored in a single matrix, row by row. The vector
+       * evaluations are then made with one temporal search.
+       *
+       * \note The components must be sampled (no analytic definitions)
+       *       and share the same tdomain
+       * \note The components are no longer Trajectory objects: operator[],
+       *       resize() and the arithmetic operators throw an exception until
+       *       unshare_time_axis() is called.
+       *
+       * \return a reference to this trajectory
+       */
+      TrajectoryVector& share_time_axis();
+
+      /**
+       * \brief Stores the components as independent Trajectory objects
+       *
+       * \return a reference to this trajectory
+       */
+      TrajectoryVector& unshare_time_axis();
+
+      /**
+       * \brief Returns true if the samples are stored on a shared time axis
+       *
+       * \return true in case of a shared time axis
+       */
+      bool time_axis_shared() const;
+
+      /**
+       * \brief Returns the temporal keys of the shared time axis
+       *
+       * \note The samples must be stored on a shared time axis
+       *
+       * \return the times \f$t_k\f$, in increasing order
+       */
+      const std::vector<double>& sampled_times() const;
+
+      /**
+       * \brief Returns the values of all the components at a sampled time
+       *
+       * \note The samples must be stored on a shared time axis
+       *
+       * \param k the index of the sample, in sampled_times()
+       * \return a pointer to the n values \f$x_i(t_k)\f$ of the matrix
+       */
+      const double* sampled_row(size_t k) const;
+
+      /**
+       * \brief Returns the values of a component at all the sampled times
+       *
+       * \note The samples must be stored on a shared time axis
+       *
+       * \param i the index of the component
+       * \return the values \f$x_i(t_k)\f$, read from the matrix
+       */
+      const std::vector<double> sampled_column(int i) const;
+
       /// @}
       /// \name Accessing values
       /// @{
@@ -169,6 +247,8 @@ namespace tubex
       /**
        * \brief Returns the ith Trajectory of this TrajectoryVector
        *
+       * \note Not available on a shared time axis (see share_time_axis())
+       *
        * \param index the index of this ith component
        * \return a reference to the ith component
        */
@@ -177,11 +257,21 @@ namespace tubex
       /**
        * \brief Returns a const reference to the ith Trajectory of this TrajectoryVector
        *
+       * \note Not available on a shared time axis (see share_time_axis())
+       *
        * \param index the index of this ith component
        * \return a const reference to the ith component
        */
       const Trajectory& operator[](int index) const;
 
+      /**
+       * \brief Returns a copy of the ith component, whatever the storage
+       *
+       * \param index the index of this ith component
+       * \return the ith component, built from the matrix on a shared time axis
+       */
+      const Trajectory component(int index) const;
+
       /**
        * \brief Returns the evaluation of this trajectory at \f$t\f$
        *
@@ -203,6 +293,16 @@ namespace tubex
        */
       const ibex::IntervalVector operator()(const ibex::Interval& t) const;
 
+      /**
+       * \brief Returns the evaluations of this trajectory at several times
+       *
+       * \note See Trajectory::sample_values()
+       *
+       * \param v_t the temporal keys (must belong to the trajectory's tdomain)
+       * \return the real vector values \f$\mathbf{x}(t_j)\f$
+       */
+      const std::vector<ibex::Vector> sample_values(const std::vector<double>& v_t) const;
+
       /**
        * \brief Returns the value \f$\mathbf{x}(t_0)\f$
        *
@@ -252,6 +352,8 @@ namespace tubex
       /**
        * \brief Sets a value \f$\mathbf{y}\f$ at \f$t\f$: \f$\mathbf{x}(t)=\mathbf{y}\f$
        *
+       * \note On a shared time axis, the value is set as one row of the matrix
+       *
        * \param y local vector value of the trajectory
        * \param t the temporal key (double, must belong to the trajectory's tdomain)
        */
@@ -500,11 +602,23 @@ namespace tubex
        */
       const ibex::IntervalVector codomain_box() const;
 
+      /**
+       * \brief Adds temporal keys to the shared time axis, the values being
+       *        evaluated (interpolated) at these new keys
+       *
+       * \param v_t the temporal keys to be added, in increasing order
+       */
+      void merge_shared_samples(const std::vector<double>& v_t);
+
       // Class variables:
 
         int m_n = 0; //!< dimension of this trajectory
         Trajectory *m_v_trajs = NULL; //!< array of components (scalar trajectories)
 
+        bool m_shared_time_axis = false; //!< true if the samples are stored in m_v_t and m_v_values
+        std::vector<double> m_v_t; //!< shared temporal keys, in increasing order
+        std::vector<double> m_v_values; //!< values, row-major: \f$x_i(t_k)\f$ is m_v_values[k*n+i]
+
       friend void deserialize_TrajectoryVector(std::ifstream& bin_file, TrajectoryVector *&traj);
       friend class TubeVector; // for TubeVector::deserialize method
   };
@@ -22,8 +22,10 @@ namespace tubex
       assert(definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      for(auto& kv : m_map_values) \
-        m_map_values[kv.first] = kv.second f x; \
+      merge_pending(); \
+      for(auto& y : m_v_y) \
+        y = y f x; \
+      samples_updated(); \
       m_codomain.fdef(x); \
       return *this; \
     } \
@@ -38,11 +40,14 @@ namespace tubex
       if(definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x_sampled.sample(*this); \
       \
-      map<double,double> new_map; \
-      for(auto const& it : x_sampled.sampled_map()) \
-        new_map[it.first] = (*this)(it.first) f it.second; \
+      x_sampled.merge_pending(); \
+      vector<double> v_y = sample_values(x_sampled.m_v_t); \
+      for(size_t k = 0 ; k < v_y.size() ; k++) \
+        v_y[k] = v_y[k] f x_sampled.m_v_y[k]; \
       \
-      m_map_values = new_map; \
+      m_v_t = x_sampled.m_v_t; \
+      m_v_y = v_y; \
+      samples_updated(); \
       compute_codomain(); \
       return *this; \
     } \
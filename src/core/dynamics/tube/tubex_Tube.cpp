@@ -12,6 +12,7 @@
 #include "tubex_Exception.h"
 #include "tubex_CtcDeriv.h"
 #include "tubex_CtcEval.h"
+#include "tubex_Trail.h"
 #include "tubex_serialize_trajectories.h"
 #include "ibex_LargestFirst.h"
 #include "ibex_NoBisectableVariableException.h"
@@ -513,6 +514,12 @@ namespace tubex
         new_slice->m_input_gate = NULL;
         Slice::chain_slices(new_slice, next_slice);
         Slice::chain_slices(slice_to_be_sampled, new_slice);
+
+        // The new slice is followed as the sampled one, if involved in a network
+        new_slice->m_changed_tdomain = slice_to_be_sampled->m_changed_tdomain;
+        if(slice_to_be_sampled->m_trail != NULL)
+          slice_to_be_sampled->m_trail->attach(*new_slice);
+
         new_slice->set_input_gate(new_slice->codomain());
       }
     }
@@ -697,20 +704,54 @@ namespace tubex
       if(m_synthesis_tree != NULL) // fast inversion
         return m_synthesis_tree->invert(y, search_tdomain);
 
-      // todo: optimize this:
-      Tube v(*this); // same slicing
-      v.set(Interval::ALL_REALS); 
-      return invert(y, v, search_tdomain);
+      Interval invert = Interval::EMPTY_SET;
+      Interval intersection = search_tdomain & tdomain();
+      if(intersection.is_empty())
+        return Interval::EMPTY_SET;
+
+      const Slice *s_x = slice(intersection.lb());
+      while(s_x != NULL && s_x->tdomain().lb() < intersection.ub())
+      {
+        invert |= s_x->invert(y, intersection);
+        s_x = s_x->next_slice();
+      }
+
+      return invert;
     }
 
     void Tube::invert(const Interval& y, vector<Interval> &v_t, const Interval& search_tdomain) const
     {
-      // todo: optimize this:
-      // todo: fast inversion with binary tree considering derivative information
-      Tube v(*this); // same slicing
-      v.set(Interval::ALL_REALS);
       v_t.clear();
-      invert(y, v_t, v, search_tdomain);
+
+      if(m_synthesis_tree != NULL) // fast inversion, pruning the parts of the tube not intersecting [y]
+      {
+        m_synthesis_tree->invert(y, v_t, search_tdomain);
+        return;
+      }
+
+      Interval invert = Interval::EMPTY_SET;
+      Interval intersection = search_tdomain & tdomain();
+      if(intersection.is_empty())
+        return;
+
+      const Slice *s_x = slice(intersection.lb());
+      while(s_x != NULL && s_x->tdomain().lb() <= intersection.ub())
+      {
+        Interval local_invert = s_x->invert(y, intersection);
+        if(local_invert.is_empty() && !invert.is_empty())
+        {
+          v_t.push_back(invert);
+          invert.set_empty();
+        }
+
+        else
+          invert |= local_invert;
+
+        s_x = s_x->next_slice();
+      }
+
+      if(!invert.is_empty())
+        v_t.push_back(invert);
     }
 
     const Interval Tube::invert(const Interval& y, const Tube& v, const Interval& search_tdomain) const
@@ -1145,6 +1186,54 @@ namespace tubex
       delete_synthesis_tree();
     }
 
+    int Tube::slide_tdomain(double t)
+    {
+      // Number of slices entirely defined before t
+      int n = 0;
+      for(const Slice *s = first_slice() ; s != NULL && s->tdomain().ub() <= t ; s = s->next_slice())
+        n++;
+
+      if(n == 0)
+        return 0;
+
+      Slice *s_last = last_slice();
+
+      for(int i = 0 ; i < n ; i++)
+      {
+        Slice *s = m_first_slice;
+        double t_lb = s_last->tdomain().ub(); // new lower bound of the recycled slice
+        double w = s->tdomain().diam();
+        Interval *free_gate = s->m_input_gate; // not shared: s is the first slice
+
+        if(s != s_last)
+        {
+          // Detaching s from the beginning of the tube
+          m_first_slice = s->m_next_slice;
+          m_first_slice->m_prev_slice = NULL;
+
+          // Chaining s at the end, without allocation: the former input gate
+          // of s becomes its output gate, the final gate is now shared
+          s->m_prev_slice = s_last;
+          s->m_next_slice = NULL;
+          s_last->m_next_slice = s;
+          s->m_input_gate = s_last->m_output_gate;
+          s_last = s;
+        }
+
+        else // single slice: the output gate becomes the input one
+          s->m_input_gate = s->m_output_gate;
+
+        s->m_output_gate = free_gate;
+        s->m_tdomain = Interval(t_lb, t_lb + w);
+        s->m_codomain = Interval::ALL_REALS;
+        *s->m_output_gate = Interval::ALL_REALS;
+      }
+
+      m_tdomain = Interval(m_first_slice->tdomain().lb(), s_last->tdomain().ub());
+      delete_synthesis_tree(); // todo: update tree if created, instead of delete
+      return n;
+    }
+
     // Bisection
     
     const pair<Tube,Tube> Tube::bisect(double t, float ratio) const
@@ -1360,6 +1449,13 @@ namespace tubex
       m_enable_synthesis = enable;
       if(enable)
         create_synthesis_tree();
+      else
+        delete_synthesis_tree();
+    }
+
+    bool Tube::synthesis_enabled() const
+    {
+      return m_enable_synthesis;
     }
 
     const Tube Tube::hull(const list<Tube>& l_tubes)
@@ -791,6 +791,22 @@ namespace tubex
        */
       void shift_tdomain(double a);
 
+      /**
+       * \brief Moves forward the tdomain of \f$[x](\cdot)\f$ on a sliding window
+       *
+       * The slices entirely defined before \f$t\f$ are removed from the beginning
+       * of the tube and recycled at its end, with the same widths and unbounded
+       * codomains. The number of slices remains constant and no memory is allocated.
+       * The input gate of the new first slice is kept, as a prior information on the past.
+       *
+       * \note The window start is snapped to the first gate greater or equal to \f$t\f$,
+       *       and the window cannot move by more than its own length in one call.
+       *
+       * \param t new lower bound of the tdomain
+       * \return the number of recycled slices, now located at the end of the tube
+       */
+      int slide_tdomain(double t);
+
       /// @}
       /// \name Bisection
       /// @{
@@ -989,6 +1005,13 @@ namespace tubex
        */
       void enable_synthesis(bool enable = true) const;
 
+      /**
+       * \brief Tests whether a synthesis tree is enabled for this tube
+       *
+       * \return `true` if the synthesis tree is enabled
+       */
+      bool synthesis_enabled() const;
+
       /// @}
       /// \name Integration
       /// @{
@@ -1165,6 +1188,9 @@ namespace tubex
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
       friend class TubeVector;
       friend class CtcEval;
+      friend class MappedFile;
+      friend void tube_from_columns(Tube& tube, const double *v_t, const double *v_lb, const double *v_ub,
+                                    const double *v_glb, const double *v_gub, size_t k0, size_t k1);
 
       static bool s_enable_syntheses;
   };
@@ -126,12 +126,60 @@ namespace tubex
     else
     {
       if(is_leaf())
-        return inter;
+        return m_slice_ref->invert(y, inter);
 
       else
         return m_first_subtree->invert(y, inter) | m_second_subtree->invert(y, inter);
     }
   }
+
+  void TubeTreeSynthesis::invert(const Interval& y, vector<Interval>& v_t, const Interval& search_tdomain)
+  {
+    v_t.clear();
+    Interval current = Interval::EMPTY_SET;
+    invert(y, v_t, current, search_tdomain);
+
+    if(!current.is_empty())
+      v_t.push_back(current);
+  }
+
+  void TubeTreeSynthesis::invert(const Interval& y, vector<Interval>& v_t, Interval& current, const Interval& search_tdomain)
+  {
+    // Subtrees are explored in chronological order: a subset of v_t
+    // is closed as soon as a part of the tube does not intersect [y]
+
+    Interval inter = m_tdomain & search_tdomain;
+
+    if(inter.is_empty())
+      return;
+
+    Interval local_invert;
+
+    if(!codomain().intersects(y))
+      local_invert = Interval::EMPTY_SET;
+
+    else if(codomain_bounds().first.ub() < y.lb() && codomain_bounds().second.lb() > y.ub())
+      local_invert = inter; // the whole subtree crosses [y]
+
+    else if(is_leaf())
+      local_invert = m_slice_ref->invert(y, inter);
+
+    else
+    {
+      m_first_subtree->invert(y, v_t, current, inter);
+      m_second_subtree->invert(y, v_t, current, inter);
+      return;
+    }
+
+    if(local_invert.is_empty() && !current.is_empty())
+    {
+      v_t.push_back(current);
+      current.set_empty();
+    }
+
+    else
+      current |= local_invert;
+  }
   
   const Interval TubeTreeSynthesis::codomain()
   {
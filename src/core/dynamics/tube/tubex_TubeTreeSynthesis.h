@@ -26,6 +26,7 @@ namespace tubex
       int nb_slices() const;
       const ibex::Interval operator()(const ibex::Interval& t);
       const ibex::Interval invert(const ibex::Interval& y, const ibex::Interval& search_tdomain);
+      void invert(const ibex::Interval& y, std::vector<ibex::Interval>& v_t, const ibex::Interval& search_tdomain);
       const ibex::Interval codomain();
       const std::pair<ibex::Interval,ibex::Interval> codomain_bounds();
       const std::pair<ibex::Interval,ibex::Interval> eval(const ibex::Interval& t = ibex::Interval::ALL_REALS);
@@ -47,6 +48,8 @@ namespace tubex
 
     protected:
 
+      void invert(const ibex::Interval& y, std::vector<ibex::Interval>& v_t, ibex::Interval& current, const ibex::Interval& search_tdomain);
+
       // Slices connections
       const Slice *m_slice_ref = NULL;
       const Tube *m_tube_ref = NULL;
@@ -488,12 +488,15 @@ namespace tubex
         v_v[i] = v_v[i]->prev_slice());
     }
 
-    #define macro_invert_subsets(invert_method, slice_deriv_init, slice_deriv_iter) \
+    #define macro_invert_subsets(invert_method, tdomain_restriction, slice_deriv_init, slice_deriv_iter) \
       assert(size() == y.size()); \
       assert(search_tdomain.intersects(tdomain())); \
        \
       v_t.clear(); \
       Interval restricted_tdomain = tdomain() & search_tdomain; \
+      tdomain_restriction; \
+      if(restricted_tdomain.is_empty()) \
+        return; \
        \
       const Slice **v_s = new const Slice*[size()]; \
       const Slice **v_v = new const Slice*[size()]; \
@@ -534,8 +537,14 @@ namespace tubex
 
     void TubeVector::invert(const IntervalVector& y, vector<Interval> &v_t, const Interval& search_tdomain) const
     {
+      // Components having a synthesis tree quickly restrict the search
       macro_invert_subsets(
         v_s[i]->invert(y[i], restricted_tdomain), 
+        {
+          for(int i = 0 ; i < size() && !restricted_tdomain.is_empty() ; i++)
+            if((*this)[i].synthesis_enabled())
+              restricted_tdomain &= (*this)[i].invert(y[i], restricted_tdomain);
+        },
         {}, 
         {});
     }
@@ -548,6 +557,7 @@ namespace tubex
 
       macro_invert_subsets(
         v_s[i]->invert(y[i], *v_v[i], restricted_tdomain), 
+        {},
         v_v[i] = v[i].slice(restricted_tdomain.lb()),
         v_v[i] = v_v[i]->next_slice());
     }
@@ -590,12 +600,15 @@ namespace tubex
       Trajectory diag_traj;
       TrajectoryVector diams = diam(gates_thicknesses);
 
-      for(map<double,double>::const_iterator it = diams[0].sampled_map().begin() ; it != diams[0].sampled_map().end() ; it++)
+      const vector<double>& v_t = diams[0].sampled_times();
+      const vector<double>& v_y = diams[0].sampled_values();
+
+      for(size_t k = 0 ; k < v_t.size() ; k++)
       {
         double diag = 0.;
         for(int i = start_index ; i <= end_index ; i++)
-          diag += std::pow(it->second, 2);
-        diag_traj.set(std::sqrt(diag), it->first);
+          diag += std::pow(v_y[k], 2);
+        diag_traj.set(std::sqrt(diag), v_t[k]);
       }
 
       return diag_traj;
@@ -780,6 +793,14 @@ namespace tubex
         (*this)[i].shift_tdomain(shift_ref);
     }
 
+    int TubeVector::slide_tdomain(double t)
+    {
+      int n = 0;
+      for(int i = 0 ; i < size() ; i++)
+        n = (*this)[i].slide_tdomain(t);
+      return n;
+    }
+
     // Bisection
     
     const pair<TubeVector,TubeVector> TubeVector::bisect(double t, float ratio) const
@@ -739,6 +739,16 @@ namespace tubex
        */
       void shift_tdomain(double a);
 
+      /**
+       * \brief Moves forward the tdomain of \f$[\mathbf{x}](\cdot)\f$ on a sliding window
+       *
+       * \note See Tube::slide_tdomain()
+       *
+       * \param t new lower bound of the tdomain
+       * \return the number of recycled slices in each component
+       */
+      int slide_tdomain(double t);
+
       /// @}
       /// \name Bisection
       /// @{
@@ -1162,6 +1172,7 @@ namespace tubex
         Tube *m_v_tubes = NULL; //!< array of components (scalar tubes)
 
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
+      friend class MappedFile;
   };
 }
 
@@ -0,0 +1,367 @@
+/** 
+ *  FunctionTape class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "tubex_FunctionTape.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Definition
+
+  FunctionTape::FunctionTape(const Function& f)
+    : m_nb_var(f.nb_var()), m_v_var_nodes(f.nb_var(), -1)
+  {
+    map<const ExprNode*,int> map_ids, map_symbols;
+
+    for(int k = 0, offset = 0 ; k < f.nb_arg() ; k++)
+    {
+      map_symbols[&f.arg(k)] = offset;
+      offset += f.arg(k).dim.size();
+    }
+
+    const ExprNode& root = f.expr();
+    const ExprVector *root_vector = dynamic_cast<const ExprVector*>(&root);
+
+    if(f.image_dim() == 1 && root.dim.is_scalar())
+      m_v_outputs.push_back(compile(root, map_ids, map_symbols));
+
+    else if(root_vector != NULL && root_vector->nb_args == f.image_dim())
+      for(int i = 0 ; i < root_vector->nb_args ; i++)
+        m_v_outputs.push_back(compile(root_vector->arg(i), map_ids, map_symbols));
+
+    else
+      m_supported = false;
+  }
+
+  bool FunctionTape::is_supported() const
+  {
+    return m_supported;
+  }
+
+  int FunctionTape::nb_var() const
+  {
+    return m_nb_var;
+  }
+
+  int FunctionTape::image_dim() const
+  {
+    return m_v_outputs.size();
+  }
+
+  int FunctionTape::nb_nodes() const
+  {
+    return m_v_nodes.size();
+  }
+
+  int FunctionTape::output_node(int i) const
+  {
+    assert(i >= 0 && i < image_dim());
+    return m_v_outputs[i];
+  }
+
+  // Batched evaluations
+
+  void FunctionTape::eval(const vector<Interval>& v_x, int b, vector<Interval>& v_values) const
+  {
+    assert(m_supported && "unsupported expression");
+    assert(b > 0 && (int)v_x.size() >= m_nb_var*b);
+
+    if(v_values.size() < m_v_nodes.size()*b)
+      v_values.resize(m_v_nodes.size()*b);
+
+    // Each operation is applied on the whole block before the next one
+
+    for(size_t k = 0 ; k < m_v_nodes.size() ; k++)
+    {
+      const Node& node = m_v_nodes[k];
+      Interval *y = &v_values[k*b];
+      const Interval *x1 = node.a == -1 ? NULL : &v_values[node.a*b];
+      const Interval *x2 = node.b == -1 ? NULL : &v_values[node.b*b];
+
+      switch(node.op)
+      {
+        case VAR:   for(int j = 0 ; j < b ; j++) y[j] = v_x[node.var*b+j]; break;
+        case CST:   for(int j = 0 ; j < b ; j++) y[j] = node.cst; break;
+        case ADD:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] + x2[j]; break;
+        case SUB:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] - x2[j]; break;
+        case MUL:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] * x2[j]; break;
+        case DIV:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] / x2[j]; break;
+        case ATAN2: for(int j = 0 ; j < b ; j++) y[j] = ibex::atan2(x1[j], x2[j]); break;
+        case MIN:   for(int j = 0 ; j < b ; j++) y[j] = ibex::min(x1[j], x2[j]); break;
+        case MAX:   for(int j = 0 ; j < b ; j++) y[j] = ibex::max(x1[j], x2[j]); break;
+        case MINUS: for(int j = 0 ; j < b ; j++) y[j] = -x1[j]; break;
+        case SQR:   for(int j = 0 ; j < b ; j++) y[j] = ibex::sqr(x1[j]); break;
+        case SQRT:  for(int j = 0 ; j < b ; j++) y[j] = ibex::sqrt(x1[j]); break;
+        case EXP:   for(int j = 0 ; j < b ; j++) y[j] = ibex::exp(x1[j]); break;
+        case LOG:   for(int j = 0 ; j < b ; j++) y[j] = ibex::log(x1[j]); break;
+        case COS:   for(int j = 0 ; j < b ; j++) y[j] = ibex::cos(x1[j]); break;
+        case SIN:   for(int j = 0 ; j < b ; j++) y[j] = ibex::sin(x1[j]); break;
+        case TAN:   for(int j = 0 ; j < b ; j++) y[j] = ibex::tan(x1[j]); break;
+        case ACOS:  for(int j = 0 ; j < b ; j++) y[j] = ibex::acos(x1[j]); break;
+        case ASIN:  for(int j = 0 ; j < b ; j++) y[j] = ibex::asin(x1[j]); break;
+        case ATAN:  for(int j = 0 ; j < b ; j++) y[j] = ibex::atan(x1[j]); break;
+        case ABS:   for(int j = 0 ; j < b ; j++) y[j] = ibex::abs(x1[j]); break;
+        case POW:   for(int j = 0 ; j < b ; j++) y[j] = ibex::pow(x1[j], node.expon); break;
+      }
+    }
+
+    // As for IBEX evaluations, the image of a box with an empty component
+    // is empty (even for constant expressions)
+
+    for(int i = 0 ; i < m_nb_var ; i++)
+      for(int j = 0 ; j < b ; j++)
+        if(v_x[i*b+j].is_empty())
+          for(int k = 0 ; k < image_dim() ; k++)
+            v_values[m_v_outputs[k]*b+j].set_empty();
+  }
+
+  void FunctionTape::contract(vector<Interval>& v_x, int b, const IntervalVector& y, vector<Interval>& v_values) const
+  {
+    assert(y.size() == image_dim());
+
+    eval(v_x, b, v_values);
+
+    for(int i = 0 ; i < image_dim() ; i++)
+      for(int j = 0 ; j < b ; j++)
+        v_values[m_v_outputs[i]*b+j] &= y[i];
+
+    // Backward propagation, from the outputs to the leaves:
+    // a node is processed only once all its parents have been
+
+    for(int k = m_v_nodes.size() - 1 ; k >= 0 ; k--)
+    {
+      const Node& node = m_v_nodes[k];
+      const Interval *z = &v_values[k*b];
+      Interval *x1 = node.a == -1 ? NULL : &v_values[node.a*b];
+      Interval *x2 = node.b == -1 ? NULL : &v_values[node.b*b];
+
+      switch(node.op)
+      {
+        case VAR:
+        case CST:   break;
+        case ADD:   for(int j = 0 ; j < b ; j++) bwd_add(z[j], x1[j], x2[j]); break;
+        case SUB:   for(int j = 0 ; j < b ; j++) bwd_sub(z[j], x1[j], x2[j]); break;
+        case MUL:   for(int j = 0 ; j < b ; j++) bwd_mul(z[j], x1[j], x2[j]); break;
+        case DIV:   for(int j = 0 ; j < b ; j++) bwd_div(z[j], x1[j], x2[j]); break;
+        case ATAN2: for(int j = 0 ; j < b ; j++) bwd_atan2(z[j], x1[j], x2[j]); break;
+        case MIN:   for(int j = 0 ; j < b ; j++) bwd_min(z[j], x1[j], x2[j]); break;
+        case MAX:   for(int j = 0 ; j < b ; j++) bwd_max(z[j], x1[j], x2[j]); break;
+        case MINUS: for(int j = 0 ; j < b ; j++) x1[j] &= -z[j]; break;
+        case SQR:   for(int j = 0 ; j < b ; j++) bwd_sqr(z[j], x1[j]); break;
+        case SQRT:  for(int j = 0 ; j < b ; j++) bwd_sqrt(z[j], x1[j]); break;
+        case EXP:   for(int j = 0 ; j < b ; j++) bwd_exp(z[j], x1[j]); break;
+        case LOG:   for(int j = 0 ; j < b ; j++) bwd_log(z[j], x1[j]); break;
+        case COS:   for(int j = 0 ; j < b ; j++) bwd_cos(z[j], x1[j]); break;
+        case SIN:   for(int j = 0 ; j < b ; j++) bwd_sin(z[j], x1[j]); break;
+        case TAN:   for(int j = 0 ; j < b ; j++) bwd_tan(z[j], x1[j]); break;
+        case ACOS:  for(int j = 0 ; j < b ; j++) bwd_acos(z[j], x1[j]); break;
+        case ASIN:  for(int j = 0 ; j < b ; j++) bwd_asin(z[j], x1[j]); break;
+        case ATAN:  for(int j = 0 ; j < b ; j++) bwd_atan(z[j], x1[j]); break;
+        case ABS:   for(int j = 0 ; j < b ; j++) bwd_abs(z[j], x1[j]); break;
+        case POW:   for(int j = 0 ; j < b ; j++) bwd_pow(z[j], node.expon, x1[j]); break;
+      }
+    }
+
+    // Projections on the variables, inconsistent boxes are emptied
+
+    vector<bool> v_empty(b, false);
+
+    for(int i = 0 ; i < image_dim() ; i++)
+      for(int j = 0 ; j < b ; j++)
+        if(v_values[m_v_outputs[i]*b+j].is_empty())
+          v_empty[j] = true;
+
+    for(int i = 0 ; i < m_nb_var ; i++)
+      if(m_v_var_nodes[i] != -1)
+        for(int j = 0 ; j < b ; j++)
+        {
+          v_x[i*b+j] &= v_values[m_v_var_nodes[i]*b+j];
+          if(v_x[i*b+j].is_empty())
+            v_empty[j] = true;
+        }
+
+    for(int j = 0 ; j < b ; j++)
+      if(v_empty[j])
+        for(int i = 0 ; i < m_nb_var ; i++)
+          v_x[i*b+j].set_empty();
+  }
+
+  void FunctionTape::eval(const vector<double>& v_x, int b, vector<double>& v_values) const
+  {
+    assert(m_supported && "unsupported expression");
+    assert(b > 0 && (int)v_x.size() >= m_nb_var*b);
+
+    if(v_values.size() < m_v_nodes.size()*b)
+      v_values.resize(m_v_nodes.size()*b);
+
+    eval(v_x.data(), b, v_values.data());
+  }
+
+  void FunctionTape::eval(const double *x, int b, double *values) const
+  {
+    assert(m_supported && "unsupported expression");
+    assert(b > 0);
+
+    for(size_t k = 0 ; k < m_v_nodes.size() ; k++)
+    {
+      const Node& node = m_v_nodes[k];
+      double *y = &values[k*b];
+      const double *x1 = node.a == -1 ? NULL : &values[node.a*b];
+      const double *x2 = node.b == -1 ? NULL : &values[node.b*b];
+
+      switch(node.op)
+      {
+        case VAR:   for(int j = 0 ; j < b ; j++) y[j] = x[node.var*b+j]; break;
+        case CST:   for(int j = 0 ; j < b ; j++) y[j] = node.cst.mid(); break;
+        case ADD:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] + x2[j]; break;
+        case SUB:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] - x2[j]; break;
+        case MUL:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] * x2[j]; break;
+        case DIV:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] / x2[j]; break;
+        case ATAN2: for(int j = 0 ; j < b ; j++) y[j] = std::atan2(x1[j], x2[j]); break;
+        case MIN:   for(int j = 0 ; j < b ; j++) y[j] = std::min(x1[j], x2[j]); break;
+        case MAX:   for(int j = 0 ; j < b ; j++) y[j] = std::max(x1[j], x2[j]); break;
+        case MINUS: for(int j = 0 ; j < b ; j++) y[j] = -x1[j]; break;
+        case SQR:   for(int j = 0 ; j < b ; j++) y[j] = x1[j] * x1[j]; break;
+        case SQRT:  for(int j = 0 ; j < b ; j++) y[j] = std::sqrt(x1[j]); break;
+        case EXP:   for(int j = 0 ; j < b ; j++) y[j] = std::exp(x1[j]); break;
+        case LOG:   for(int j = 0 ; j < b ; j++) y[j] = std::log(x1[j]); break;
+        case COS:   for(int j = 0 ; j < b ; j++) y[j] = std::cos(x1[j]); break;
+        case SIN:   for(int j = 0 ; j < b ; j++) y[j] = std::sin(x1[j]); break;
+        case TAN:   for(int j = 0 ; j < b ; j++) y[j] = std::tan(x1[j]); break;
+        case ACOS:  for(int j = 0 ; j < b ; j++) y[j] = std::acos(x1[j]); break;
+        case ASIN:  for(int j = 0 ; j < b ; j++) y[j] = std::asin(x1[j]); break;
+        case ATAN:  for(int j = 0 ; j < b ; j++) y[j] = std::atan(x1[j]); break;
+        case ABS:   for(int j = 0 ; j < b ; j++) y[j] = std::fabs(x1[j]); break;
+        case POW:   for(int j = 0 ; j < b ; j++) y[j] = std::pow(x1[j], node.expon); break;
+      }
+    }
+  }
+
+  // Protected methods
+
+  int FunctionTape::compile(const ExprNode& e,
+                            map<const ExprNode*,int>& map_ids,
+                            const map<const ExprNode*,int>& map_symbols)
+  {
+    map<const ExprNode*,int>::const_iterator it = map_ids.find(&e);
+    if(it != map_ids.end()) // shared sub-expression
+      return it->second;
+
+    int id = -1;
+    const ExprIndex *e_index = dynamic_cast<const ExprIndex*>(&e);
+    const ExprConstant *e_cst = dynamic_cast<const ExprConstant*>(&e);
+    const ExprBinaryOp *e_bin = dynamic_cast<const ExprBinaryOp*>(&e);
+    const ExprUnaryOp *e_un = dynamic_cast<const ExprUnaryOp*>(&e);
+
+    if(!e.dim.is_scalar())
+    {
+      // vector or matrix operations are not supported
+    }
+
+    else if(dynamic_cast<const ExprSymbol*>(&e) != NULL)
+      id = var_node(map_symbols.at(&e));
+
+    else if(e_index != NULL) // component of a vector argument
+    {
+      map<const ExprNode*,int>::const_iterator it_symbol = map_symbols.find(&e_index->expr);
+      if(it_symbol != map_symbols.end())
+      {
+        if(e_index->expr.dim.nb_cols() == 1)
+          id = var_node(it_symbol->second + e_index->index.first_row());
+        else if(e_index->expr.dim.nb_rows() == 1)
+          id = var_node(it_symbol->second + e_index->index.first_col());
+      }
+    }
+
+    else if(e_cst != NULL)
+    {
+      id = add_node(CST);
+      m_v_nodes[id].cst = e_cst->get_value();
+    }
+
+    else if(e_bin != NULL)
+    {
+      int a = compile(e_bin->left, map_ids, map_symbols);
+      int b = compile(e_bin->right, map_ids, map_symbols);
+
+      if(a != -1 && b != -1)
+      {
+        if(dynamic_cast<const ExprAdd*>(&e))         id = add_node(ADD, a, b);
+        else if(dynamic_cast<const ExprSub*>(&e))    id = add_node(SUB, a, b);
+        else if(dynamic_cast<const ExprMul*>(&e))    id = add_node(MUL, a, b);
+        else if(dynamic_cast<const ExprDiv*>(&e))    id = add_node(DIV, a, b);
+        else if(dynamic_cast<const ExprAtan2*>(&e))  id = add_node(ATAN2, a, b);
+        else if(dynamic_cast<const ExprMin*>(&e))    id = add_node(MIN, a, b);
+        else if(dynamic_cast<const ExprMax*>(&e))    id = add_node(MAX, a, b);
+      }
+    }
+
+    else if(e_un != NULL)
+    {
+      int a = compile(e_un->expr, map_ids, map_symbols);
+
+      if(a != -1)
+      {
+        if(dynamic_cast<const ExprMinus*>(&e))       id = add_node(MINUS, a);
+        else if(dynamic_cast<const ExprSqr*>(&e))    id = add_node(SQR, a);
+        else if(dynamic_cast<const ExprSqrt*>(&e))   id = add_node(SQRT, a);
+        else if(dynamic_cast<const ExprExp*>(&e))    id = add_node(EXP, a);
+        else if(dynamic_cast<const ExprLog*>(&e))    id = add_node(LOG, a);
+        else if(dynamic_cast<const ExprCos*>(&e))    id = add_node(COS, a);
+        else if(dynamic_cast<const ExprSin*>(&e))    id = add_node(SIN, a);
+        else if(dynamic_cast<const ExprTan*>(&e))    id = add_node(TAN, a);
+        else if(dynamic_cast<const ExprAcos*>(&e))   id = add_node(ACOS, a);
+        else if(dynamic_cast<const ExprAsin*>(&e))   id = add_node(ASIN, a);
+        else if(dynamic_cast<const ExprAtan*>(&e))   id = add_node(ATAN, a);
+        else if(dynamic_cast<const ExprAbs*>(&e))    id = add_node(ABS, a);
+        else if(dynamic_cast<const ExprPower*>(&e))
+        {
+          id = add_node(POW, a);
+          m_v_nodes[id].expon = dynamic_cast<const ExprPower*>(&e)->expon;
+        }
+      }
+    }
+
+    if(id == -1)
+      m_supported = false;
+    else
+      map_ids[&e] = id;
+
+    return id;
+  }
+
+  int FunctionTape::add_node(Op op, int a, int b)
+  {
+    Node node;
+    node.op = op;
+    node.a = a; node.b = b;
+    node.var = -1;
+    node.expon = 0;
+    m_v_nodes.push_back(node);
+    return m_v_nodes.size() - 1;
+  }
+
+  int FunctionTape::var_node(int i)
+  {
+    assert(i >= 0 && i < m_nb_var);
+
+    if(m_v_var_nodes[i] == -1)
+    {
+      m_v_var_nodes[i] = add_node(VAR);
+      m_v_nodes[m_v_var_nodes[i]].var = i;
+    }
+
+    return m_v_var_nodes[i];
+  }
+}
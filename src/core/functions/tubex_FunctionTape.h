@@ -0,0 +1,203 @@
+/** 
+ *  \file
+ *  FunctionTape class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_FUNCTIONTAPE_H__
+#define __TUBEX_FUNCTIONTAPE_H__
+
+#include <map>
+#include <vector>
+#include "ibex_Function.h"
+#include "ibex_Expr.h"
+
+namespace tubex
+{
+  /**
+   * \class FunctionTape
+   * \brief Flattened expression DAG of an ibex::Function, evaluated
+   *        over blocks of boxes at once
+   *
+   * The nodes are stored in a topological order, so that the DAG is not walked
+   * again for each box. The values of a block of \f$b\f$ boxes are stored node
+   * by node (structure of arrays): the \f$b\f$ values of the node \f$k\f$ are
+   * contiguous, from index \f$k\cdot b\f$.
+   *
+   * \note Only scalar operations are supported (the arguments may be vectors
+   *       accessed by indices, the image may be a vector of scalar expressions).
+   *       See is_supported().
+   */
+  class FunctionTape
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Compiles the expression of an ibex::Function
+       *
+       * \param f the function
+       */
+      explicit FunctionTape(const ibex::Function& f);
+
+      /**
+       * \brief Returns true if all the operations of the function are supported
+       *
+       * \note Other methods must not be called otherwise
+       *
+       * \return true if the tape can be used
+       */
+      bool is_supported() const;
+
+      /**
+       * \brief Returns the number of scalar variables of the function
+       *
+       * \return the number of variables
+       */
+      int nb_var() const;
+
+      /**
+       * \brief Returns the dimension of the image of the function
+       *
+       * \return the image dimension
+       */
+      int image_dim() const;
+
+      /**
+       * \brief Returns the number of nodes of the flattened DAG
+       *
+       * \return the number of nodes
+       */
+      int nb_nodes() const;
+
+      /**
+       * \brief Returns the node of the i-th component of the image
+       *
+       * \param i the index of the image component
+       * \return the node index
+       */
+      int output_node(int i) const;
+
+      /// @}
+      /// \name Batched evaluations
+      /// @{
+
+      /**
+       * \brief Evaluates the function over a block of \f$b\f$ boxes
+       *
+       * \param v_x the boxes, stored variable by variable: the i-th component
+       *        of the j-th box is v_x[i*b+j]
+       * \param b the number of boxes
+       * \param v_values the values of the nodes (resized if needed), the image
+       *        of the j-th box is given by v_values[output_node(i)*b+j]
+       */
+      void eval(const std::vector<ibex::Interval>& v_x, int b, std::vector<ibex::Interval>& v_values) const;
+
+      /**
+       * \brief Contracts a block of \f$b\f$ boxes with respect to \f$\mathbf{f}(\mathbf{x})\in[\mathbf{y}]\f$
+       *
+       * One forward-backward pass (HC4Revise) is performed on all the boxes.
+       * The boxes found inconsistent are set to empty.
+       *
+       * \param v_x the boxes, stored variable by variable (see eval())
+       * \param b the number of boxes
+       * \param y the set \f$[\mathbf{y}]\f$
+       * \param v_values the values of the nodes, used as workspace
+       */
+      void contract(std::vector<ibex::Interval>& v_x, int b, const ibex::IntervalVector& y, std::vector<ibex::Interval>& v_values) const;
+
+      /**
+       * \brief Evaluates the function over a block of \f$b\f$ points,
+       *        with floating-point arithmetic
+       *
+       * \note This is not a reliable evaluation: the rounding errors are not
+       *       enclosed, and the constants of the expression are replaced by
+       *       their midpoints. Mainly used for sampling or display purposes.
+       *
+       * \param v_x the points, stored variable by variable (see eval())
+       * \param b the number of points
+       * \param v_values the values of the nodes (resized if needed)
+       */
+      void eval(const std::vector<double>& v_x, int b, std::vector<double>& v_values) const;
+
+      /**
+       * \brief Evaluates the function over a block of \f$b\f$ points, with floating-point
+       *        arithmetic, in buffers provided by the caller (see the above method)
+       *
+       * \param x the points, stored variable by variable
+       * \param b the number of points
+       * \param values the values of the nodes (nb_nodes()*b items)
+       */
+      void eval(const double *x, int b, double *values) const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \enum Op
+       * \brief Operation of a node
+       */
+      enum Op { VAR, CST,
+                ADD, SUB, MUL, DIV, ATAN2, MIN, MAX,
+                MINUS, SQR, SQRT, EXP, LOG, COS, SIN, TAN, ACOS, ASIN, ATAN, ABS, POW };
+
+      /**
+       * \struct Node
+       * \brief Node of the flattened DAG
+       */
+      struct Node
+      {
+        Op op; //!< operation
+        int a, b; //!< indices of the operand nodes (-1 if none)
+        int var; //!< index of the variable for VAR
+        int expon; //!< exponent for POW
+        ibex::Interval cst; //!< value for CST
+      };
+
+      /**
+       * \brief Adds the node of an expression, and its operands, to the tape
+       *
+       * \param e the expression
+       * \param map_ids nodes already compiled (shared sub-expressions)
+       * \param map_symbols first variable index of each argument of the function
+       * \return the index of the node, or -1 if the expression is not supported
+       */
+      int compile(const ibex::ExprNode& e,
+                  std::map<const ibex::ExprNode*,int>& map_ids,
+                  const std::map<const ibex::ExprNode*,int>& map_symbols);
+
+      /**
+       * \brief Adds a node to the tape
+       *
+       * \param op the operation
+       * \param a index of the first operand node
+       * \param b index of the second operand node
+       * \return the index of the node
+       */
+      int add_node(Op op, int a = -1, int b = -1);
+
+      /**
+       * \brief Returns the node of a scalar variable, added to the tape if needed
+       *
+       * \param i the index of the variable
+       * \return the index of the node
+       */
+      int var_node(int i);
+
+      int m_nb_var; //!< number of scalar variables
+      bool m_supported = true; //!< false if an expression could not be compiled
+      std::vector<Node> m_v_nodes; //!< nodes, in topological order
+      std::vector<int> m_v_outputs; //!< nodes of the image components
+      std::vector<int> m_v_var_nodes; //!< node of each variable (-1 if not involved)
+  };
+}
+
+#endif
@@ -8,9 +8,12 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
+#include <thread>
 #include "tubex_TFunction.h"
 #include "tubex_Tube.h"
 #include "tubex_TubeVector.h"
+#include "tubex_Exception.h"
 
 using namespace std;
 using namespace ibex;
@@ -120,6 +123,8 @@ namespace tubex
   TFunction::~TFunction()
   {
     delete m_ibex_f;
+    if(m_tape != NULL)
+      delete m_tape;
   }
 
   const TFunction& TFunction::operator=(const TFunction& f)
@@ -127,6 +132,9 @@ namespace tubex
     if(m_ibex_f != NULL)
       delete m_ibex_f;
     m_ibex_f = new Function(*f.m_ibex_f);
+    if(m_tape != NULL)
+      delete m_tape;
+    m_tape = f.m_tape != NULL ? new FunctionTape(*f.m_tape) : NULL;
     m_expr = f.m_expr;
     TFnc::operator=(f);
     return *this;
@@ -141,6 +149,12 @@ namespace tubex
     delete fi.m_ibex_f;
     fi.m_ibex_f = new Function(ibex_fi);
     fi.m_img_dim = 1;
+    if(fi.is_compiled())
+    {
+      delete fi.m_tape;
+      fi.m_tape = NULL;
+      fi.compile();
+    }
     return fi;
   }
   
@@ -233,21 +247,21 @@ namespace tubex
   {
     assert(x.size() == nb_var());
     assert(image_dim() == 1 && "scalar evaluation");
-    return traj_eval_vector(x)[0];
+    return traj_eval_vector(x, true).component(0); // (one column of the shared result)
   }
 
   const IntervalVector TFunction::eval_vector(const Interval& t) const
   {
     assert(nb_var() == 0);
     IntervalVector box(1, t);
-    return m_ibex_f->eval_vector(box);
+    return eval_box(box);
   }
 
   const IntervalVector TFunction::eval_vector(const IntervalVector& x) const
   {
     assert(nb_var() == x.size() - 1);
     assert(!is_intertemporal());
-    return m_ibex_f->eval_vector(x);
+    return eval_box(x);
   }
 
   const IntervalVector TFunction::eval_vector(int slice_id, const TubeVector& x) const
@@ -268,7 +282,7 @@ namespace tubex
     box[0] = t;
     box.put(1, x(slice_id));
 
-    return m_ibex_f->eval_vector(box);
+    return eval_box(box);
   }
 
   const IntervalVector TFunction::eval_vector(const Interval& t, const TubeVector& x) const
@@ -288,7 +302,7 @@ namespace tubex
       for(int i = 0 ; i < x.size() ; i++)
         box[i+1] = x[i](t);
 
-    return m_ibex_f->eval_vector(box);
+    return eval_box(box);
   }
 
   const TubeVector TFunction::eval_vector(const TubeVector& x) const
@@ -312,6 +326,12 @@ namespace tubex
       return y;
     }
 
+    if(is_compiled())
+    {
+      eval_slices_by_blocks(x, y);
+      return y;
+    }
+
     IntervalVector box(x.size() + 1), result(y.size());
 
     const Slice **v_sx = new const Slice*[x.size()];
@@ -343,14 +363,14 @@ namespace tubex
       box[0] = v_sx[0]->tdomain();
       for(int i = 0 ; i < x.size() ; i++)
         box[i+1] = v_sx[i]->codomain();
-      result = m_ibex_f->eval_vector(box);
+      result = eval_box(box);
       for(int i = 0 ; i < y.size() ; i++)
         v_sy[i]->set_envelope(result[i], false);
 
       box[0] = box[0].lb();
       for(int i = 0 ; i < x.size() ; i++)
         box[i+1] = v_sx[i]->input_gate();
-      result = m_ibex_f->eval_vector(box);
+      result = eval_box(box);
       for(int i = 0 ; i < y.size() ; i++)
         v_sy[i]->set_input_gate(result[i], false);
 
@@ -359,7 +379,7 @@ namespace tubex
     box[0] = v_sx[0]->tdomain().ub();
     for(int i = 0 ; i < x.size() ; i++)
       box[i+1] = v_sx[i]->output_gate();
-    result = m_ibex_f->eval_vector(box);
+    result = eval_box(box);
     for(int i = 0 ; i < y.size() ; i++)
       v_sy[i]->set_output_gate(result[i], false);
 
@@ -368,32 +388,134 @@ namespace tubex
     return y;
   }
 
-  const TrajectoryVector TFunction::traj_eval_vector(const TrajectoryVector& x) const
+  const TrajectoryVector TFunction::traj_eval_vector(const TrajectoryVector& x, bool shared_time_axis) const
   {
     // Faster evaluation than the generic Fnc::eval method
     // For now, TFunction class does not allow inter-temporal evaluations
     // such as delays or integral computations. Hence, the generic method
     // Fnc::eval(Interval t, TubeVector x) can be replaced by a dedicated evaluation
 
-    // todo: update this comment ^
-
     if(nb_var() != 0)
       assert(x.size() == nb_var());
 
-    assert(x[0].definition_type() == TrajDefnType::MAP_OF_VALUES
-      && "eval TFunction not supported for analytic trajectories");
-    
-    TrajectoryVector y(image_dim());
-    for(map<double,double>::const_iterator it = x[0].sampled_map().begin() ;
-        it != x[0].sampled_map().end() ; it++)
-    {
-      Vector v(nb_var() + 1);
-      v[0] = it->first;
-      v.put(1, x(it->first));
+    // The evaluation times are the samples of the first sampled component,
+    // the other components (possibly analytic) are evaluated at these times.
+    // On a shared time axis, the rows of x are read directly.
 
-      y.set(m_ibex_f->eval_vector(v).mid(), it->first);
-    }
+      const bool rows_of_x = x.time_axis_shared() && !x.not_defined();
+
+      const vector<double> *v_t = NULL;
+      if(rows_of_x)
+        v_t = &x.sampled_times();
 
+      else if(!x.time_axis_shared())
+        for(int i = 0 ; i < x.size() && v_t == NULL ; i++)
+          if(x[i].definition_type() == TrajDefnType::MAP_OF_VALUES && !x[i].not_defined())
+            v_t = &x[i].sampled_times();
+
+      if(v_t == NULL)
+        throw Exception(__func__, "at least one component of x must be sampled");
+
+      // The const readers of a Trajectory may merge its buffered samples:
+      // this is done here for all the components, before any thread starts
+
+      if(!x.time_axis_shared())
+        for(int i = 0 ; i < x.size() ; i++)
+          if(x[i].definition_type() == TrajDefnType::MAP_OF_VALUES)
+            x[i].sampled_times();
+
+    // Floating-point evaluations of the tape, by blocks of samples
+
+      FunctionTape *tape = m_tape;
+      if(tape == NULL)
+      {
+        tape = new FunctionTape(*m_ibex_f);
+        if(!tape->is_supported())
+        {
+          delete tape;
+          tape = NULL;
+        }
+      }
+
+      const int n = nb_var(), m = image_dim(), block_size = 256;
+      const size_t nb_samples = v_t->size();
+      vector<double> v_values(nb_samples*m); // preallocated output, row-major
+
+      auto eval_range = [&](size_t j_begin, size_t j_end)
+      {
+        vector<double> v_block_t, v_x, v_nodes;
+
+        for(size_t j0 = j_begin ; j0 < j_end ; j0 += block_size)
+        {
+          const int b = (int)std::min((size_t)block_size, j_end - j0);
+          v_block_t.assign(v_t->begin() + j0, v_t->begin() + j0 + b);
+
+          v_x.resize((n+1)*b);
+          std::copy(v_block_t.begin(), v_block_t.end(), v_x.begin());
+
+          if(rows_of_x) // no evaluation: x is sampled at the times v_t
+            for(int j = 0 ; j < b ; j++)
+            {
+              const double *row = x.sampled_row(j0+j);
+              for(int i = 0 ; i < n ; i++)
+                v_x[(i+1)*b+j] = row[i];
+            }
+
+          else
+            for(int i = 0 ; i < n ; i++)
+            {
+              vector<double> v_xi = x[i].sample_values(v_block_t);
+              std::copy(v_xi.begin(), v_xi.end(), v_x.begin() + (i+1)*b);
+            }
+
+          if(tape != NULL)
+          {
+            tape->eval(v_x, b, v_nodes);
+            for(int k = 0 ; k < m ; k++)
+            {
+              const double *values = &v_nodes[tape->output_node(k)*b];
+              for(int j = 0 ; j < b ; j++)
+                v_values[(j0+j)*m+k] = values[j];
+            }
+          }
+
+          else // IBEX evaluator (not thread-safe)
+            for(int j = 0 ; j < b ; j++)
+            {
+              IntervalVector box(n+1);
+              for(int i = 0 ; i <= n ; i++)
+                box[i] = v_x[i*b+j];
+              IntervalVector y = eval_box(box);
+              for(int k = 0 ; k < m ; k++)
+                v_values[(j0+j)*m+k] = y[k].mid(); // /!\ an approximation is made here
+            }
+        }
+      };
+
+      // Ranges of blocks distributed over the threads
+
+        bool thread_safe = tape != NULL;
+        for(int i = 0 ; i < n && !rows_of_x ; i++)
+          if(x[i].definition_type() == TrajDefnType::ANALYTIC_FNC && !x[i].tfunction()->is_compiled())
+            thread_safe = false;
+
+        int nb_threads = thread_safe ? std::max(1, (int)thread::hardware_concurrency()) : 1;
+        nb_threads = (int)std::min((size_t)nb_threads, (nb_samples + block_size - 1) / block_size);
+        const size_t chunk = ((nb_samples + nb_threads - 1) / nb_threads + block_size - 1) / block_size * block_size;
+
+        vector<thread> v_threads;
+        for(int k = 1 ; k < nb_threads ; k++)
+          v_threads.push_back(thread(eval_range, std::min(k*chunk, nb_samples), std::min((k+1)*chunk, nb_samples)));
+        eval_range(0, std::min(chunk, nb_samples));
+        for(auto& th : v_threads)
+          th.join();
+
+      if(tape != m_tape)
+        delete tape;
+
+    TrajectoryVector y(m, *v_t, v_values);
+    if(!shared_time_axis)
+      y.unshare_time_axis();
     return y;
   }
 
@@ -402,6 +524,193 @@ namespace tubex
     TFunction diff_f = *this;
     delete diff_f.m_ibex_f;
     diff_f.m_ibex_f = new Function(m_ibex_f->diff());
+    if(diff_f.is_compiled())
+    {
+      delete diff_f.m_tape;
+      diff_f.m_tape = NULL;
+      diff_f.compile();
+    }
     return diff_f;
   }
-}
\ No newline at end of file
+
+  bool TFunction::compile()
+  {
+    if(m_tape == NULL)
+    {
+      m_tape = new FunctionTape(*m_ibex_f);
+      if(!m_tape->is_supported())
+      {
+        delete m_tape;
+        m_tape = NULL;
+      }
+    }
+
+    return m_tape != NULL;
+  }
+
+  bool TFunction::is_compiled() const
+  {
+    return m_tape != NULL;
+  }
+
+  void TFunction::eval_points(const vector<double>& v_t, vector<double>& v_y) const
+  {
+    assert(nb_var() == 0 && "function's inputs must be limited to system variable");
+
+    const int n = v_t.size(), m = image_dim();
+    v_y.resize(m*n);
+
+    if(m_tape == NULL)
+    {
+      for(int j = 0 ; j < n ; j++)
+      {
+        IntervalVector y = eval_box(IntervalVector(1, Interval(v_t[j])));
+        for(int i = 0 ; i < m ; i++)
+          v_y[i*n+j] = y[i].mid(); // /!\ an approximation is made here
+      }
+      return;
+    }
+
+    const int block_size = 256;
+    vector<double> v_x, v_values;
+
+    for(int j0 = 0 ; j0 < n ; j0 += block_size)
+    {
+      int b = std::min(block_size, n - j0);
+      v_x.assign(v_t.begin() + j0, v_t.begin() + j0 + b);
+      m_tape->eval(v_x, b, v_values);
+
+      for(int i = 0 ; i < m ; i++)
+      {
+        const double *values = &v_values[m_tape->output_node(i)*b];
+        for(int k = 0 ; k < b ; k++)
+          v_y[i*n+j0+k] = values[k];
+      }
+    }
+  }
+
+  double TFunction::eval_point(double t, int i) const
+  {
+    assert(nb_var() == 0 && "function's inputs must be limited to system variable");
+    assert(i >= 0 && i < image_dim());
+
+    if(m_tape == NULL)
+      return eval_box(IntervalVector(1, Interval(t)))[i].mid(); // /!\ an approximation is made here
+
+    const int stack_size = 64; // nodes of usual expressions
+    double stack_values[stack_size];
+    vector<double> v_values;
+
+    double *values = stack_values;
+    if(m_tape->nb_nodes() > stack_size)
+    {
+      v_values.resize(m_tape->nb_nodes());
+      values = v_values.data();
+    }
+
+    m_tape->eval(&t, 1, values);
+    return values[m_tape->output_node(i)];
+  }
+
+  const IntervalVector TFunction::eval_box(const IntervalVector& box) const
+  {
+    if(m_tape == NULL)
+      return m_ibex_f->eval_vector(box);
+
+    vector<Interval> v_x(box.size()), v_values;
+    for(int i = 0 ; i < box.size() ; i++)
+      v_x[i] = box[i];
+
+    m_tape->eval(v_x, 1, v_values);
+
+    IntervalVector y(image_dim());
+    for(int i = 0 ; i < image_dim() ; i++)
+      y[i] = v_values[m_tape->output_node(i)];
+    return y;
+  }
+
+  void TFunction::eval_slices_by_blocks(const TubeVector& x, TubeVector& y) const
+  {
+    assert(is_compiled());
+    assert(x.nb_slices() == y.nb_slices());
+
+    // The envelopes and input gates of a block of slices are evaluated at once,
+    // variable by variable: t first, then the components of x
+
+    const int block_size = 256;
+    const int n = x.size() + 1, m = y.size();
+
+    vector<const Slice*> v_sx(n-1), v_block_x((n-1)*block_size);
+    vector<Slice*> v_sy(m), v_block_y(m*block_size);
+    vector<Interval> v_x(2*n*block_size), v_values;
+
+    for(int i = 0 ; i < n-1 ; i++)
+      v_sx[i] = x[i].first_slice();
+    for(int i = 0 ; i < m ; i++)
+      v_sy[i] = y[i].first_slice();
+
+    bool last_block = false;
+
+    while(!last_block)
+    {
+      int nb_slices = 0;
+
+      while(nb_slices < block_size && !last_block)
+      {
+        for(int i = 0 ; i < n-1 ; i++)
+          v_block_x[i*block_size+nb_slices] = v_sx[i];
+        for(int i = 0 ; i < m ; i++)
+          v_block_y[i*block_size+nb_slices] = v_sy[i];
+        nb_slices++;
+
+        if(v_sx[0]->next_slice() == NULL)
+          last_block = true;
+
+        else
+        {
+          for(int i = 0 ; i < n-1 ; i++)
+            v_sx[i] = v_sx[i]->next_slice();
+          for(int i = 0 ; i < m ; i++)
+            v_sy[i] = v_sy[i]->next_slice();
+        }
+      }
+
+      int b = 2*nb_slices; // envelopes, then input gates
+
+      for(int k = 0 ; k < nb_slices ; k++)
+      {
+        v_x[k] = v_block_x[k]->tdomain();
+        v_x[nb_slices+k] = v_block_x[k]->tdomain().lb();
+
+        for(int i = 1 ; i < n ; i++)
+        {
+          v_x[i*b+k] = v_block_x[(i-1)*block_size+k]->codomain();
+          v_x[i*b+nb_slices+k] = v_block_x[(i-1)*block_size+k]->input_gate();
+        }
+      }
+
+      m_tape->eval(v_x, b, v_values);
+
+      for(int i = 0 ; i < m ; i++)
+      {
+        const Interval *values = &v_values[m_tape->output_node(i)*b];
+        for(int k = 0 ; k < nb_slices ; k++)
+        {
+          v_block_y[i*block_size+k]->set_envelope(values[k], false);
+          v_block_y[i*block_size+k]->set_input_gate(values[nb_slices+k], false);
+        }
+      }
+    }
+
+    // Output gate of the last slices
+
+    IntervalVector box(n);
+    box[0] = v_sx[0]->tdomain().ub();
+    for(int i = 1 ; i < n ; i++)
+      box[i] = v_sx[i-1]->output_gate();
+
+    IntervalVector result = eval_box(box);
+    for(int i = 0 ; i < m ; i++)
+      v_sy[i]->set_output_gate(result[i], false);
+  }
+}
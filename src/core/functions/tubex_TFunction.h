@@ -14,6 +14,7 @@
 #include <string>
 #include "ibex_Function.h"
 #include "tubex_TFnc.h"
+#include "tubex_FunctionTape.h"
 #include "tubex_Trajectory.h"
 #include "tubex_TrajectoryVector.h"
 
@@ -59,7 +60,8 @@ namespace tubex
       const ibex::Interval eval(const ibex::Interval& t, const TubeVector& x) const;
 
       const TubeVector eval_vector(const TubeVector& x) const;
-      const TrajectoryVector traj_eval_vector(const TrajectoryVector& x) const;
+      // shared_time_axis: result stored on a shared time axis, see TrajectoryVector::share_time_axis()
+      const TrajectoryVector traj_eval_vector(const TrajectoryVector& x, bool shared_time_axis = false) const;
       const ibex::IntervalVector eval_vector(const ibex::Interval& t) const;
       const ibex::IntervalVector eval_vector(const ibex::IntervalVector& x) const;
       const ibex::IntervalVector eval_vector(int slice_id, const TubeVector& x) const;
@@ -67,11 +69,31 @@ namespace tubex
 
       const TFunction diff() const;
 
+      // Compiles the expression into a flat sequence of interval operations
+      // (see FunctionTape): evaluations no longer walk the IBEX expression tree,
+      // and tubes are evaluated by blocks of slices. The interval arithmetic of
+      // IBEX is kept, the results are identical. Returns false (the IBEX
+      // evaluator being kept) if the expression involves non-scalar operations.
+      bool compile();
+      bool is_compiled() const;
+
+      // Floating-point evaluations of a function of t only, at several times:
+      // the i-th component at v_t[j] is v_y[i*v_t.size()+j]. Not reliable, but
+      // much faster than interval evaluations once compiled (sampling, display)
+      void eval_points(const std::vector<double>& v_t, std::vector<double>& v_y) const;
+
+      // Same floating-point evaluation of the i-th component at one time,
+      // without heap allocation for small compiled expressions
+      double eval_point(double t, int i = 0) const;
+
     protected:
 
       void construct_from_array(int n, const char** x, const char* y);
+      const ibex::IntervalVector eval_box(const ibex::IntervalVector& box) const;
+      void eval_slices_by_blocks(const TubeVector& x, TubeVector& y) const;
 
       ibex::Function *m_ibex_f = NULL;
+      FunctionTape *m_tape = NULL; // compiled expression, if any
       std::string m_expr; // stored here because impossible to get this value from ibex::Function
   };
 }
@@ -0,0 +1,138 @@
+/** 
+ *  Zonotope class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "tubex_Zonotope.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  // Definition
+
+  Zonotope::Zonotope(const IntervalVector& box)
+    : m_center(box)
+  {
+
+  }
+
+  Zonotope::Zonotope(const IntervalVector& center, const vector<Vector>& v_generators)
+    : m_center(center), m_v_generators(v_generators)
+  {
+    #ifdef DEBUG
+    for(const auto& g : v_generators)
+      assert(g.size() == center.size());
+    #endif
+  }
+
+  // Accessing values
+
+  int Zonotope::size() const
+  {
+    return m_center.size();
+  }
+
+  int Zonotope::nb_generators() const
+  {
+    return m_v_generators.size();
+  }
+
+  const IntervalVector& Zonotope::center() const
+  {
+    return m_center;
+  }
+
+  const vector<Vector>& Zonotope::generators() const
+  {
+    return m_v_generators;
+  }
+
+  const IntervalVector Zonotope::box() const
+  {
+    if(is_empty())
+      return m_center;
+
+    IntervalVector box(m_center);
+    for(const auto& g : m_v_generators)
+      for(int i = 0 ; i < size() ; i++)
+        box[i] += Interval(-1.,1.) * g[i];
+    return box;
+  }
+
+  // Tests
+
+  bool Zonotope::is_empty() const
+  {
+    return m_center.is_empty();
+  }
+
+  bool Zonotope::is_unbounded() const
+  {
+    return m_center.is_unbounded();
+  }
+
+  // Setting values
+
+  void Zonotope::set_empty()
+  {
+    m_center.set_empty();
+    m_v_generators.clear();
+  }
+
+  const Zonotope& Zonotope::reduce(size_t max_generators)
+  {
+    if(m_v_generators.size() <= max_generators || is_empty())
+      return *this;
+
+    // Girard's method: the generators g minimizing |g|_1-|g|_inf are
+    // the closest to axis-aligned segments, that the center box encloses well
+
+    vector<pair<double,size_t> > v_scores;
+    for(size_t j = 0 ; j < m_v_generators.size() ; j++)
+    {
+      double norm1 = 0., norm_inf = 0.;
+      for(int i = 0 ; i < size() ; i++)
+      {
+        norm1 += fabs(m_v_generators[j][i]);
+        norm_inf = std::max(norm_inf, fabs(m_v_generators[j][i]));
+      }
+      v_scores.push_back(make_pair(norm1 - norm_inf, j));
+    }
+
+    sort(v_scores.begin(), v_scores.end());
+
+    vector<bool> v_removed(m_v_generators.size(), false);
+    for(size_t k = 0 ; k < m_v_generators.size() - max_generators ; k++)
+    {
+      const Vector& g = m_v_generators[v_scores[k].second];
+      for(int i = 0 ; i < size() ; i++)
+        m_center[i] += Interval(-1.,1.) * g[i];
+      v_removed[v_scores[k].second] = true;
+    }
+
+    vector<Vector> v_generators;
+    for(size_t j = 0 ; j < m_v_generators.size() ; j++)
+      if(!v_removed[j])
+        v_generators.push_back(m_v_generators[j]);
+    m_v_generators = v_generators;
+
+    return *this;
+  }
+
+  // String
+
+  ostream& operator<<(ostream& str, const Zonotope& z)
+  {
+    str << "zonotope: center=" << z.m_center << ", " << z.m_v_generators.size() << " generators";
+    return str;
+  }
+}
@@ -0,0 +1,87 @@
+/** 
+ *  \file
+ *  Zonotope class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_ZONOTOPE_H__
+#define __TUBEX_ZONOTOPE_H__
+
+#include <vector>
+#include "ibex_Vector.h"
+#include "ibex_IntervalVector.h"
+
+namespace tubex
+{
+  /**
+   * \class Zonotope
+   * \brief n-dimensional zonotope \f$[\mathbf{c}]+\sum_j\mathbf{g}_j\varepsilon_j,\ \varepsilon_j\in[-1,1]\f$
+   *
+   * The center is a box: it encloses the rounding errors, the generators
+   * removed by order reductions, and possibly unbounded components.
+   */
+  class Zonotope
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+        explicit Zonotope(const ibex::IntervalVector& box);
+        Zonotope(const ibex::IntervalVector& center, const std::vector<ibex::Vector>& v_generators);
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+        int size() const;
+        int nb_generators() const;
+        const ibex::IntervalVector& center() const;
+        const std::vector<ibex::Vector>& generators() const;
+        const ibex::IntervalVector box() const;
+
+      /// @}
+      /// \name Tests
+      /// @{
+
+        bool is_empty() const;
+        bool is_unbounded() const;
+
+      /// @}
+      /// \name Setting values
+      /// @{
+
+        void set_empty();
+
+        /**
+         * \brief Limits the number of generators (order reduction)
+         *
+         * \note The generators that are the closest to an axis-aligned segment
+         *       are removed and enclosed in the center box
+         *
+         * \param max_generators maximum number of generators to be kept
+         * \return a reference to this zonotope
+         */
+        const Zonotope& reduce(std::size_t max_generators);
+
+      /// @}
+      /// \name String
+      /// @{
+
+        friend std::ostream& operator<<(std::ostream& str, const Zonotope& z);
+
+      /// @}
+
+    protected:
+
+      ibex::IntervalVector m_center; //!< center box
+      std::vector<ibex::Vector> m_v_generators; //!< generators, of same size as the center
+  };
+}
+
+#endif
@@ -463,44 +463,53 @@ namespace tubex
 
     // Two display modes available:
     // - one by Fnc
-    // - one by map<double,double>
+    // - one by sampled values
 
     vector<double> v_x, v_y;
 
     if(traj->definition_type() == TrajDefnType::MAP_OF_VALUES)
     {
-      typename map<double,double>::const_iterator it_scalar_values;
-      for(it_scalar_values = traj->sampled_map().begin(); it_scalar_values != traj->sampled_map().end(); it_scalar_values++)
+      const vector<double>& v_t = traj->sampled_times();
+      const vector<double>& v_values = traj->sampled_values();
+
+      for(size_t k = 0 ; k < v_t.size() ; k++)
       {
         if(m_map_trajs[traj].points_size != 0.)
-          draw_point(Point(it_scalar_values->first, it_scalar_values->second), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
+          draw_point(Point(v_t[k], v_values[k]), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
 
         else
         {
-          v_x.push_back(it_scalar_values->first);
-          v_y.push_back(it_scalar_values->second);
+          v_x.push_back(v_t[k]);
+          v_y.push_back(v_values[k]);
         }
 
-        viewbox[0] |= it_scalar_values->first;
-        viewbox[1] |= it_scalar_values->second;
+        viewbox[0] |= v_t[k];
+        viewbox[1] |= v_values[k];
       }
     }
 
     else
     {
+      vector<double> v_t;
       for(double t = traj->tdomain().lb() ; t <= traj->tdomain().ub() ; t+=traj->tdomain().diam()/TRAJ_NB_DISPLAYED_POINTS)
+        v_t.push_back(t);
+
+      // All the points are evaluated at once
+      vector<double> v_values = traj->sample_values(v_t);
+
+      for(size_t j = 0 ; j < v_t.size() ; j++)
       {
         if(m_map_trajs[traj].points_size != 0.)
-          draw_point(Point(t, (*traj)(t)), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
+          draw_point(Point(v_t[j], v_values[j]), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
 
         else
         {
-          v_x.push_back(t);
-          v_y.push_back((*traj)(t));
+          v_x.push_back(v_t[j]);
+          v_y.push_back(v_values[j]);
         }
 
-        viewbox[0] |= t;
-        viewbox[1] |= (*traj)(t);
+        viewbox[0] |= v_t[j];
+        viewbox[1] |= v_values[j];
       }
     }
 
@@ -0,0 +1,448 @@
+/** 
+ *  MappedFile class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef _WIN32 // POSIX memory mapping (mmap), not available under Windows
+
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tubex_MappedFile.h"
+#include "tubex_serialize_tubes.h"
+#include "tubex_Exception.h"
+#include "tubex_Tube.h"
+#include "tubex_TubeVector.h"
+#include "tubex_Trajectory.h"
+#include "tubex_TrajectoryVector.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace tubex
+{
+  #define MAPPED_FILE_ALIGNMENT 64
+
+  /**
+   * \struct MappedFileHeader
+   * \brief First 64 bytes of a columnar binary file
+   */
+  struct MappedFileHeader
+  {
+    char magic[8]; //!< "TUBEXMAP"
+    uint32_t version; //!< format version, see MAPPED_FILE_VERSION
+    uint32_t type; //!< 0 for tubes, 1 for trajectories
+    uint64_t size; //!< dimension
+    uint64_t length; //!< number of slices or samples
+    uint64_t nb_columns; //!< number of columns
+    uint64_t columns_offset; //!< offset of the column table
+    uint64_t unused[2];
+  };
+
+  static const char MAPPED_FILE_MAGIC[8] = { 'T', 'U', 'B', 'E', 'X', 'M', 'A', 'P' };
+
+  static size_t aligned_size(size_t nb_bytes)
+  {
+    return (nb_bytes + MAPPED_FILE_ALIGNMENT - 1) / MAPPED_FILE_ALIGNMENT * MAPPED_FILE_ALIGNMENT;
+  }
+
+  // Definition
+
+  MappedFile::MappedFile(const string& file_name)
+  {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if(fd < 0)
+      throw Exception(__func__, "unable to open file " + file_name);
+
+    struct stat file_stat;
+    if(fstat(fd, &file_stat) != 0 || file_stat.st_size < (off_t)sizeof(MappedFileHeader))
+    {
+      close(fd);
+      throw Exception(__func__, "not a columnar binary file: " + file_name);
+    }
+
+    m_data_size = file_stat.st_size;
+    // Read-only and private mapping: the pages are loaded on demand
+    m_data = mmap(NULL, m_data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(m_data == MAP_FAILED)
+    {
+      m_data = NULL;
+      throw Exception(__func__, "unable to map file " + file_name);
+    }
+
+    // Checking the header and the column table
+
+    MappedFileHeader header;
+    memcpy(&header, m_data, sizeof(MappedFileHeader));
+    string error;
+
+    if(memcmp(header.magic, MAPPED_FILE_MAGIC, 8) != 0)
+      error = "not a columnar binary file";
+
+    else if(header.version != MAPPED_FILE_VERSION)
+      error = "columnar file version not supported";
+
+    // (sizes bounded by the file size before any product, against overflows)
+    else if(header.type > 1 || header.size < 1 || header.length < 1
+      || header.size > m_data_size / (8 * sizeof(uint64_t)) // 4 table entries per component, at most
+      || header.length > m_data_size / sizeof(double) // at least one column of length values
+      || header.nb_columns != (header.type == 0 ? 1 + 4 * header.size : 1 + header.size)
+      || header.columns_offset % MAPPED_FILE_ALIGNMENT != 0
+      || header.columns_offset > m_data_size
+      || 2 * header.nb_columns * sizeof(uint64_t) > m_data_size - header.columns_offset)
+      error = "corrupted columnar file header";
+
+    else
+    {
+      m_is_tube = header.type == 0;
+      m_n = header.size;
+      m_length = header.length;
+      m_nb_columns = header.nb_columns;
+      m_columns_table = (const uint64_t*)((const char*)m_data + header.columns_offset);
+
+      for(size_t j = 0 ; j < m_nb_columns && error.empty() ; j++)
+      {
+        uint64_t offset = m_columns_table[2*j], nb_values = m_columns_table[2*j+1];
+
+        // Tubes: N+1 tdomains bounds, then (N, N, N+1, N+1) values per component
+        uint64_t expected_nb_values = m_length;
+        if(m_is_tube && (j == 0 || (j - 1) % 4 >= 2))
+          expected_nb_values++;
+
+        if(nb_values != expected_nb_values || offset % MAPPED_FILE_ALIGNMENT != 0
+          || offset > m_data_size || nb_values * sizeof(double) > m_data_size - offset)
+          error = "corrupted columnar file table";
+      }
+    }
+
+    if(!error.empty())
+    {
+      munmap(m_data, m_data_size);
+      m_data = NULL;
+      throw Exception(__func__, error + ": " + file_name);
+    }
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if(m_data != NULL)
+      munmap(m_data, m_data_size);
+  }
+
+  bool MappedFile::is_tube() const
+  {
+    return m_is_tube;
+  }
+
+  int MappedFile::size() const
+  {
+    return m_n;
+  }
+
+  size_t MappedFile::nb_slices() const
+  {
+    assert(m_is_tube);
+    return m_length;
+  }
+
+  size_t MappedFile::nb_samples() const
+  {
+    assert(!m_is_tube);
+    return m_length;
+  }
+
+  const Interval MappedFile::tdomain() const
+  {
+    const double *t = times();
+    return Interval(t[0], t[m_is_tube ? m_length : m_length - 1]);
+  }
+
+  // Columns (no copy)
+
+  const double* MappedFile::times() const
+  {
+    return column(0);
+  }
+
+  const double* MappedFile::envelope_lb(int i) const
+  {
+    assert(m_is_tube);
+    assert(i >= 0 && i < m_n);
+    return column(1 + 4*i);
+  }
+
+  const double* MappedFile::envelope_ub(int i) const
+  {
+    assert(m_is_tube);
+    assert(i >= 0 && i < m_n);
+    return column(2 + 4*i);
+  }
+
+  const double* MappedFile::gate_lb(int i) const
+  {
+    assert(m_is_tube);
+    assert(i >= 0 && i < m_n);
+    return column(3 + 4*i);
+  }
+
+  const double* MappedFile::gate_ub(int i) const
+  {
+    assert(m_is_tube);
+    assert(i >= 0 && i < m_n);
+    return column(4 + 4*i);
+  }
+
+  const double* MappedFile::values(int i) const
+  {
+    assert(!m_is_tube);
+    assert(i >= 0 && i < m_n);
+    return column(1 + i);
+  }
+
+  // Building objects
+
+  const Tube MappedFile::tube(int i, const Interval& t) const
+  {
+    assert(m_is_tube);
+    assert(i >= 0 && i < m_n);
+
+    size_t k0, k1;
+    items_range(t, k0, k1);
+
+    Tube x;
+    tube_from_columns(x, times(), envelope_lb(i), envelope_ub(i), gate_lb(i), gate_ub(i), k0, k1);
+    return x;
+  }
+
+  const TubeVector MappedFile::tube_vector(const Interval& t) const
+  {
+    assert(m_is_tube);
+
+    size_t k0, k1;
+    items_range(t, k0, k1);
+
+    TubeVector x;
+    x.m_n = m_n;
+    x.m_v_tubes = new Tube[m_n];
+    for(int i = 0 ; i < m_n ; i++)
+      tube_from_columns(x.m_v_tubes[i], times(), envelope_lb(i), envelope_ub(i), gate_lb(i), gate_ub(i), k0, k1);
+    return x;
+  }
+
+  const Trajectory MappedFile::trajectory(int i, const Interval& t) const
+  {
+    assert(!m_is_tube);
+    assert(i >= 0 && i < m_n);
+
+    size_t k0, k1;
+    items_range(t, k0, k1);
+
+    const double *v_t = times(), *v_y = values(i);
+    return Trajectory(vector<double>(v_t + k0, v_t + k1), vector<double>(v_y + k0, v_y + k1));
+  }
+
+  const TrajectoryVector MappedFile::trajectory_vector(const Interval& t) const
+  {
+    assert(!m_is_tube);
+
+    size_t k0, k1;
+    items_range(t, k0, k1);
+
+    const double *v_t = times();
+    vector<double> v_values((k1 - k0) * m_n);
+    for(int i = 0 ; i < m_n ; i++)
+    {
+      const double *v_y = values(i);
+      for(size_t k = k0 ; k < k1 ; k++)
+        v_values[(k - k0) * m_n + i] = v_y[k];
+    }
+
+    return TrajectoryVector(m_n, vector<double>(v_t + k0, v_t + k1), v_values);
+  }
+
+  // Writing files
+
+  void MappedFile::write(const string& file_name, const Tube& x)
+  {
+    write_tubes(file_name, vector<const Tube*>(1, &x));
+  }
+
+  void MappedFile::write(const string& file_name, const TubeVector& x)
+  {
+    vector<const Tube*> v_x;
+    for(int i = 0 ; i < x.size() ; i++)
+      v_x.push_back(&x[i]);
+    write_tubes(file_name, v_x);
+  }
+
+  void MappedFile::write(const string& file_name, const Trajectory& x)
+  {
+    write_trajectories(file_name, vector<const Trajectory*>(1, &x));
+  }
+
+  void MappedFile::write(const string& file_name, const TrajectoryVector& x)
+  {
+    vector<Trajectory> v_components; // copies of the columns, on a shared time axis
+    if(x.time_axis_shared())
+      for(int i = 0 ; i < x.size() ; i++)
+        v_components.push_back(x.component(i));
+
+    vector<const Trajectory*> v_x;
+    for(int i = 0 ; i < x.size() ; i++)
+      v_x.push_back(x.time_axis_shared() ? &v_components[i] : &x[i]);
+    write_trajectories(file_name, v_x);
+  }
+
+  // Protected methods
+
+  const double* MappedFile::column(size_t j) const
+  {
+    assert(m_data != NULL);
+    assert(j < m_nb_columns);
+    return (const double*)((const char*)m_data + m_columns_table[2*j]);
+  }
+
+  void MappedFile::items_range(const Interval& t, size_t& k0, size_t& k1) const
+  {
+    const double *v_t = times();
+
+    if(m_is_tube) // slices [v_t[k],v_t[k+1]] intersecting t
+    {
+      k0 = lower_bound(v_t + 1, v_t + m_length + 1, t.lb()) - (v_t + 1);
+      k1 = upper_bound(v_t, v_t + m_length, t.ub()) - v_t;
+    }
+
+    else // samples v_t[k] inside t
+    {
+      k0 = lower_bound(v_t, v_t + m_length, t.lb()) - v_t;
+      k1 = upper_bound(v_t, v_t + m_length, t.ub()) - v_t;
+    }
+
+    if(t.is_empty() || k0 >= k1)
+      throw Exception(__func__, "no data in the temporal window");
+  }
+
+  void MappedFile::write_tubes(const string& file_name, const vector<const Tube*>& v_x)
+  {
+    assert(!v_x.empty());
+    size_t nb_slices = v_x[0]->nb_slices();
+
+    for(size_t i = 1 ; i < v_x.size() ; i++)
+      if(!Tube::same_slicing(*v_x[0], *v_x[i]))
+        throw Exception(__func__, "components with different slicings");
+
+    ofstream bin_file(file_name.c_str(), ios::out | ios::binary);
+    if(!bin_file.is_open())
+      throw Exception(__func__, "unable to open file " + file_name);
+
+    vector<size_t> v_lengths(1, nb_slices + 1);
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+    {
+      v_lengths.push_back(nb_slices);
+      v_lengths.push_back(nb_slices);
+      v_lengths.push_back(nb_slices + 1);
+      v_lengths.push_back(nb_slices + 1);
+    }
+
+    write_header(bin_file, 0, v_x.size(), nb_slices, v_lengths);
+
+    // Each column is gathered in one buffer, reused from one column to another
+    vector<double> v_col, v_col2;
+
+    tube_tdomains_column(*v_x[0], v_col);
+    write_column(bin_file, v_col);
+
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+    {
+      tube_envelopes_columns(*v_x[i], v_col, v_col2);
+      write_column(bin_file, v_col);
+      write_column(bin_file, v_col2);
+
+      tube_gates_columns(*v_x[i], v_col, v_col2);
+      write_column(bin_file, v_col);
+      write_column(bin_file, v_col2);
+    }
+
+    bin_file.close();
+  }
+
+  void MappedFile::write_trajectories(const string& file_name, const vector<const Trajectory*>& v_x)
+  {
+    assert(!v_x.empty());
+
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+    {
+      if(v_x[i]->definition_type() == TrajDefnType::ANALYTIC_FNC)
+        throw Exception(__func__, "Fnc serialization not implemented");
+
+      if(v_x[i]->sampled_times() != v_x[0]->sampled_times())
+        throw Exception(__func__, "components not sampled at the same times");
+    }
+
+    size_t nb_samples = v_x[0]->sampled_times().size();
+    if(nb_samples == 0)
+      throw Exception(__func__, "empty trajectory");
+
+    ofstream bin_file(file_name.c_str(), ios::out | ios::binary);
+    if(!bin_file.is_open())
+      throw Exception(__func__, "unable to open file " + file_name);
+
+    write_header(bin_file, 1, v_x.size(), nb_samples, vector<size_t>(1 + v_x.size(), nb_samples));
+
+    // The flat arrays of the trajectories are written as they are
+    write_column(bin_file, v_x[0]->sampled_times());
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+      write_column(bin_file, v_x[i]->sampled_values());
+
+    bin_file.close();
+  }
+
+  void MappedFile::write_header(ofstream& bin_file, uint32_t type, int n, size_t length, const vector<size_t>& v_lengths)
+  {
+    MappedFileHeader header;
+    memset(&header, 0, sizeof(MappedFileHeader));
+    memcpy(header.magic, MAPPED_FILE_MAGIC, 8);
+    header.version = MAPPED_FILE_VERSION;
+    header.type = type;
+    header.size = n;
+    header.length = length;
+    header.nb_columns = v_lengths.size();
+    header.columns_offset = aligned_size(sizeof(MappedFileHeader));
+
+    vector<uint64_t> v_table(2 * v_lengths.size(), 0);
+    uint64_t offset = header.columns_offset + aligned_size(v_table.size() * sizeof(uint64_t));
+    for(size_t j = 0 ; j < v_lengths.size() ; j++)
+    {
+      v_table[2*j] = offset;
+      v_table[2*j+1] = v_lengths[j];
+      offset += aligned_size(v_lengths[j] * sizeof(double));
+    }
+
+    bin_file.write((const char*)&header, sizeof(MappedFileHeader));
+
+    // Table padded to the first column
+    v_table.resize(aligned_size(v_table.size() * sizeof(uint64_t)) / sizeof(uint64_t), 0);
+    bin_file.write((const char*)v_table.data(), v_table.size() * sizeof(uint64_t));
+  }
+
+  void MappedFile::write_column(ofstream& bin_file, const vector<double>& v_values)
+  {
+    size_t nb_bytes = v_values.size() * sizeof(double);
+    bin_file.write((const char*)v_values.data(), nb_bytes);
+
+    static const char padding[MAPPED_FILE_ALIGNMENT] = { 0 };
+    bin_file.write(padding, aligned_size(nb_bytes) - nb_bytes);
+  }
+}
+
+#endif
@@ -0,0 +1,338 @@
+/** 
+ *  \file
+ *  MappedFile class
+ * ----------------------------------------------------------------------------
+ *  \date       2020
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2020 Simon Rohou
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __TUBEX_MAPPEDFILE_H__
+#define __TUBEX_MAPPEDFILE_H__
+
+#ifndef _WIN32 // POSIX memory mapping (mmap), not available under Windows
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "ibex_Interval.h"
+
+namespace tubex
+{
+  #define MAPPED_FILE_VERSION 1
+
+  class Tube;
+  class TubeVector;
+  class Trajectory;
+  class TrajectoryVector;
+
+  /**
+   * \class MappedFile
+   * \brief Read-only access to a columnar binary file of tubes or trajectories,
+   *        mapped in memory: only the columns are read without copy
+   *
+   * Contrary to the streamed serialization (see serialize_Tube()), the data
+   * are stored column by column, so that the file can be mapped in memory
+   * (mmap): opening a file is immediate whatever its size, and only the pages
+   * actually accessed are loaded by the system.
+   *
+   * Only the columns (times(), envelope_lb(), values(), etc.) are zero-copy
+   * views of the file. The Tube, TubeVector, Trajectory and TrajectoryVector
+   * objects built by tube(), trajectory(), etc. are copies: restrict them to a
+   * temporal window to copy only the related part of the file.
+   *
+   * Columnar binary structure (version 1), all the fields being aligned on 64 bytes: <br>
+   *   [header: char_magic[8], uint32_version, uint32_type, uint64_size,
+   *            uint64_length, uint64_nb_columns, uint64_columns_offset, 16 unused bytes] <br>
+   *   [column table: (uint64_offset, uint64_nb_values) for each column] <br>
+   *   [column_0] <br>
+   *   ... <br>
+   *   [column_m]
+   *
+   * For a TubeVector of dimension \f$n\f$ with \f$N\f$ slices, the first column
+   * contains the \f$N+1\f$ bounds of the slices' tdomains, followed for each
+   * component by four columns: envelope lb, envelope ub (\f$N\f$ values),
+   * gate lb, gate ub (\f$N+1\f$ values). Empty sets are stored as NaN bounds
+   * (see interval_bounds()).
+   *
+   * For a TrajectoryVector of dimension \f$n\f$ sampled at \f$N\f$ times (shared
+   * by all the components), the first column contains the times, followed by
+   * one column of values for each component.
+   *
+   * \note Not available under Windows (POSIX memory mapping)
+   */
+  class MappedFile
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Maps a columnar binary file in memory
+       *
+       * \param file_name path to the binary file
+       */
+      explicit MappedFile(const std::string& file_name);
+
+      /**
+       * \brief MappedFile destructor, unmaps the file
+       */
+      ~MappedFile();
+
+      /**
+       * \brief Returns true if the file contains tubes, false for trajectories
+       *
+       * \return true in case of tubes
+       */
+      bool is_tube() const;
+
+      /**
+       * \brief Returns the dimension of the stored tube or trajectory
+       *
+       * \return n
+       */
+      int size() const;
+
+      /**
+       * \brief Returns the number of slices of the stored tube
+       *
+       * \return the number of slices
+       */
+      size_t nb_slices() const;
+
+      /**
+       * \brief Returns the number of samples of the stored trajectory
+       *
+       * \return the number of samples
+       */
+      size_t nb_samples() const;
+
+      /**
+       * \brief Returns the temporal domain \f$[t_0,t_f]\f$ of the stored data
+       *
+       * \return the tdomain
+       */
+      const ibex::Interval tdomain() const;
+
+      /// @}
+      /// \name Columns (no copy)
+      /// @{
+
+      /**
+       * \brief Returns the times of the stored data
+       *
+       * \note For tubes, the \f$N+1\f$ bounds of the slices' tdomains.
+       *       For trajectories, the \f$N\f$ sampled times.
+       *
+       * \return a pointer to the mapped column
+       */
+      const double* times() const;
+
+      /**
+       * \brief Returns the lower bounds of the slices' envelopes of a component
+       *
+       * \param i the index of the component
+       * \return a pointer to the mapped column (\f$N\f$ values)
+       */
+      const double* envelope_lb(int i = 0) const;
+
+      /**
+       * \brief Returns the upper bounds of the slices' envelopes of a component
+       *
+       * \param i the index of the component
+       * \return a pointer to the mapped column (\f$N\f$ values)
+       */
+      const double* envelope_ub(int i = 0) const;
+
+      /**
+       * \brief Returns the lower bounds of the gates of a component
+       *
+       * \param i the index of the component
+       * \return a pointer to the mapped column (\f$N+1\f$ values)
+       */
+      const double* gate_lb(int i = 0) const;
+
+      /**
+       * \brief Returns the upper bounds of the gates of a component
+       *
+       * \param i the index of the component
+       * \return a pointer to the mapped column (\f$N+1\f$ values)
+       */
+      const double* gate_ub(int i = 0) const;
+
+      /**
+       * \brief Returns the sampled values of a component of the stored trajectory
+       *
+       * \param i the index of the component
+       * \return a pointer to the mapped column (\f$N\f$ values)
+       */
+      const double* values(int i = 0) const;
+
+      /// @}
+      /// \name Building objects (copies)
+      /// @{
+
+      /**
+       * \brief Creates a copy of a component of the stored tube
+       *
+       * Only the slices intersecting the temporal window are read and copied.
+       *
+       * \param i the index of the component
+       * \param t optional temporal window (the whole tdomain by default)
+       * \return the Tube object
+       */
+      const Tube tube(int i = 0, const ibex::Interval& t = ibex::Interval::ALL_REALS) const;
+
+      /**
+       * \brief Creates a copy of the stored tube
+       *
+       * \param t optional temporal window (the whole tdomain by default)
+       * \return the TubeVector object
+       */
+      const TubeVector tube_vector(const ibex::Interval& t = ibex::Interval::ALL_REALS) const;
+
+      /**
+       * \brief Creates a copy of a component of the stored trajectory
+       *
+       * Only the samples inside the temporal window are read and copied.
+       *
+       * \param i the index of the component
+       * \param t optional temporal window (the whole tdomain by default)
+       * \return the Trajectory object
+       */
+      const Trajectory trajectory(int i = 0, const ibex::Interval& t = ibex::Interval::ALL_REALS) const;
+
+      /**
+       * \brief Creates a copy of the stored trajectory, on a shared time axis
+       *
+       * \param t optional temporal window (the whole tdomain by default)
+       * \return the TrajectoryVector object
+       */
+      const TrajectoryVector trajectory_vector(const ibex::Interval& t = ibex::Interval::ALL_REALS) const;
+
+      /// @}
+      /// \name Writing files
+      /// @{
+
+      /**
+       * \brief Writes a Tube object into a columnar binary file
+       *
+       * \param file_name path to the binary file
+       * \param x the Tube object to be written
+       */
+      static void write(const std::string& file_name, const Tube& x);
+
+      /**
+       * \brief Writes a TubeVector object into a columnar binary file
+       *
+       * \note All the components must share the same slicing
+       *
+       * \param file_name path to the binary file
+       * \param x the TubeVector object to be written
+       */
+      static void write(const std::string& file_name, const TubeVector& x);
+
+      /**
+       * \brief Writes a sampled Trajectory object into a columnar binary file
+       *
+       * \param file_name path to the binary file
+       * \param x the Trajectory object to be written
+       */
+      static void write(const std::string& file_name, const Trajectory& x);
+
+      /**
+       * \brief Writes a sampled TrajectoryVector object into a columnar binary file
+       *
+       * \note All the components must be sampled at the same times
+       *
+       * \param file_name path to the binary file
+       * \param x the TrajectoryVector object to be written
+       */
+      static void write(const std::string& file_name, const TrajectoryVector& x);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Copy constructor, not allowed (the mapping is owned by this object)
+       */
+      MappedFile(const MappedFile& x);
+
+      /**
+       * \brief Assignment, not allowed (the mapping is owned by this object)
+       */
+      MappedFile& operator=(const MappedFile& x);
+
+      /**
+       * \brief Returns a column of the file
+       *
+       * \param j the index of the column
+       * \return a pointer to the mapped column
+       */
+      const double* column(size_t j) const;
+
+      /**
+       * \brief Returns the range of slices or samples related to a temporal window
+       *
+       * \param t the temporal window
+       * \param k0 the first index to be set
+       * \param k1 the index after the last one, to be set
+       */
+      void items_range(const ibex::Interval& t, size_t& k0, size_t& k1) const;
+
+      /**
+       * \brief Writes scalar tubes sharing the same slicing into a columnar binary file
+       *
+       * \param file_name path to the binary file
+       * \param v_x the components
+       */
+      static void write_tubes(const std::string& file_name, const std::vector<const Tube*>& v_x);
+
+      /**
+       * \brief Writes scalar trajectories sampled at the same times into a columnar binary file
+       *
+       * \param file_name path to the binary file
+       * \param v_x the components
+       */
+      static void write_trajectories(const std::string& file_name, const std::vector<const Trajectory*>& v_x);
+
+      /**
+       * \brief Writes the header and the column table of a file
+       *
+       * The columns are then expected in the same order, see write_column().
+       *
+       * \param bin_file binary file (ofstream object)
+       * \param type 0 for tubes, 1 for trajectories
+       * \param n the dimension
+       * \param length the number of slices or samples
+       * \param v_lengths the number of values of each column
+       */
+      static void write_header(std::ofstream& bin_file, uint32_t type, int n, size_t length, const std::vector<size_t>& v_lengths);
+
+      /**
+       * \brief Writes a column in one call, padded to the next 64 bytes boundary
+       *
+       * \param bin_file binary file (ofstream object)
+       * \param v_values the values of the column
+       */
+      static void write_column(std::ofstream& bin_file, const std::vector<double>& v_values);
+
+      // Class variables:
+
+        void *m_data = NULL; //!< mapped memory
+        size_t m_data_size = 0; //!< size in bytes of the mapped file
+        bool m_is_tube = true; //!< type of the stored data
+        int m_n = 0; //!< dimension
+        size_t m_length = 0; //!< number of slices or samples
+        size_t m_nb_columns = 0; //!< number of columns
+        const uint64_t *m_columns_table = NULL; //!< (offset, number of values) of each column
+  };
+}
+
+#endif
+#endif
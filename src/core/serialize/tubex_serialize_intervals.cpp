@@ -8,6 +8,8 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cmath>
+#include <limits>
 #include "tubex_serialize_intervals.h"
 #include "tubex_Exception.h"
 
@@ -110,4 +112,24 @@ namespace tubex
     for(int i = 0 ; i < size ; i++)
       deserialize_Interval(bin_file, box[i]);
   }
+
+  void interval_bounds(const Interval& intv, double& lb, double& ub)
+  {
+    if(intv.is_empty())
+      lb = ub = numeric_limits<double>::quiet_NaN();
+
+    else
+    {
+      lb = intv.lb();
+      ub = intv.ub();
+    }
+  }
+
+  const Interval interval_from_bounds(double lb, double ub)
+  {
+    if(std::isnan(lb) || std::isnan(ub))
+      return Interval::EMPTY_SET;
+
+    return Interval(lb, ub);
+  }
 }
\ No newline at end of file
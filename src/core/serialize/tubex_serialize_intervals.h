@@ -76,6 +76,31 @@ namespace tubex
    * \param box IntervalVector object to be deserialized
    */
   void serialize_IntervalVector(std::ofstream& bin_file, const ibex::IntervalVector& box);
+
+  /// @}
+  /// \name Bounds (columnar formats)
+  /// @{
+
+  /**
+   * \brief Returns the two bounds of an Interval, to be stored in separate columns
+   *
+   * Unbounded intervals keep their infinite bounds. The empty set
+   * is represented by two quiet NaN values.
+   *
+   * \param intv the Interval object
+   * \param lb the lower bound to be set
+   * \param ub the upper bound to be set
+   */
+  void interval_bounds(const ibex::Interval& intv, double& lb, double& ub);
+
+  /**
+   * \brief Creates an Interval object from the bounds returned by interval_bounds()
+   *
+   * \param lb the lower bound
+   * \param ub the upper bound
+   * \return the related Interval object
+   */
+  const ibex::Interval interval_from_bounds(double lb, double ub);
   
   /// @}
 }
@@ -37,19 +37,31 @@ namespace tubex
       case 2:
       {
         // Points number
-        int pts_number = traj.sampled_map().size();
+        int pts_number = traj.sampled_times().size();
         bin_file.write((const char*)&pts_number, sizeof(int));
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = traj.sampled_map().begin() ; it_map != traj.sampled_map().end() ; it_map++)
+        for(int i = 0 ; i < pts_number ; i++)
         {
-          bin_file.write((const char*)&it_map->first, sizeof(double));
-          bin_file.write((const char*)&it_map->second, sizeof(double));
+          bin_file.write((const char*)&traj.sampled_times()[i], sizeof(double));
+          bin_file.write((const char*)&traj.sampled_values()[i], sizeof(double));
         }
 
         break;
       }
 
+      case 3:
+      {
+        // Points number
+        int pts_number = traj.sampled_times().size();
+        bin_file.write((const char*)&pts_number, sizeof(int));
+
+        // The flat arrays are written as two columns
+        bin_file.write((const char*)traj.sampled_times().data(), pts_number * sizeof(double));
+        bin_file.write((const char*)traj.sampled_values().data(), pts_number * sizeof(double));
+
+        break;
+      }
+
       default:
         throw Exception(__func__, "unhandled case");
     }
@@ -89,6 +101,32 @@ namespace tubex
         break;
       }
 
+      case 3:
+      {
+        // Points number
+        int pts_number;
+        bin_file.read((char*)&pts_number, sizeof(int));
+
+        if(pts_number < 0)
+          throw Exception(__func__, "wrong points number");
+
+        if(pts_number == 0)
+        {
+          traj = new Trajectory();
+          break;
+        }
+
+        vector<double> v_t(pts_number), v_y(pts_number);
+        bin_file.read((char*)v_t.data(), pts_number * sizeof(double));
+        bin_file.read((char*)v_y.data(), pts_number * sizeof(double));
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        traj = new Trajectory(v_t, v_y);
+        break;
+      }
+
       default:
         throw Exception(__func__, "deserialization version number not supported");
     }
@@ -102,7 +140,12 @@ namespace tubex
     short int size = traj.size();
     bin_file.write((const char*)&size, sizeof(short int));
     for(int i = 0 ; i < size ; i++)
-      serialize_Trajectory(bin_file, traj[i], version_number);
+    {
+      if(traj.time_axis_shared())
+        serialize_Trajectory(bin_file, traj.component(i), version_number);
+      else
+        serialize_Trajectory(bin_file, traj[i], version_number);
+    }
   }
 
   void deserialize_TrajectoryVector(ifstream& bin_file, TrajectoryVector *&traj)
@@ -23,18 +23,21 @@ namespace tubex
   /// @{
 
   /**
-   * \brief Writes a Trajectory object into a binary file
+   * \brief Writes a Trajectory object into a binary file (version 3)
    * 
    * Trajectory binary structure: <br>
    *   [short_int_version_number] <br>
    *   [int_nb_points] <br>
    *   [double_t_pt1] <br>
-   *   [double_y_pt1] <br>
    *   [double_t_pt2] <br>
+   *   ... <br>
+   *   [double_y_pt1] <br>
    *   [double_y_pt2] <br>
-   *   [double_t_pt3] <br>
    *   ...
    *
+   * Each column (times, values) is written in one call.
+   * In version 2, the pairs (t,y) were written one after the other.
+   *
    * \note Only map valued trajectories are serializable
    *
    * \param bin_file binary file (ofstream object)
@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <vector>
 #include "tubex_serialize_tubes.h"
 #include "tubex_serialize_intervals.h"
 #include "tubex_Exception.h"
@@ -62,6 +63,35 @@ namespace tubex
         break;
       }
 
+      case 3:
+      {
+        // Version number for compliance purposes
+        bin_file.write((const char*)&version_number, sizeof(short int));
+
+        // Slices number
+        int slices_number = tube.nb_slices();
+        bin_file.write((const char*)&slices_number, sizeof(int));
+
+        // Each column is gathered in one buffer and written in one call
+        vector<double> v_col, v_col2;
+
+        // Domains
+        tube_tdomains_column(tube, v_col);
+        bin_file.write((const char*)v_col.data(), v_col.size() * sizeof(double));
+
+        // Codomains
+        tube_envelopes_columns(tube, v_col, v_col2);
+        bin_file.write((const char*)v_col.data(), v_col.size() * sizeof(double));
+        bin_file.write((const char*)v_col2.data(), v_col2.size() * sizeof(double));
+
+        // Gates
+        tube_gates_columns(tube, v_col, v_col2);
+        bin_file.write((const char*)v_col.data(), v_col.size() * sizeof(double));
+        bin_file.write((const char*)v_col2.data(), v_col2.size() * sizeof(double));
+
+        break;
+      }
+
       default:
         throw Exception(__func__, "unhandled case");
     }
@@ -153,6 +183,46 @@ namespace tubex
         break;
       }
 
+      case 3:
+      {
+        // Slices number
+        int slices_number;
+        bin_file.read((char*)&slices_number, sizeof(int));
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        // The count is checked against the length of the stream before any
+        // allocation: 5*slices_number+3 values (tdomains, envelopes, gates)
+
+        streampos pos = bin_file.tellg();
+        bin_file.seekg(0, ios::end);
+        size_t nb_values = (bin_file.tellg() - pos) / sizeof(double); // remaining values
+        bin_file.seekg(pos);
+
+        if(slices_number < 1 || nb_values < 3 || (size_t)slices_number > (nb_values - 3) / 5)
+          throw Exception(__func__, "wrong slices number");
+
+        // Columns, each one read in one call
+        vector<double> v_t(slices_number + 1);
+        vector<double> v_lb(slices_number), v_ub(slices_number);
+        vector<double> v_glb(slices_number + 1), v_gub(slices_number + 1);
+        bin_file.read((char*)v_t.data(), (slices_number + 1) * sizeof(double));
+        bin_file.read((char*)v_lb.data(), slices_number * sizeof(double));
+        bin_file.read((char*)v_ub.data(), slices_number * sizeof(double));
+        bin_file.read((char*)v_glb.data(), (slices_number + 1) * sizeof(double));
+        bin_file.read((char*)v_gub.data(), (slices_number + 1) * sizeof(double));
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        // Creating slices
+        tube = new Tube();
+        tube_from_columns(*tube, v_t.data(), v_lb.data(), v_ub.data(), v_glb.data(), v_gub.data(), 0, slices_number);
+
+        break;
+      }
+
       default:
         throw Exception(__func__, "deserialization version number not supported");
     }
@@ -190,4 +260,64 @@ namespace tubex
       delete ptr;
     }
   }
+
+  void tube_tdomains_column(const Tube& tube, vector<double>& v_t)
+  {
+    v_t.resize(tube.nb_slices() + 1);
+    size_t k = 0;
+    for(const Slice *s = tube.first_slice() ; s != NULL ; s = s->next_slice())
+      v_t[k++] = s->tdomain().lb();
+    v_t[k] = tube.tdomain().ub();
+  }
+
+  void tube_envelopes_columns(const Tube& tube, vector<double>& v_lb, vector<double>& v_ub)
+  {
+    v_lb.resize(tube.nb_slices());
+    v_ub.resize(tube.nb_slices());
+    size_t k = 0;
+    for(const Slice *s = tube.first_slice() ; s != NULL ; s = s->next_slice(), k++)
+      interval_bounds(s->codomain(), v_lb[k], v_ub[k]);
+  }
+
+  void tube_gates_columns(const Tube& tube, vector<double>& v_lb, vector<double>& v_ub)
+  {
+    v_lb.resize(tube.nb_slices() + 1);
+    v_ub.resize(tube.nb_slices() + 1);
+    interval_bounds(tube.first_slice()->input_gate(), v_lb[0], v_ub[0]);
+    size_t k = 1;
+    for(const Slice *s = tube.first_slice() ; s != NULL ; s = s->next_slice(), k++)
+      interval_bounds(s->output_gate(), v_lb[k], v_ub[k]);
+  }
+
+  void tube_from_columns(Tube& tube, const double *v_t, const double *v_lb, const double *v_ub,
+                         const double *v_glb, const double *v_gub, size_t k0, size_t k1)
+  {
+    assert(tube.m_first_slice == NULL);
+    assert(k0 < k1);
+
+    Slice *prev_slice = NULL;
+    for(size_t k = k0 ; k < k1 ; k++)
+    {
+      Slice *slice = new Slice(Interval(v_t[k], v_t[k+1]));
+
+      if(prev_slice == NULL)
+      {
+        tube.m_first_slice = slice;
+        slice->set_input_gate(interval_from_bounds(v_glb[k], v_gub[k]), false);
+      }
+
+      else
+      {
+        delete slice->m_input_gate;
+        slice->m_input_gate = NULL;
+        Slice::chain_slices(prev_slice, slice);
+      }
+
+      slice->set_envelope(interval_from_bounds(v_lb[k], v_ub[k]), false);
+      slice->set_output_gate(interval_from_bounds(v_glb[k+1], v_gub[k+1]), false);
+      prev_slice = slice;
+    }
+
+    tube.m_tdomain = Interval(v_t[k0], v_t[k1]); // redundant information for fast access
+  }
 }
\ No newline at end of file
@@ -13,10 +13,11 @@
 #define __TUBEX_SERIALIZ_TUBES_H__
 
 #include <fstream>
+#include <vector>
 
 namespace tubex
 {
-  #define SERIALIZATION_VERSION 2
+  #define SERIALIZATION_VERSION 3
 
   class Tube;
   class TubeVector;
@@ -25,22 +26,29 @@ namespace tubex
   /// @{
 
   /**
-   * \brief Writes a Tube object into a binary file (version 2)
+   * \brief Writes a Tube object into a binary file (version 3)
    * 
    * Tube binary structure: <br>
    *   [short_int_version_number] <br>
    *   [int_nb_slices] <br>
    *   [double_t0] <br>
    *   [double_t1] // time input shared by 1rst and 2nd slices <br>
-   *   [double_t2] <br>
    *   ... <br>
-   *   [interval_y0] // value of 1rst slice <br>
-   *   [interval_y1] <br>
+   *   [double_y0_lb] // lower bound of the value of 1rst slice <br>
+   *   [double_y1_lb] <br>
    *   ... <br>
-   *   [gate_t0] // value of 1rst gate <br>
-   *   [gate_t1] <br>
+   *   [double_y0_ub] <br>
+   *   ... <br>
+   *   [double_gate_t0_lb] // lower bound of the value of 1rst gate <br>
+   *   ... <br>
+   *   [double_gate_t0_ub] <br>
    *   ...
    *
+   * Each column is gathered in a buffer and written in one call. The bounds
+   * are stored as given by interval_bounds() (NaN values for empty sets).
+   * In version 2, each value was written separately by serialize_Interval();
+   * this format can still be read by deserialize_Tube().
+   *
    * \param bin_file binary file (ofstream object)
    * \param tube Tube object to be serialized
    * \param version_number optional version number for tests purposes (backwards compatibility)
@@ -85,7 +93,59 @@ namespace tubex
    * \param tube TubeVector object to be deserialized
    */
   void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
-  
+
+  /// @}
+  /// \name Columns (columnar formats)
+  /// @{
+
+  /**
+   * \brief Gathers the \f$N+1\f$ bounds of the slices' tdomains of a Tube object
+   *
+   * \param tube the Tube object
+   * \param v_t the column to be set (resized)
+   */
+  void tube_tdomains_column(const Tube& tube, std::vector<double>& v_t);
+
+  /**
+   * \brief Gathers the bounds of the \f$N\f$ slices' envelopes of a Tube object
+   *
+   * \note The bounds are given by interval_bounds() (NaN values for empty sets)
+   *
+   * \param tube the Tube object
+   * \param v_lb the column of lower bounds to be set (resized)
+   * \param v_ub the column of upper bounds to be set (resized)
+   */
+  void tube_envelopes_columns(const Tube& tube, std::vector<double>& v_lb, std::vector<double>& v_ub);
+
+  /**
+   * \brief Gathers the bounds of the \f$N+1\f$ gates of a Tube object
+   *
+   * \note The bounds are given by interval_bounds() (NaN values for empty sets)
+   *
+   * \param tube the Tube object
+   * \param v_lb the column of lower bounds to be set (resized)
+   * \param v_ub the column of upper bounds to be set (resized)
+   */
+  void tube_gates_columns(const Tube& tube, std::vector<double>& v_lb, std::vector<double>& v_ub);
+
+  /**
+   * \brief Builds the slices \f$k_0\f$ to \f$k_1-1\f$ of an undefined Tube object from columns
+   *
+   * The columns are indexed as the ones gathered by tube_tdomains_column(),
+   * tube_envelopes_columns() and tube_gates_columns().
+   *
+   * \param tube the Tube object to be built (without slices)
+   * \param v_t the bounds of the slices' tdomains
+   * \param v_lb the lower bounds of the slices' envelopes
+   * \param v_ub the upper bounds of the slices' envelopes
+   * \param v_glb the lower bounds of the gates
+   * \param v_gub the upper bounds of the gates
+   * \param k0 the first slice
+   * \param k1 the index after the last slice
+   */
+  void tube_from_columns(Tube& tube, const double *v_t, const double *v_lb, const double *v_ub,
+                         const double *v_glb, const double *v_gub, size_t k0, size_t k1);
+
   /// @}
 }
 
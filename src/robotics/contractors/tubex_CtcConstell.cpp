@@ -9,25 +9,33 @@
  */
 
 #include <list>
+#include <algorithm>
 #include "tubex_CtcConstell.h"
+#include "tubex_Exception.h"
 
 using namespace std;
 using namespace ibex;
 
 namespace tubex
 {
-  CtcConstell::CtcConstell(const vector<IntervalVector>& map)
-    : Ctc(2), m_map(map)
+  CtcConstell::CtcConstell(const vector<IntervalVector>& map, int dim)
+    : Ctc(dim), m_map(map), m_dim(dim)
   {
-    // todo: binary tree for logarithmic complexity
-  }
+    if(dim != 2 && dim != 3)
+      throw Exception(__func__, "the dimension of the contractor must be 2 or 3");
 
-  CtcConstell::CtcConstell(const list<IntervalVector>& map)
-    : Ctc(2)
-  {
-    for(const auto& b : map)
-      m_map.push_back(b);
-    // todo: binary tree for logarithmic complexity
+    for(const auto& mj : m_map)
+      if(mj.size() < dim)
+        throw Exception(__func__, "landmarks must have at least dim components");
+
+    if(!m_map.empty())
+    {
+      for(size_t i = 0 ; i < m_map.size() ; i++)
+        m_v_ids.push_back(i);
+
+      m_v_nodes.reserve(2*m_map.size()/m_leaf_size + 1);
+      build_tree(0, m_map.size()-1);
+    }
   }
 
   CtcConstell::~CtcConstell()
@@ -37,11 +45,85 @@ namespace tubex
 
   void CtcConstell::contract(IntervalVector &a)
   {
-    assert(a.size() == 2);
-    IntervalVector union_result(2, Interval::EMPTY_SET);
+    assert(a.size() == 2 || a.size() == m_dim);
+    IntervalVector union_result(a.size(), Interval::EMPTY_SET);
+
+    if(m_v_nodes.empty() || a.is_empty())
+    {
+      a = union_result;
+      return;
+    }
+
+    auto intersects = [&a](const IntervalVector& b)
+    {
+      for(int i = 0 ; i < a.size() ; i++)
+        if(!a[i].intersects(b[i]))
+          return false;
+      return true;
+    };
+
+    // Depth-first range query, stopped as soon as the
+    // union covers the box (it cannot be more contracted)
+
+    vector<int> v_stack(1, 0);
+    while(!v_stack.empty() && union_result != a)
+    {
+      const Node& node = m_v_nodes[v_stack.back()];
+      v_stack.pop_back();
+
+      if(!intersects(node.box))
+        continue;
+
+      if(node.left == -1) // leaf
+      {
+        for(int k = node.first ; k <= node.last ; k++)
+        {
+          const IntervalVector& mj = m_map[m_v_ids[k]];
+          if(intersects(mj))
+            union_result |= a & mj.subvector(0,a.size()-1);
+        }
+      }
+
+      else
+      {
+        v_stack.push_back(node.right);
+        v_stack.push_back(node.left);
+      }
+    }
 
-    for(const auto mj : m_map)
-      union_result |= a & mj.subvector(0,1);
     a = union_result;
   }
-}
\ No newline at end of file
+
+  int CtcConstell::build_tree(int first, int last)
+  {
+    Node node = { IntervalVector(m_dim, Interval::EMPTY_SET), first, last, -1, -1 };
+
+    for(int k = first ; k <= last ; k++)
+      node.box |= m_map[m_v_ids[k]].subvector(0,m_dim-1);
+
+    int id = m_v_nodes.size();
+    m_v_nodes.push_back(node);
+
+    if(last - first + 1 > m_leaf_size)
+    {
+      // Median split along the largest dimension of the box of the centers
+
+      IntervalVector centers(m_dim, Interval::EMPTY_SET);
+      for(int k = first ; k <= last ; k++)
+        centers |= IntervalVector(m_map[m_v_ids[k]].subvector(0,m_dim-1).mid());
+      int axis = centers.extr_diam_index(false);
+
+      int mid = (first + last) / 2;
+      nth_element(m_v_ids.begin() + first, m_v_ids.begin() + mid, m_v_ids.begin() + last + 1,
+        [this,axis](int i, int j) { return m_map[i][axis].mid() < m_map[j][axis].mid(); });
+
+      int left = build_tree(first, mid);
+      int right = build_tree(mid + 1, last);
+
+      m_v_nodes[id].left = left; // m_v_nodes may have been reallocated
+      m_v_nodes[id].right = right;
+    }
+
+    return id;
+  }
+}
@@ -20,19 +20,74 @@ namespace tubex
   /**
    * \brief CtcConstell class.
    *
+   * Contracts a box to the landmarks of a map it may correspond to.
+   * Landmarks are indexed by a bounding volume hierarchy (binary tree of boxes)
+   * built at construction: a contraction only visits the parts of the map
+   * that intersect the box.
    */
   class CtcConstell : public ibex::Ctc
   {
     public:
 
-      CtcConstell(const std::vector<ibex::IntervalVector>& map);
-      CtcConstell(const std::list<ibex::IntervalVector>& map);
+      /**
+       * \brief Creates the contractor and indexes the map
+       *
+       * \note By default, only the first two components of the landmarks
+       *       are considered, even for 3d landmarks
+       *
+       * \param map the landmarks, as 2d or 3d boxes
+       * \param dim number of variables of the contractor (2 or 3),
+       *        landmarks must have at least `dim` components
+       */
+      CtcConstell(const std::vector<ibex::IntervalVector>& map, int dim = 2);
+
+      /**
+       * \brief Creates the contractor and indexes the map
+       *
+       * \param map the landmarks, as 2d or 3d boxes
+       * \param dim number of variables of the contractor (2 or 3),
+       *        landmarks must have at least `dim` components
+       */
+      CtcConstell(const std::list<ibex::IntervalVector>& map, int dim = 2)
+        : CtcConstell(std::vector<ibex::IntervalVector>(map.begin(), map.end()), dim) { }
+
       ~CtcConstell();
+
+      /**
+       * \brief Contracts the box to the hull of its intersections with the landmarks
+       *
+       * \note With a 3d contractor, a 2d box is compared to the first two components
+       *       of the landmarks
+       *
+       * \param beacon_box the box to be contracted, of dimension 2 or nb_var
+       */
       void contract(ibex::IntervalVector &beacon_box);
 
     protected:
 
-      std::vector<ibex::IntervalVector> m_map;
+      /**
+       * \brief Builds the subtree related to the landmarks m_v_ids[first..last]
+       *
+       * \return the index of the root node of the subtree
+       */
+      int build_tree(int first, int last);
+
+      /**
+       * \struct Node
+       * \brief Node of the bounding volume hierarchy
+       */
+      struct Node
+      {
+        ibex::IntervalVector box; //!< hull of the landmarks of the subtree
+        int first, last; //!< range of the landmarks in m_v_ids
+        int left, right; //!< indexes of the children in m_v_nodes, or -1 for leaves
+      };
+
+      std::vector<ibex::IntervalVector> m_map; //!< landmarks
+      std::vector<int> m_v_ids; //!< landmarks ids, ordered along the leaves of the tree
+      std::vector<Node> m_v_nodes; //!< nodes of the tree, the root being the first one
+      int m_dim; //!< number of indexed components (2 or 3)
+      static const int m_leaf_size = 8; //!< maximum number of landmarks in a leaf
   };
 }
 
@@ -94,6 +94,7 @@ namespace tubex
          + vyr * (cos(psi) * cos(phi) + sin(theta) * sin(psi) * sin(phi)) \
          - vzr * (cos(psi) * sin(phi) - sin(theta) * cos(phi) * sin(psi)) ; \
          - vxr * sin(theta) + vyr * cos(theta)*sin(phi) + vzr * cos(theta) * cos(phi))");
+      f.compile(); // flat evaluation of the slices
       TubeVector velocities = f.eval_vector(*x);
 
       // Horizontal position
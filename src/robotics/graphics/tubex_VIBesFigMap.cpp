@@ -412,13 +412,29 @@ namespace tubex
       if(m_map_trajs[traj].color_map.second != NULL)
         traj_colormap = m_map_trajs[traj].color_map.second;
 
-    if((*traj)[index_x].definition_type() == TrajDefnType::MAP_OF_VALUES
-        && (*traj)[index_x].sampled_map().size() != 0)
+    // Components (copied from the matrix on a shared time axis)
+
+      Trajectory shared_x, shared_y;
+      const Trajectory *traj_x = &shared_x, *traj_y = &shared_y;
+      if(traj->time_axis_shared())
+      {
+        shared_x = traj->component(index_x);
+        shared_y = traj->component(index_y);
+      }
+
+      else
+      {
+        traj_x = &(*traj)[index_x];
+        traj_y = &(*traj)[index_y];
+      }
+
+    if(traj_x->definition_type() == TrajDefnType::MAP_OF_VALUES
+        && !traj_x->sampled_times().empty())
     {
       const Trajectory *displayed_traj_x, *displayed_traj_y;
       Trajectory *temp_displayed_traj_x = NULL, *temp_displayed_traj_y = NULL; // possibly used in case of heavy trajectories
 
-      if((*traj)[index_x].sampled_map().size() > m_traj_max_nb_disp_points) // heavy trajectories
+      if(traj_x->sampled_times().size() > m_traj_max_nb_disp_points) // heavy trajectories
       {
         // Computing a trajectory less discretized
         
@@ -427,8 +443,8 @@ namespace tubex
 
           for(double t = traj->tdomain().lb() ; t <= traj->tdomain().ub() ; t+=traj->tdomain().diam()/m_traj_max_nb_disp_points)
           {
-            temp_displayed_traj_x->set((*traj)[index_x](t), t);
-            temp_displayed_traj_y->set((*traj)[index_y](t), t);
+            temp_displayed_traj_x->set((*traj_x)(t), t);
+            temp_displayed_traj_y->set((*traj_y)(t), t);
           }
 
         displayed_traj_x = temp_displayed_traj_x;
@@ -438,37 +454,34 @@ namespace tubex
       else
       {
         // We will display the actual trajectories, entirely
-        displayed_traj_x = &(*traj)[index_x];
-        displayed_traj_y = &(*traj)[index_y];
+        displayed_traj_x = traj_x;
+        displayed_traj_y = traj_y;
       }
 
-      typename map<double,double>::const_iterator it_scalar_values_x, it_scalar_values_y;
-      it_scalar_values_x = displayed_traj_x->sampled_map().begin();
-      it_scalar_values_y = displayed_traj_y->sampled_map().begin();
+      const vector<double>& v_t = displayed_traj_x->sampled_times();
+      const vector<double>& v_values_x = displayed_traj_x->sampled_values();
+      const vector<double>& v_values_y = displayed_traj_y->sampled_values();
 
-      while(it_scalar_values_x != displayed_traj_x->sampled_map().end())
+      for(size_t k = 0 ; k < v_t.size() ; k++)
       {
-        if(m_restricted_tdomain.contains(it_scalar_values_x->first))
+        if(m_restricted_tdomain.contains(v_t[k]))
         {
           if(points_size != 0.)
-            vibes::drawPoint(it_scalar_values_x->second, it_scalar_values_y->second,
+            vibes::drawPoint(v_values_x[k], v_values_y[k],
                              points_size,
                              vibesParams("figure", name(), "group", group_name));
 
           else
           {
-            v_x.push_back(it_scalar_values_x->second);
-            v_y.push_back(it_scalar_values_y->second);
+            v_x.push_back(v_values_x[k]);
+            v_y.push_back(v_values_y[k]);
             if(m_map_trajs[traj].color == "")
-              v_colors.push_back(rgb2hex(m_map_trajs[traj].color_map.first.color(it_scalar_values_x->first, *traj_colormap)));
+              v_colors.push_back(rgb2hex(m_map_trajs[traj].color_map.first.color(v_t[k], *traj_colormap)));
           }
         }
 
-        viewbox[0] |= Interval(it_scalar_values_x->second);
-        viewbox[1] |= Interval(it_scalar_values_y->second);
-
-        it_scalar_values_x++;
-        it_scalar_values_y++;
+        viewbox[0] |= Interval(v_values_x[k]);
+        viewbox[1] |= Interval(v_values_y[k]);
       }
 
       if(temp_displayed_traj_x != NULL)
@@ -482,8 +495,8 @@ namespace tubex
     {
       for(double t = traj->tdomain().lb() ; t <= traj->tdomain().ub() ; t+=traj->tdomain().diam()/m_traj_max_nb_disp_points)
       {
-        double x = (*traj)[index_x](t);
-        double y = (*traj)[index_y](t);
+        double x = (*traj_x)(t);
+        double y = (*traj_y)(t);
 
         viewbox[0] |= x;
         viewbox[1] |= y;
@@ -712,8 +725,9 @@ namespace tubex
     assert(traj->tdomain().contains(t));
 
     Vector pose(3);
-    pose[0] = (*traj)[m_map_trajs[traj].index_x](t);
-    pose[1] = (*traj)[m_map_trajs[traj].index_y](t);
+    const Vector x_t = (*traj)(t);
+    pose[0] = x_t[m_map_trajs[traj].index_x];
+    pose[1] = x_t[m_map_trajs[traj].index_y];
     pose[2] = heading(t, traj);
 
     draw_vehicle(pose, params, size);
@@ -769,8 +783,9 @@ namespace tubex
     vibes::newGroup("obs", DEFAULT_OBS_COLOR, vibesParams("figure", name()));
 
     Vector pose(3);
-    pose[0] = (*traj)[m_map_trajs[traj].index_x](obs[0].mid());
-    pose[1] = (*traj)[m_map_trajs[traj].index_y](obs[0].mid());
+    const Vector x_t = (*traj)(obs[0].mid());
+    pose[0] = x_t[m_map_trajs[traj].index_x];
+    pose[1] = x_t[m_map_trajs[traj].index_y];
     pose[2] = heading(obs[0].mid(), traj);
 
     draw_observation(obs.subvector(1,2), pose, color, params);
@@ -788,11 +803,12 @@ namespace tubex
       else
         next_t = t + delta_t;
 
-      double robot_next_x = (*traj)[m_map_trajs.at(traj).index_x](next_t);
-      double robot_next_y = (*traj)[m_map_trajs.at(traj).index_y](next_t);
+      const Vector x_next_t = (*traj)(next_t), x_t = (*traj)(t);
+      double robot_next_x = x_next_t[m_map_trajs.at(traj).index_x];
+      double robot_next_y = x_next_t[m_map_trajs.at(traj).index_y];
 
-      double robot_x = (*traj)[m_map_trajs.at(traj).index_x](t);
-      double robot_y = (*traj)[m_map_trajs.at(traj).index_y](t);
+      double robot_x = x_t[m_map_trajs.at(traj).index_x];
+      double robot_y = x_t[m_map_trajs.at(traj).index_y];
       double robot_heading = std::atan2(robot_y - robot_next_y, robot_x - robot_next_x);
 
       if(next_t > t)
@@ -803,9 +819,9 @@ namespace tubex
 
     else
     {
-      assert((*traj)[m_map_trajs.at(traj).index_heading].tdomain() == (*traj)[m_map_trajs.at(traj).index_x].tdomain());
-      assert((*traj)[m_map_trajs.at(traj).index_heading].tdomain().contains(t));
-      return (*traj)[m_map_trajs.at(traj).index_heading](t);
+      assert(traj->same_tdomain_forall_components());
+      assert(traj->tdomain().contains(t));
+      return (*traj)(t)[m_map_trajs.at(traj).index_heading];
     }
   }
 }
\ No newline at end of file
@@ -140,7 +140,7 @@ namespace tubex
     traj.set(0., box()[0].lb());
     traj.set(0., box()[0].ub());
     traj.sample(m_precision);
-    const map<double,double> map_values = traj.sampled_map();
+    const vector<double> v_t = traj.sampled_times(); // copy: the keys are then set in traj
 
     // Detected loops: value set to 1
     for(size_t i = 0 ; i < m_v_detected_loops.size() ; i++)
@@ -148,14 +148,14 @@ namespace tubex
       for(int j = 0 ; j < 2 ; j++)
       {
         double t = m_v_detected_loops[i].box()[j].lb();
-        typename map<double,double>::const_iterator it = map_values.lower_bound(t);
+        vector<double>::const_iterator it = lower_bound(v_t.begin(), v_t.end(), t);
 
-        if(it->first != t && it != map_values.begin())
+        if((it == v_t.end() || *it != t) && it != v_t.begin())
           it--;
 
-        while(it != map_values.end() && it->first <= m_v_detected_loops[i].box()[j].ub())
+        while(it != v_t.end() && *it <= m_v_detected_loops[i].box()[j].ub())
         {
-          traj.set(1., it->first);
+          traj.set(1., *it);
           it++;
         }
       }
@@ -167,14 +167,14 @@ namespace tubex
       for(int j = 0 ; j < 2 ; j++)
       {
         double t = m_v_proven_loops[i].box()[j].lb();
-        typename map<double,double>::const_iterator it = map_values.lower_bound(t);
+        vector<double>::const_iterator it = lower_bound(v_t.begin(), v_t.end(), t);
 
-        if(it->first != t && it != map_values.begin())
+        if((it == v_t.end() || *it != t) && it != v_t.begin())
           it--;
 
-        while(it != map_values.end() && it->first <= m_v_proven_loops[i].box()[j].ub())
+        while(it != v_t.end() && *it <= m_v_proven_loops[i].box()[j].ub())
         {
-          traj.set(2., it->first);
+          traj.set(2., *it);
           it++;
         }
       }
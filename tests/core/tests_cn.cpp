@@ -1,8 +1,13 @@
+#include <thread>
 #include "catch_interval.hpp"
 #include "tubex_ContractorNetwork.h"
+#include "tubex_Contractor.h"
 #include "tubex_CtcDeriv.h"
 #include "tubex_CtcEval.h"
 #include "tubex_CtcFunction.h"
+#include "tubex_CtcPicard.h"
+#include "tubex_CtcStatic.h"
+#include "tubex_predef_contractors.h"
 #include "vibes.h"
 
 using namespace Catch;
@@ -241,6 +246,76 @@ TEST_CASE("CN simple")
     CHECK(a == Interval(1,4));
   }
 
+  SECTION("CtcFunction on tubes, batched contractions")
+  {
+    // Reference: each envelope and gate is contracted as a box by CtcFwdBwd,
+    // all the slices being read before being set (as for one block of slices)
+    auto contract_boxes = [](CtcFunction& ctc, TubeVector& x)
+    {
+      int n = x.size(), nb_slices = x.nb_slices();
+      vector<IntervalVector> v_envelopes(nb_slices, IntervalVector(n)), v_ingates(nb_slices, IntervalVector(n));
+
+      for(int k = 0 ; k < nb_slices ; k++)
+        for(int i = 0 ; i < n ; i++)
+        {
+          v_envelopes[k][i] = x[i].slice(k)->codomain();
+          v_ingates[k][i] = x[i].slice(k)->input_gate();
+        }
+
+      for(int k = 0 ; k < nb_slices ; k++)
+      {
+        ctc.contract(v_envelopes[k]);
+        ctc.contract(v_ingates[k]);
+      }
+
+      for(int k = 0 ; k < nb_slices ; k++)
+        for(int i = 0 ; i < n ; i++)
+        {
+          x[i].slice(k)->set_envelope(v_envelopes[k][i]);
+          x[i].slice(k)->set_input_gate(v_ingates[k][i]);
+        }
+
+      IntervalVector outgate(n);
+      for(int i = 0 ; i < n ; i++)
+        outgate[i] = x[i].last_slice()->output_gate();
+      ctc.contract(outgate);
+      for(int i = 0 ; i < n ; i++)
+        x[i].last_slice()->set_output_gate(outgate[i]);
+    };
+
+    Interval tdomain(0.,10.);
+
+    {
+      CtcFunction ctc_f(Function("x", "y", "y-sin(x)"));
+
+      TubeVector x(tdomain, 0.1, TFunction("(t/5-1 ; sin(t))"));
+      x.inflate(0.5);
+      double volume = x.volume();
+      TubeVector x_ref(x);
+
+      ctc_f.contract(x);
+      contract_boxes(ctc_f, x_ref);
+
+      CHECK(x.volume() < volume);
+      CHECK(x == x_ref);
+    }
+
+    { // vector constraint, vector argument
+      CtcFunction ctc_f(Function("a[2]", "b", "(a[0]+a[1]-b ; sqr(a[0]-a[1]+0.5)-sqr(b-a[1]))"), IntervalVector(2, Interval(-0.1,0.1)));
+
+      TubeVector x(tdomain, 0.1, TFunction("(cos(t) ; 0.5 ; cos(t)+0.5)"));
+      x.inflate(0.2);
+      double volume = x.volume();
+      TubeVector x_ref(x);
+
+      ctc_f.contract(x);
+      contract_boxes(ctc_f, x_ref);
+
+      CHECK(x.volume() < volume);
+      CHECK(x == x_ref);
+    }
+  }
+
   SECTION("Subvector")
   {
     IntervalVector x{{0,1},{-2,3},{1,20}};
@@ -459,6 +534,507 @@ TEST_CASE("CN simple")
     //CHECK(x.codomain() == Interval(0.));
   }
 
+  SECTION("Deadline and resumed contractions")
+  {
+    double dt = 0.1;
+    Interval tdomain(0.,10.);
+    Tube x(tdomain, dt);
+    x.set(0., 0.);
+    Tube v(tdomain, dt, TFunction("0"));
+
+    ContractorNetwork cn;
+    CtcDeriv ctc_deriv;
+    cn.add(ctc_deriv, {x,v});
+    int nb_ctc = cn.nb_ctc_in_stack();
+    CHECK(nb_ctc > 0);
+
+    Deadline deadline;
+    CHECK_FALSE(deadline.expired());
+    CHECK(std::isinf(deadline.remaining_time()));
+    deadline.cancel();
+    CHECK(deadline.expired());
+
+    ContractionResult r = cn.contract(deadline);
+    CHECK_FALSE(r.completed);
+    CHECK(r.nb_ctc_in_stack == nb_ctc);
+    CHECK(x.codomain() == Interval());
+
+    // Cancelled during the contraction: the contractor yields and remains in stack
+    ctc_deriv.set_deadline(&deadline);
+    ctc_deriv.contract(x, v);
+    ctc_deriv.set_deadline(NULL);
+    CHECK(x.codomain() == Interval());
+
+    // Same for the other slice-based contractors
+    Tube y(tdomain, dt), w(tdomain, dt, TFunction("0"));
+    Interval z(1.);
+    CtcEval ctc_eval;
+    ctc_eval.set_deadline(&deadline);
+    ctc_eval.contract(5., z, y, w); // evaluation, but no propagation
+    CHECK(y(5.) == Interval(1.));
+    CHECK(y(9.) == Interval());
+
+    Tube xp(Interval(0.,1.), dt);
+    xp.set(1., 0.);
+    CtcPicard ctc_picard;
+    ctc_picard.set_deadline(&deadline);
+    ctc_picard.contract(TFunction("x", "-x"), xp, TimePropag::FORWARD);
+    CHECK(xp(0.5) == Interval());
+    ctc_picard.set_deadline(NULL);
+    ctc_picard.contract(TFunction("x", "-x"), xp, TimePropag::FORWARD);
+    CHECK_FALSE(xp(0.5).is_unbounded());
+
+    // Completion reported by the contractor, whatever the clock after the call
+    tubex::Domain dom_x(x), dom_v(v);
+    Contractor ac(ctc_deriv, { &dom_x, &dom_v });
+    CHECK_FALSE(ac.contract(&deadline)); // yields before the first slice
+    CHECK(x.codomain() == Interval());
+    Deadline unbounded;
+    CHECK(ac.contract(&unbounded));
+    CHECK(ac.contract()); // no deadline
+
+    r = cn.contract_during(POS_INFINITY);
+    CHECK(r.completed);
+    CHECK(r.nb_ctc_in_stack == 0);
+    CHECK(r.duration >= 0.);
+    CHECK(x.codomain() == Interval(0.));
+  }
+
+  SECTION("Sliding window")
+  {
+    double dt = 1.;
+    Tube x(Interval(0.,10.), dt);
+    Tube v(Interval(0.,10.), dt, TFunction("1"));
+    x.set(0., 0.);
+
+    ContractorNetwork cn;
+    CtcDeriv ctc_deriv;
+    cn.add(ctc_deriv, {x,v});
+    cn.contract();
+    CHECK(x(10.) == Interval(10.));
+    int nb_ctc = cn.nb_ctc(), nb_dom = cn.nb_dom();
+
+    CtcFunction ctc_first_slice(Function("a", "a"), Interval(0.,1.));
+    cn.add(ctc_first_slice, {*x.first_slice()}); // slice-level constraint
+    CHECK(cn.nb_ctc() == nb_ctc + 1);
+
+    cn.slide_window(4.);
+    CHECK(x.tdomain() == Interval(4.,14.));
+    CHECK(v.tdomain() == Interval(4.,14.));
+    CHECK(x.nb_slices() == 10);
+    CHECK(cn.nb_ctc() == nb_ctc); // constant size of the graph, slice-level constraint retired
+    CHECK(cn.nb_dom() == nb_dom);
+    CHECK(x(4.) == Interval(4.)); // prior at the window start
+
+    v.set(Interval(1.), Interval(10.,14.)); // new information on the derivative
+    cn.contract(); // the tube-level contractors are triggered on the recycled slices
+    CHECK(x(14.) == Interval(14.));
+
+    cn.slide_window(8., false); // without prior
+    CHECK(x.tdomain() == Interval(8.,18.));
+    CHECK(x(8.).is_superset(Interval(8.)));
+    CHECK(x(8.) != Interval(8.));
+  }
+
+  SECTION("Bulk construction")
+  {
+    CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+    int n = 50;
+
+    vector<Interval> x1(n+1, Interval(0.,100.)), y1(n, Interval(1.,2.));
+    vector<Interval> x2(x1), y2(y1);
+    x1[0] = Interval(0.); x2[0] = Interval(0.);
+
+    ContractorNetwork cn1, cn2;
+    vector<pair<Ctc*,vector<tubex::Domain> > > v_batch;
+
+    for(int i = 0 ; i < n ; i++)
+    {
+      cn1.add(ctc_plus, {x1[i], y1[i], x1[i+1]});
+      v_batch.push_back(make_pair(&ctc_plus, vector<tubex::Domain>({x2[i], y2[i], x2[i+1]})));
+    }
+
+    v_batch.push_back(v_batch.front()); // duplicated item
+    cn2.add(v_batch);
+
+    CHECK(cn1.nb_ctc() == n);
+    CHECK(cn2.nb_ctc() == cn1.nb_ctc());
+    CHECK(cn2.nb_dom() == cn1.nb_dom());
+    CHECK(cn2.nb_ctc_in_stack() == cn1.nb_ctc_in_stack());
+
+    cn1.contract();
+    cn2.contract();
+
+    for(int i = 0 ; i < n+1 ; i++)
+      CHECK(x1[i] == x2[i]);
+    CHECK(x2[1] == Interval(1.,2.));
+    CHECK(x2[n] == Interval(50.,100.));
+  }
+
+  SECTION("Saved and restored states")
+  {
+    double dt = 1.;
+    Tube x(Interval(0.,10.), dt);
+    Tube v(Interval(0.,10.), dt, TFunction("1"));
+    Interval a(0.,10.), b(-10.,10.), c(0.,2.);
+
+    ContractorNetwork cn;
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+    cn.add(ctc_deriv, {x,v});
+    cn.add(ctc_plus, {a,b,c});
+    cn.contract();
+
+    Tube x_ref(x);
+    Interval b_ref(b);
+    CHECK(cn.nb_saved_states() == 0);
+    CHECK(cn.save_state() == 1);
+
+    x.set(0., 0.);
+    a = Interval(1.); // slice setters are recorded, not this external change
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(x(10.) == Interval(10.));
+    CHECK(b == Interval(-1.,1.));
+
+    CHECK(cn.save_state() == 2); // nested checkpoint
+    b &= Interval(0.,1.);
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(c == Interval(1.,2.));
+    cn.restore_state();
+    CHECK(c == Interval(0.,2.));
+    CHECK(x(10.) == Interval(10.));
+    CHECK(cn.nb_saved_states() == 1);
+
+    cn.restore_state();
+    CHECK(cn.nb_saved_states() == 0);
+    CHECK(x == x_ref);
+    CHECK(x(10.) != Interval(10.));
+    CHECK(b == b_ref);
+    CHECK(a == Interval(1.));
+    CHECK(cn.nb_ctc_in_stack() == 0); // queue as when saved
+
+    // Contractions after a restoration are propagated as usual
+    cn.save_state();
+    x.set(0., 0.);
+    cn.trigger_all_contractors();
+    cn.contract();
+    CHECK(x(10.) == Interval(10.));
+    cn.discard_state();
+    CHECK(cn.nb_saved_states() == 0);
+    CHECK(x(10.) == Interval(10.));
+
+    // The slices of a tube record their values into one single network
+    ContractorNetwork cn2;
+    CHECK_THROWS(cn2.add(ctc_deriv, {x,v}));
+  }
+
+  SECTION("Branch and prune")
+  {
+    CtcFunction ctc_f(Function("x", "x^2-2"));
+    Interval x(-10.,10.);
+
+    ContractorNetwork cn;
+    cn.add(ctc_f, {x});
+
+    SolverResult r = cn.solve({x}, 1e-3);
+    CHECK(r.completed);
+    CHECK(r.nb_nodes > 1);
+    CHECK(r.nb_solutions >= 2);
+    CHECK(r.boxes.size() == (size_t)r.nb_solutions);
+    CHECK(r.tubes.empty());
+    CHECK(x == Interval(-10.,10.)); // initial state restored
+
+    bool pos = false, neg = false;
+    for(const auto& box : r.boxes)
+    {
+      CHECK(box.size() == 1);
+      CHECK(box[0].diam() < 1e-3);
+      pos |= box[0].contains(sqrt(2.));
+      neg |= box[0].contains(-sqrt(2.));
+    }
+    CHECK(pos);
+    CHECK(neg);
+
+    SolverResult r_best = cn.solve({x}, 1e-3, SearchStrategy::BEST_FIRST);
+    CHECK(r_best.completed);
+    CHECK(r_best.nb_solutions >= 2);
+    CHECK(x == Interval(-10.,10.));
+
+    // Independent networks on several threads
+    deque<CtcFunction> v_ctc; // one contractor per network
+    auto build = [&v_ctc](ContractorNetwork& cn_k)
+    {
+      v_ctc.emplace_back(Function("x", "x^2-2"));
+      Interval& x_k = cn_k.create_dom(Interval(-10.,10.));
+      cn_k.add(v_ctc.back(), {x_k});
+      return vector<tubex::Domain>({x_k});
+    };
+
+    SolverResult r_par = ContractorNetwork::solve(build, 2, 1e-3);
+    CHECK(v_ctc.size() == 2);
+    CHECK(r_par.completed);
+    CHECK(r_par.nb_solutions >= 2);
+    CHECK(r_par.boxes.size() == (size_t)r_par.nb_solutions);
+
+    // Bisection of the gates of a tube: constant trajectories with x^2=1
+    Tube x_tube(Interval(0.,2.), 1., Interval(-10.,10.));
+    Tube v_tube(Interval(0.,2.), 1., Interval(0.));
+    CtcDeriv ctc_deriv;
+    CtcFunction ctc_g(Function("x", "x^2-1"));
+
+    ContractorNetwork cn_tube;
+    cn_tube.add(ctc_deriv, {x_tube,v_tube});
+    cn_tube.add(ctc_g, {x_tube});
+
+    for(SearchStrategy strategy : { SearchStrategy::DEPTH_FIRST, SearchStrategy::BEST_FIRST })
+    {
+      SolverResult r_tube = cn_tube.solve({x_tube}, 1e-2, strategy);
+      CHECK(r_tube.completed);
+      CHECK(r_tube.nb_solutions >= 2);
+      CHECK(r_tube.boxes.empty());
+      CHECK(r_tube.tubes.size() == (size_t)r_tube.nb_solutions);
+      CHECK(x_tube.codomain() == Interval(-10.,10.)); // initial state restored
+
+      bool pos_tube = false, neg_tube = false;
+      for(const auto& v_sol : r_tube.tubes)
+      {
+        CHECK(v_sol.size() == 1);
+        CHECK(v_sol[0].codomain().diam() < 1e-2);
+        pos_tube |= v_sol[0].codomain().contains(1.);
+        neg_tube |= v_sol[0].codomain().contains(-1.);
+      }
+      CHECK(pos_tube);
+      CHECK(neg_tube);
+    }
+  }
+
+  SECTION("Sparse propagation on tubes")
+  {
+    double dt = 1.;
+    Interval tdomain(0.,10.);
+    Tube v(tdomain, dt, TFunction("1"));
+
+    // Contractor restricted to a temporal window of changes
+    Tube x(tdomain, dt);
+    x.set(0., 0.);
+    CtcDeriv ctc_deriv;
+    ctc_deriv.set_changed_tdomain(Interval::EMPTY_SET);
+    ctc_deriv.contract(x, v);
+    CHECK(x(10.) == Interval::ALL_REALS); // nothing has changed
+    ctc_deriv.set_changed_tdomain(Interval(0.));
+    ctc_deriv.contract(x, v);
+    CHECK(x(10.) == Interval(10.)); // propagation beyond the window
+    ctc_deriv.set_changed_tdomain(Interval::ALL_REALS);
+
+    // Dependencies of an evaluation without time propagation
+    CtcEval ctc_eval;
+    ctc_eval.enable_time_propag(false);
+    Interval t(5.);
+    tubex::Domain dom_t(t);
+    CHECK(ctc_eval.dependency_tdomain({&dom_t}) == Interval(5.));
+    ctc_eval.enable_time_propag(true);
+    CHECK(ctc_eval.dependency_tdomain({&dom_t}) == Interval::ALL_REALS);
+
+    // Same fixed point as a complete propagation
+    Tube x1(tdomain, dt), x2(tdomain, dt);
+    Interval t1(5.), z1(2.,3.), t2(5.), z2(2.,3.);
+    Interval t1b(8.), z1b(5.5,6.), t2b(8.), z2b(5.5,6.);
+
+    ContractorNetwork cn1, cn2;
+    cn1.add(ctc_deriv, {x1,v});
+    cn1.add(ctc_eval, {t1,z1,x1,v});
+    cn2.add(ctc_deriv, {x2,v});
+    cn2.add(ctc_eval, {t2,z2,x2,v});
+    cn1.contract();
+    cn2.contract();
+
+    cn1.add(ctc_eval, {t1b,z1b,x1,v}); // local changes, then sparse propagations
+    cn1.contract();
+    cn2.add(ctc_eval, {t2b,z2b,x2,v});
+    cn2.trigger_all_contractors(); // complete propagations
+    cn2.contract();
+
+    CHECK(x1(8.) == ApproxIntv(Interval(5.5,6.)));
+    CHECK(x1(0.) == ApproxIntv(Interval(-2.5,-2.)));
+    for(double ti = 0. ; ti <= 10. ; ti+=0.5)
+      CHECK(x1(ti) == ApproxIntv(x2(ti)));
+  }
+
+  SECTION("Frozen network")
+  {
+    CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+    CtcDeriv ctc_deriv;
+
+    Interval a1(0,1), b1(-1,1), c1(1.5,2), a2(a1), b2(b1), c2(c1);
+    Tube x1(Interval(0.,10.), 1.), x2(x1), v(Interval(0.,10.), 1., Interval(-1.,1.));
+    x1.set(0., 0.); x2.set(0., 0.);
+
+    ContractorNetwork cn1, cn2;
+    cn1.add(ctc_plus, {a1, b1, c1});
+    cn1.add(ctc_deriv, {x1, v});
+    cn2.add(ctc_plus, {a2, b2, c2});
+    cn2.add(ctc_deriv, {x2, v});
+
+    CHECK(!cn1.is_frozen());
+    cn1.freeze();
+    CHECK(cn1.is_frozen());
+
+    cn1.contract();
+    cn2.contract();
+
+    CHECK(a1 == a2); CHECK(b1 == b2); CHECK(c1 == c2);
+    CHECK(a1 == Interval(0.5,1));
+    CHECK(x1 == x2);
+    CHECK(x1(10.) == Interval(-10.,10.));
+
+    // Structural changes unfreeze the network
+    Interval d1(0.6);
+    cn1.add(ctc_plus, {d1, b1, c1});
+    CHECK(!cn1.is_frozen());
+    cn1.freeze();
+    cn1.contract();
+    CHECK(b1 == ApproxIntv(Interval(0.9,1)));
+    CHECK(c1 == ApproxIntv(Interval(1.5,1.6)));
+    CHECK(a1 == ApproxIntv(Interval(0.5,0.7)));
+  }
+
+  SECTION("Rebinding domains for new cycles")
+  {
+    CtcFunction ctc_plus(Function("a", "b", "c", "a+b-c"));
+    CtcDeriv ctc_deriv;
+
+    Interval a, b, c;
+    Tube x(Interval(0.,10.), 1.), v(Interval(0.,10.), 1.);
+
+    ContractorNetwork cn;
+    cn.add(ctc_plus, {a, b, c});
+    cn.add(ctc_deriv, {x, v});
+    cn.freeze();
+    int nb_ctc = cn.nb_ctc(), nb_dom = cn.nb_dom();
+
+    for(int k = 0 ; k < 3 ; k++) // cycles with new values
+    {
+      cn.rebind(a, Interval(0,1) + k);
+      cn.rebind(b, Interval(-1,1));
+      cn.rebind(c, Interval(1.5,2) + k);
+      cn.rebind(x, Interval::ALL_REALS);
+      cn.rebind(v, Interval(-1.,1.) + k);
+      x.set(0., 0.);
+      cn.trigger_all_contractors();
+      cn.contract();
+
+      CHECK(cn.is_frozen());
+      CHECK(cn.nb_ctc() == nb_ctc);
+      CHECK(cn.nb_dom() == nb_dom);
+      CHECK(x(10.) == Interval(-10.,10.) + 10.*k);
+    }
+
+    CHECK(a == Interval(2.5,3));
+    CHECK(b == Interval(0.5,1));
+    CHECK(c == Interval(3.5,4));
+
+    Tube y(Interval(0.,10.), 1., Interval(2.,3.));
+    cn.rebind(x, y);
+    CHECK(x == y);
+
+    Interval d;
+    CHECK_THROWS(cn.rebind(d, Interval(0.)););
+  }
+
+  SECTION("Parallel static contractors")
+  {
+    Interval tdomain(0.,10.);
+    TubeVector x1(tdomain, 0.01, TFunction("(t ; [-2,2])"));
+    TubeVector x2(x1);
+
+    // y = sin(x), sequential reference on broken down contractors
+    CtcFunction ctc_f(Function("x", "y", "y-sin(x)"));
+    CtcStatic ctc_seq(ctc_f);
+    ContractorNetwork cn_seq;
+    cn_seq.add(ctc_seq, {x1});
+    cn_seq.contract();
+    CHECK(x1[1].codomain() == ApproxIntv(Interval(-1.,1.)));
+
+    // Same constraint on 4 threads, with one contractor per thread
+    deque<CtcFunction> v_ctc_f;
+    vector<Ctc*> v_thread_ctc;
+    for(int k = 0 ; k < 4 ; k++)
+    {
+      v_ctc_f.emplace_back(Function("x", "y", "y-sin(x)"));
+      v_thread_ctc.push_back(&v_ctc_f.back());
+    }
+
+    CtcStatic ctc_par(ctc_f);
+    CHECK_THROWS(ctc_par.set_nb_threads(4)); // the IBEX contractor cannot be shared by the threads
+    CHECK_THROWS(ctc_par.set_nb_threads(2, { v_thread_ctc[0], v_thread_ctc[0] }));
+    CHECK(ctc_par.nb_threads() == 1);
+    ctc_par.set_nb_threads(4, v_thread_ctc);
+    CHECK(ctc_par.nb_threads() == 4);
+
+    ContractorNetwork cn_par;
+    cn_par.break_down_static_ctc(false);
+    cn_par.add(ctc_par, {x2});
+    CHECK(cn_par.nb_ctc() < cn_seq.nb_ctc()); // one single contractor on the tubes
+    cn_par.contract();
+
+    for(double t = 0. ; t <= 10. ; t+=0.25)
+      CHECK(x2[1](t) == ApproxIntv(x1[1](t)));
+  }
+
+  SECTION("Predefined contractors shared by networks in parallel threads")
+  {
+    // Independent networks sharing ctc::eval and ctc::deriv: the settings
+    // of each registration are not stored in these objects
+    const int nb_networks = 16, nb_threads = 4;
+    Interval tdomain(0.,10.);
+    Tube v(tdomain, 0.1, TFunction("cos(t)")); // functions are parsed outside the threads
+
+    vector<Tube> v_x_seq(nb_networks, Tube(tdomain, 0.1)), v_x_par(v_x_seq);
+    vector<Tube> v_v_seq(nb_networks, v), v_v_par(v_v_seq);
+    vector<Interval> v_t_seq, v_z_seq;
+    for(int k = 0 ; k < nb_networks ; k++)
+    {
+      v_t_seq.push_back(Interval(0.5*k + 1.));
+      v_z_seq.push_back(std::sin(0.5*k + 1.) + Interval(-0.1,0.1));
+    }
+    vector<Interval> v_t_par(v_t_seq), v_z_par(v_z_seq);
+
+    auto contract_network = [](Tube& x, Tube& v, Interval& t, Interval& z)
+    {
+      ContractorNetwork cn;
+      cn.add(ctc::deriv, {x,v});
+      cn.add(ctc::eval, {t,z,x,v});
+      cn.contract();
+    };
+
+    for(int k = 0 ; k < nb_networks ; k++)
+      contract_network(v_x_seq[k], v_v_seq[k], v_t_seq[k], v_z_seq[k]);
+
+    vector<thread> v_threads;
+    for(int i = 0 ; i < nb_threads ; i++)
+      v_threads.push_back(thread([&,i]()
+      {
+        for(int k = i ; k < nb_networks ; k += nb_threads)
+          contract_network(v_x_par[k], v_v_par[k], v_t_par[k], v_z_par[k]);
+      }));
+    for(auto& th : v_threads)
+      th.join();
+
+    for(int k = 0 ; k < nb_networks ; k++)
+    {
+      CHECK(!v_x_seq[k].codomain().is_unbounded());
+      CHECK(v_x_par[k] == v_x_seq[k]);
+      CHECK(v_z_par[k] == v_z_seq[k]);
+    }
+
+    // The registrations with derivative did not disable the temporal propagations of ctc::eval
+    Interval t(5.);
+    tubex::Domain dom_t(t);
+    CHECK(ctc::eval.dependency_tdomain({&dom_t}) == Interval::ALL_REALS);
+  }
+
   /*SECTION("create_dom TubeVector")
   {
     double dt = 0.1;
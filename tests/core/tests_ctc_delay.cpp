@@ -64,4 +64,33 @@ TEST_CASE("CtcDelay")
     CHECK(delay.contains(M_PI/2.));
     CHECK(delay.diam() < 3.*dt);
   }
+
+  SECTION("Test CtcDelay, thin delay on aligned slicings")
+  {
+    double dt = 0.125;
+    Interval tdomain(0.,10.);
+    Tube x(tdomain, dt, TFunction("cos(t)"));
+    Tube y(tdomain, dt);
+
+    CtcDelay ctc_delay;
+    Interval delay(1.);
+    ctc_delay.contract(delay, x, y);
+
+    CHECK(delay == Interval(1.));
+    CHECK(y(Interval(0.,1.)) == Interval::ALL_REALS);
+    CHECK(y(Interval(3.,3.125)) == x(Interval(2.,2.125)));
+    CHECK(y(1.) == x(0.));
+    CHECK(y(10.) == x(9.));
+
+    // General case, on a slicing that cannot be shifted
+    Tube y2(tdomain, 0.1);
+    Interval delay2(1.);
+    bool x_synthesis = x.synthesis_enabled(), y2_synthesis = y2.synthesis_enabled();
+    ctc_delay.contract(delay2, x, y2);
+    CHECK(x.synthesis_enabled() == x_synthesis); // settings of the tubes not modified
+    CHECK(y2.synthesis_enabled() == y2_synthesis);
+    CHECK(delay2 == Interval(1.));
+    CHECK(y2(3.05).is_subset(x(Interval(1.9,2.2))));
+    CHECK(y2(3.05).is_superset(Interval(cos(2.05))));
+  }
 }
\ No newline at end of file
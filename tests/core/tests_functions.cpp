@@ -49,4 +49,73 @@ TEST_CASE("Functions")
     CHECK(f.arg_name(1) == "x2");
     CHECK(f.expr() == "x1+sin(t)*x2+[-0.01,0.01]");
   }
+
+  SECTION("Compiled evaluations")
+  {
+    TFunction f("x", "y", "(x*cos(y)-t^2 ; sqrt(abs(x))+exp(-y)/(1+sqr(t)) ; atan2(y,x+3))");
+    TFunction f_comp(f);
+    CHECK(!f.is_compiled());
+    CHECK(f_comp.compile());
+    CHECK(f_comp.is_compiled());
+
+    // Several blocks of slices
+    TubeVector x(Interval(0.,10.), 0.01, TFunction("(sin(t)+[-0.1,0.1] ; cos(t)+[-0.1,0.1])"));
+    TubeVector y(f.eval_vector(x)), y_comp(f_comp.eval_vector(x));
+    CHECK(y_comp.nb_slices() == x.nb_slices());
+    CHECK(y_comp == y);
+
+    IntervalVector box{{0.,1.},{-1.,2.},{0.5,0.6}};
+    CHECK(f_comp.eval_vector(box) == f.eval_vector(box));
+    CHECK(f_comp.eval_vector(Interval(2.), x) == f.eval_vector(Interval(2.), x));
+    CHECK(f_comp.eval_vector(IntervalVector(3, Interval::EMPTY_SET)).is_empty());
+
+    TFunction f1 = f_comp[1];
+    CHECK(f1.is_compiled());
+    CHECK(f1.eval(box) == f[1].eval(box));
+  }
+
+  SECTION("Evaluations on trajectories")
+  {
+    TFunction f("x", "y", "(x*cos(y)-t^2 ; x+y)");
+
+    // Sampled and analytic inputs, several blocks of samples
+    TrajectoryVector x(2);
+    x[0] = Trajectory(Interval(0.,10.), TFunction("sin(t)"), 0.001);
+    x[1] = Trajectory(Interval(0.,10.), TFunction("2*t"));
+
+    TrajectoryVector y = f.traj_eval_vector(x);
+    CHECK(y.size() == 2);
+    CHECK(!y.time_axis_shared()); // independent components by default
+    CHECK(y[0].sampled_times() == x[0].sampled_times());
+    CHECK(y[1].sampled_times() == x[0].sampled_times());
+
+    for(double t : x[0].sampled_times())
+    {
+      CHECK(Approx(y(t)[0]) == x[0](t)*cos(2.*t)-t*t);
+      CHECK(Approx(y(t)[1]) == x[0](t)+2.*t);
+    }
+
+    // Inputs on a shared time axis: the rows are read directly
+    TrajectoryVector x_sampled(x);
+    x_sampled[1] = Trajectory(x[0].sampled_times(), x[1].sample_values(x[0].sampled_times()));
+    TrajectoryVector x_shared(x_sampled);
+    x_shared.share_time_axis();
+    CHECK(f.traj_eval_vector(x_shared) == f.traj_eval_vector(x_sampled));
+    CHECK(f.traj_eval_vector(x_shared) == y);
+
+    TrajectoryVector y_shared = f.traj_eval_vector(x, true); // explicit choice
+    CHECK(y_shared.time_axis_shared());
+    CHECK(y_shared == y);
+
+    // Components with samples set out of time order (merged before the threads)
+    TrajectoryVector x_ordered(2), x_unordered(2);
+    for(int k = 0 ; k <= 10000 ; k++)
+      x_ordered.set(Vector({sin(0.001*k), 0.002*k}), 0.001*k);
+    for(int k = 10000 ; k >= 0 ; k--)
+      x_unordered.set(Vector({sin(0.001*k), 0.002*k}), 0.001*k);
+    CHECK(f.traj_eval_vector(x_unordered) == f.traj_eval_vector(x_ordered));
+
+    Trajectory y1 = TFunction("x", "y", "x*y").traj_eval(x);
+    CHECK(Approx(y1(5.)) == sin(5.)*10.);
+  }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "tubex_Point.h"
 #include "tubex_Edge.h"
 #include "tubex_VIBesFig.h"
+#include "tubex_zonotope_arithmetic.h"
+#include "tubex_CtcLinobs.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -11,6 +13,22 @@ using namespace tubex;
 
 #define VIBES_DRAWING 1
 
+IntervalMatrix exp_At_nilpotent(const Matrix& A, const Interval& t) // e^At = I+At when A^2=0
+{
+  IntervalMatrix exp_At(IntervalMatrix::eye(A.nb_rows()));
+  for(int i = 0 ; i < A.nb_rows() ; i++)
+    for(int j = 0 ; j < A.nb_cols() ; j++)
+      exp_At[i][j] += A[i][j] * t;
+  return exp_At;
+}
+
+int nb_exp_At_computations = 0;
+IntervalMatrix exp_At_nilpotent_counted(const Matrix& A, const Interval& t)
+{
+  nb_exp_At_computations++;
+  return exp_At_nilpotent(A, t);
+}
+
 TEST_CASE("Geometry")
 {
   SECTION("Alignements")
@@ -107,4 +125,119 @@ TEST_CASE("Geometry")
     CHECK(!inter.does_not_exist());
     CHECK(ApproxPoint(inter) == Point(-1.2068965517241383445, 0.48275862068965491591));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Zonotopes")
+{
+  SECTION("Zonotope from IntervalVector")
+  {
+    IntervalVector iv({Interval(-1.,5.), Interval(10.,11.)});
+    Zonotope z(iv);
+    CHECK(z.size() == 2);
+    CHECK(z.nb_generators() == 0);
+    CHECK(z.box() == iv);
+    CHECK(!z.is_empty());
+    CHECK(!z.is_unbounded());
+  }
+
+  SECTION("Linear maps")
+  {
+    Zonotope z(IntervalVector(2, Interval(-1.,1.)));
+
+    Matrix rot90({{0.,-1.},{1.,0.}});
+    Zonotope z90 = IntervalMatrix(rot90) * z;
+    CHECK(z90.nb_generators() == 2);
+    CHECK(z90.box() == z.box());
+
+    double c = cos(M_PI/4.), s = sin(M_PI/4.);
+    Matrix rot45({{c,-s},{s,c}});
+    Zonotope z45 = IntervalMatrix(rot45) * z;
+    CHECK(z45.box()[0].is_superset(Interval(-sqrt(2.),sqrt(2.))));
+    CHECK(z45.box()[0].is_subset(Interval(-1.415,1.415)));
+  }
+
+  SECTION("Intersection with a box")
+  {
+    // Rotated square: |x|+|y| <= sqrt(2)
+    double c = cos(M_PI/4.), s = sin(M_PI/4.);
+    Matrix rot45({{c,-s},{s,c}});
+    Zonotope z = IntervalMatrix(rot45) * Zonotope(IntervalVector(2, Interval(-1.,1.)));
+
+    Zonotope z_inter = z & IntervalVector({Interval(1.,2.), Interval::ALL_REALS});
+    CHECK(z_inter.box()[1].is_superset(Interval(-0.414,0.414)));
+    CHECK(z_inter.box()[1].is_subset(Interval(-0.415,0.415)));
+
+    CHECK((z & IntervalVector({Interval(2.,3.), Interval::ALL_REALS})).is_empty());
+  }
+
+  SECTION("Order reduction")
+  {
+    vector<Vector> v_generators;
+    for(int i = 0 ; i < 6 ; i++)
+      v_generators.push_back(Vector({cos(i*M_PI/6.), sin(i*M_PI/6.)}));
+
+    Zonotope z(IntervalVector(2, Interval(0.)), v_generators);
+    IntervalVector box = z.box();
+
+    z.reduce(3);
+    CHECK(z.nb_generators() == 3);
+    CHECK(z.box().is_superset(box));
+  }
+
+  SECTION("CtcLinobs in 3d, unbounded initial set")
+  {
+    // x0'=x1, x1'=u, x2'=0
+    Matrix A({{0.,1.,0.},{0.,0.,0.},{0.,0.,0.}});
+    Vector b({0.,1.,0.});
+
+    Interval tdomain(0.,2.);
+    TubeVector x(tdomain, 0.5, 3);
+    Tube u(tdomain, 0.5, Interval(1.));
+    x.set(IntervalVector({Interval(0.), Interval(0.), Interval::ALL_REALS}), 0.);
+
+    double t = 1.;
+    IntervalVector y({Interval::ALL_REALS, Interval::ALL_REALS, Interval(1.,2.)});
+
+    CtcLinobs ctc_linobs(A, b, &exp_At_nilpotent);
+    vector<Zonotope> v_z_k;
+    ctc_linobs.contract(t, y, x, u, v_z_k);
+
+    CHECK(v_z_k.size() == 5);
+    CHECK(!x.is_empty());
+    CHECK(x[1](2.).contains(2.));
+    CHECK(x[1](2.).is_subset(Interval(1.99,2.01)));
+    CHECK(x[0](2.).contains(2.));
+    CHECK(!x[0].codomain().is_unbounded());
+    CHECK(x[2](0.).is_subset(Interval(1.,2.)));
+    CHECK(x[2](2.).is_subset(Interval(1.,2.)));
+  }
+
+  SECTION("CtcLinobs, e^At computed once per slice width")
+  {
+    // x0'=x1, x1'=u
+    Matrix A({{0.,1.},{0.,0.}});
+    Vector b({0.,1.});
+
+    Interval tdomain(0.,10.);
+    TubeVector x(tdomain, 0.1, 2);
+    Tube u(tdomain, 0.1, Interval(-0.1,0.1));
+    x.set(IntervalVector(2, Interval(-0.1,0.1)), 0.);
+
+    nb_exp_At_computations = 0;
+    CtcLinobs ctc_linobs(A, b, &exp_At_nilpotent_counted);
+    ctc_linobs.contract(x, u);
+
+    CHECK(!x.is_empty());
+    CHECK(x(10.).is_subset(IntervalVector({Interval(-7.,7.), Interval(-1.2,1.2)})));
+    CHECK(nb_exp_At_computations > 0);
+    CHECK(nb_exp_At_computations <= 8); // 4 matrices for each encountered width (x100 before)
+
+    int nb = nb_exp_At_computations;
+    ctc_linobs.contract(x, u);
+    CHECK(nb_exp_At_computations == nb);
+
+    ctc_linobs.clear_exp_At_cache();
+    ctc_linobs.contract(x, u);
+    CHECK(nb_exp_At_computations > nb);
+  }
+}
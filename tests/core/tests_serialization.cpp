@@ -1,6 +1,9 @@
 #include <cstdio>
 #include "tubex_serialize_trajectories.h"
 #include "tubex_serialize_tubes.h"
+#ifndef _WIN32
+#include "tubex_MappedFile.h"
+#endif
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
 
@@ -183,6 +186,71 @@ TEST_CASE("serialization/deserialization of Tube")
     CHECK(tube1 == tube2);
     CHECK(traj1 == *traj4);
   }
+
+  SECTION("Version 2 files")
+  {
+    TubeVector tube1(Interval(0.,46.), 1., 3);
+    tube1.set(IntervalVector(3, Interval(2.,3.)), 0.);
+    tube1.set(IntervalVector(3, Interval::POS_REALS), 10);
+    tube1.set(IntervalVector(3, Interval::EMPTY_SET), 46.);
+    TrajectoryVector traj1(3);
+    for(int k = 0 ; k < tube1.nb_slices() ; k++)
+      traj1.set(Vector(3, k*0.5), tube1[0].slice(k)->tdomain().mid());
+
+    string filename = "test_serialization_v2.tube";
+    tube1.serialize(filename, traj1, 2);
+    TrajectoryVector *traj2;
+    TubeVector tube2(filename, traj2);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(traj1 == *traj2);
+    CHECK(tube2(46.) == IntervalVector(3, Interval::EMPTY_SET));
+
+    tube1.serialize(filename, traj1, 3);
+    TrajectoryVector *traj3;
+    TubeVector tube3(filename, traj3);
+    remove(filename.c_str());
+    CHECK(tube1 == tube3);
+    CHECK(traj1 == *traj3);
+    CHECK(tube3(10) == IntervalVector(3, Interval::POS_REALS));
+  }
+
+  SECTION("Corrupted version 3 files")
+  {
+    string filename = "test_serialization_corrupted.tube";
+    short int version_number = 3;
+    int slices_number = 1 << 30; // more slices than the values of the file
+    {
+      ofstream bin_file(filename, ios::out | ios::binary);
+      bin_file.write((const char*)&version_number, sizeof(short int));
+      bin_file.write((const char*)&slices_number, sizeof(int));
+      double values[] = { 0., 1., 0., 1., 0., 0., 1., 1. }; // exactly 1 slice: t, lb, ub, gates lb, gates ub
+      bin_file.write((const char*)values, sizeof(values));
+    }
+
+    Tube *tube = NULL;
+    {
+      ifstream bin_file(filename, ios::in | ios::binary);
+      CHECK_THROWS(deserialize_Tube(bin_file, tube););
+      CHECK(tube == NULL); // nothing allocated
+    }
+
+    slices_number = 1; // consistent count
+    {
+      fstream bin_file(filename, ios::in | ios::out | ios::binary);
+      bin_file.seekp(sizeof(short int));
+      bin_file.write((const char*)&slices_number, sizeof(int));
+    }
+    {
+      ifstream bin_file(filename, ios::in | ios::binary);
+      deserialize_Tube(bin_file, tube);
+    }
+    remove(filename.c_str());
+    REQUIRE(tube != NULL);
+    CHECK(tube->nb_slices() == 1);
+    CHECK(tube->tdomain() == Interval(0.,1.));
+    delete tube;
+  }
 }
 
 bool test_serialization(const Tube& tube1)
@@ -277,4 +345,115 @@ TEST_CASE("(de)serializations on unbounded tubes", "[core]")
     tube.set(Interval::EMPTY_SET);
     CHECK(test_serialization(tube));
   }
-}
\ No newline at end of file
+}
+
+#ifndef _WIN32
+TEST_CASE("Columnar mapped files", "[core]")
+{
+  SECTION("Tubes")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval::POS_REALS, 3);
+    tube1.set(Interval::EMPTY_SET, 8);
+    string filename = "test_mapped.tube";
+    MappedFile::write(filename, tube1);
+
+    MappedFile file(filename);
+    CHECK(file.is_tube());
+    CHECK(file.size() == 1);
+    CHECK(file.nb_slices() == (size_t)tube1.nb_slices());
+    CHECK(file.tdomain() == tube1.tdomain());
+    CHECK(file.times()[1] == tube1.slice(1)->tdomain().lb());
+    CHECK(file.envelope_ub(0)[3] == POS_INFINITY);
+    CHECK(Interval(file.envelope_lb(0)[5], file.envelope_ub(0)[5]) == tube1(5));
+    CHECK(((size_t)file.envelope_lb(0) % 64) == 0);
+    CHECK(((size_t)file.gate_ub(0) % 64) == 0);
+
+    Tube tube2 = file.tube();
+    CHECK(tube1 == tube2);
+    CHECK(tube2(8) == Interval::EMPTY_SET);
+
+    Tube tube3 = file.tube(0, Interval(10.,20.));
+    CHECK(tube3.tdomain().is_superset(Interval(10.,20.)));
+    CHECK(tube3.nb_slices() < tube1.nb_slices());
+    CHECK(tube3(15.) == tube1(15.));
+    CHECK(tube3.first_slice()->input_gate() == tube1(tube3.tdomain().lb()));
+
+    remove(filename.c_str());
+  }
+
+  SECTION("Tube vectors")
+  {
+    TubeVector tube1(Interval(0.,46.), 1., 3);
+    tube1.set(IntervalVector(3, Interval(2.,3.)), 0.);
+    tube1.set(IntervalVector(3, Interval(7.)), 3.);
+    tube1.set(IntervalVector(3, Interval(-1.,1.)), 10);
+    string filename = "test_mapped_vector.tube";
+    MappedFile::write(filename, tube1);
+
+    MappedFile file(filename);
+    CHECK(file.size() == 3);
+    CHECK(file.tube_vector() == tube1);
+    CHECK(file.tube(2) == tube1[2]);
+    CHECK(file.tube_vector(Interval(10.,11.))(10.5) == IntervalVector(3, Interval(-1.,1.)));
+    CHECK_THROWS(file.tube(0, Interval(50.,60.)););
+
+    remove(filename.c_str());
+  }
+
+  SECTION("Trajectories")
+  {
+    TrajectoryVector traj1(2);
+    for(int k = 0 ; k < 100 ; k++)
+      traj1.set(Vector({ cos(k*0.1), sin(k*0.1) }), k*0.1);
+    string filename = "test_mapped.traj";
+    MappedFile::write(filename, traj1);
+
+    MappedFile file(filename);
+    CHECK(!file.is_tube());
+    CHECK(file.size() == 2);
+    CHECK(file.nb_samples() == 100);
+    CHECK(file.tdomain() == traj1.tdomain());
+    CHECK(file.values(1)[10] == sin(1.));
+    CHECK(file.trajectory(0) == traj1[0]);
+    CHECK(file.trajectory_vector() == traj1);
+
+    Trajectory traj2 = file.trajectory(1, Interval(2.,5.));
+    CHECK(traj2.tdomain().is_subset(Interval(2.,5.)));
+    CHECK(traj2(3.) == traj1[1](3.));
+
+    TrajectoryVector traj3(2);
+    traj3[0].set(0., 0.); traj3[0].set(1., 1.);
+    traj3[1].set(0., 0.); traj3[1].set(1., 2.);
+    CHECK_THROWS(MappedFile::write(filename, traj3););
+
+    remove(filename.c_str());
+  }
+
+  SECTION("Wrong files")
+  {
+    CHECK_THROWS(MappedFile file("test_mapped_missing.tube"););
+
+    Tube tube1(Interval(0.,10.), 1.);
+    string filename = "test_mapped_v2.tube";
+    tube1.serialize(filename);
+    CHECK_THROWS(MappedFile file(filename););
+    remove(filename.c_str());
+
+    // Corrupted header: the size of the column table overflows
+    Trajectory traj(Interval(0.,10.), TFunction("t"), 0.1);
+    filename = "test_mapped_corrupted.traj";
+    MappedFile::write(filename, traj);
+    {
+      fstream file(filename, ios::in | ios::out | ios::binary);
+      uint64_t size = (uint64_t)1 << 60, nb_columns = size + 1;
+      file.seekp(16); // size field
+      file.write((const char*)&size, sizeof(uint64_t));
+      file.seekp(32); // nb_columns field
+      file.write((const char*)&nb_columns, sizeof(uint64_t));
+    }
+    CHECK_THROWS(MappedFile file(filename););
+    remove(filename.c_str());
+  }
+}
+#endif
@@ -402,4 +402,33 @@ TEST_CASE("Tube slices structure")
     CHECK(tube.nb_slices() == 1);
     CHECK(tube[0].slice(0)->tdomain() == Interval(8.2,8.3));
   }
+
+  SECTION("slide_tdomain")
+  {
+    Tube tube(Interval(0.,10.), 1.);
+    tube.set(Interval(-1.,1.));
+    tube.set(Interval(0.5), 2.);
+    const Slice *s0 = tube.first_slice();
+
+    CHECK(tube.slide_tdomain(0.5) == 0);
+    CHECK(tube.tdomain() == Interval(0.,10.));
+
+    CHECK(tube.slide_tdomain(2.5) == 2);
+    CHECK(tube.tdomain() == Interval(2.,12.));
+    CHECK(tube.nb_slices() == 10);
+    CHECK(tube.first_slice()->input_gate() == Interval(0.5)); // prior kept
+    CHECK(tube.last_slice()->prev_slice() == s0); // recycled slices
+    CHECK(s0->tdomain() == Interval(10.,11.));
+    CHECK(s0->input_gate() == Interval(-1.,1.));
+    CHECK(s0->codomain() == Interval::ALL_REALS);
+    CHECK(tube.slice(10.5) == s0);
+    CHECK(tube(11.5) == Interval::ALL_REALS);
+    CHECK(tube(5.5) == Interval(-1.,1.));
+
+    Tube tube_one_slice(Interval(0.,2.), Interval(-1.,1.));
+    CHECK(tube_one_slice.slide_tdomain(3.) == 1);
+    CHECK(tube_one_slice.tdomain() == Interval(2.,4.));
+    CHECK(tube_one_slice.nb_slices() == 1);
+    CHECK(tube_one_slice.first_slice()->input_gate() == Interval(-1.,1.));
+  }
 }
@@ -47,6 +47,89 @@ TEST_CASE("Trajectory base")
     CHECK(traj2(traj2.tdomain()) == Interval(-2.,4.));
   }
 
+  SECTION("Sampled values storage")
+  {
+    Trajectory traj;
+    for(int i = 0 ; i <= 100 ; i++) // appended in time order
+      traj.set(2.*i, 0.1*i*i);
+    traj.set(-1., 0.05); // inserted
+    traj.set(3., 0.1); // updated
+
+    CHECK(traj.sampled_times().size() == 102);
+    CHECK(traj.sampled_values().size() == 102);
+    CHECK(traj.sampled_times()[1] == 0.05);
+    CHECK(traj.sampled_values()[1] == -1.);
+    CHECK(traj.sampled_values()[2] == 3.);
+    CHECK(traj.tdomain() == Interval(0.,1000.));
+    CHECK(traj.codomain() == Interval(-1.,200.));
+
+    // Non-uniform sampling
+    for(int i = 2 ; i < 100 ; i++)
+    {
+      double t = 0.1*i*i + 0.03*i;
+      CHECK(Approx(traj(t)) == 2.*i + (0.03*i) * 2. / (0.1*(i+1)*(i+1) - 0.1*i*i));
+    }
+
+    // Compatibility view
+    const map<double,double>& map_values = traj.sampled_map();
+    CHECK(map_values.size() == 102);
+    CHECK(map_values.at(0.05) == -1.);
+    CHECK(map_values.at(1000.) == 200.);
+    traj.set(4., 1001.);
+    CHECK(traj.sampled_map().size() == 103);
+    CHECK(traj.sampled_map().at(1001.) == 4.);
+
+    Trajectory traj2(traj.sampled_times(), traj.sampled_values());
+    CHECK(traj2 == traj);
+  }
+
+  SECTION("Samples set out of time order")
+  {
+    Trajectory traj_ordered, traj;
+    for(int i = 0 ; i < 1000 ; i++)
+      traj_ordered.set(std::cos(0.1*i), 0.1*i);
+
+    traj.set(std::cos(0.1*999), 0.1*999);
+    for(int i = 998 ; i >= 0 ; i -= 2) // backward, every two samples
+      traj.set(5., 0.1*i);
+    for(int i = 0 ; i < 1000 ; i += 2)
+      traj.set(std::cos(0.1*i), 0.1*i); // updates of the buffered keys
+    for(int i = 997 ; i > 0 ; i -= 2)
+      traj.set(std::cos(0.1*i), 0.1*i);
+
+    CHECK(traj.codomain() == traj_ordered.codomain());
+    CHECK(traj.sampled_times() == traj_ordered.sampled_times());
+    CHECK(traj.sampled_values() == traj_ordered.sampled_values());
+    CHECK(traj == traj_ordered);
+    CHECK(traj(0.15) == traj_ordered(0.15));
+  }
+
+  SECTION("Interval evaluations over many samples")
+  {
+    Trajectory traj;
+    for(int i = 0 ; i <= 10000 ; i++)
+      traj.set(std::sin(0.37*i) + 0.001*i, 0.01*i);
+
+    for(int i = 0 ; i < 200 ; i++)
+    {
+      Interval t(0.01*(37*i % 5000) + 0.003, 0.01*(37*i % 5000) + 0.003 + 0.25*i);
+      t &= traj.tdomain();
+
+      Interval hull = Interval(traj(t.lb())) | traj(t.ub());
+      for(int j = 0 ; j <= 10000 ; j++)
+        if(t.contains(0.01*j))
+          hull |= traj.sampled_values()[j];
+
+      CHECK(traj(t) == hull);
+    }
+
+    // Updates are taken into account
+    traj.set(10., 50.);
+    CHECK(traj(Interval(1.,90.)).ub() == 10.);
+    traj.set(-10., 30.);
+    CHECK(traj(Interval(1.,90.)).lb() == -10.);
+  }
+
   SECTION("Update")
   {
     Trajectory traj;
@@ -147,6 +230,41 @@ TEST_CASE("Trajectory base")
     CHECK(test.last_value() == 10.);
   }
 
+  SECTION("Sampled values")
+  {
+    // Defined by a TFunction object
+    Trajectory traj1(Interval(0.,10.), TFunction("cos(t)+0.5*t^2"));
+    vector<double> v_t;
+    for(double t = 0. ; t <= 10. ; t+=0.01)
+      v_t.push_back(t);
+
+    vector<double> v_y = traj1.sample_values(v_t);
+    CHECK(v_y.size() == v_t.size());
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+    {
+      CHECK(Approx(v_y[j]) == cos(v_t[j])+0.5*v_t[j]*v_t[j]);
+      CHECK(v_y[j] == traj1(v_t[j]));
+    }
+
+    CHECK(Approx(traj1.first_value()) == 1.);
+    CHECK(Approx(traj1.last_value()) == cos(10.)+50.);
+
+    // Defined by maps of values
+    Trajectory traj2(Interval(0.,10.), TFunction("cos(t)+0.5*t^2"), 0.1);
+    v_y = traj2.sample_values(v_t);
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+      CHECK(v_y[j] == traj2(v_t[j]));
+
+    TrajectoryVector traj3(Interval(0.,10.), TFunction("(t ; sin(t))"));
+    vector<Vector> v_x = traj3.sample_values(v_t);
+    CHECK(v_x.size() == v_t.size());
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+    {
+      CHECK(v_x[j][0] == v_t[j]);
+      CHECK(Approx(v_x[j][1]) == sin(v_t[j]));
+    }
+  }
+
   SECTION("Trajectory vector")
   {
     // Defined by maps of values
@@ -161,6 +279,64 @@ TEST_CASE("Trajectory base")
     CHECK(test.size() == 4);
   }
 
+  SECTION("Trajectory vector on a shared time axis")
+  {
+    TrajectoryVector x(3);
+    CHECK(!x.time_axis_shared());
+    x.share_time_axis(); // explicit choice of storage
+    for(double t = 0. ; t <= 10. ; t++)
+      x.set(Vector({t, 2.*t, -t}), t);
+    x.set(Vector({0.5, 1., -0.5}), 0.5); // inserted
+
+    CHECK(x.time_axis_shared());
+    CHECK(x.tdomain() == Interval(0.,10.));
+    CHECK(x.codomain() == IntervalVector({{0.,10.},{0.,20.},{-10.,0.}}));
+    CHECK(x(0.5) == Vector({0.5, 1., -0.5}));
+    CHECK(x(2.25) == Vector({2.25, 4.5, -2.25}));
+    CHECK(x(Interval(2.5,4.)) == IntervalVector({{2.5,4.},{5.,8.},{-4.,-2.5}}));
+    CHECK(x.first_value() == Vector({0., 0., -0.}));
+    CHECK(x.last_value() == Vector({10., 20., -10.}));
+
+    // Reading the matrix, no Trajectory objects
+    CHECK(x.sampled_times().size() == 12);
+    CHECK(x.sampled_row(1)[1] == 1.);
+    CHECK(x.sampled_column(2)[11] == -10.);
+    CHECK(x.component(1)(7.5) == 15.);
+    CHECK_THROWS(x[1]);
+    CHECK_THROWS(static_cast<const TrajectoryVector&>(x)[1]);
+    CHECK(x.time_axis_shared());
+
+    TrajectoryVector x_sub = x.subvector(1,2);
+    CHECK(x_sub.time_axis_shared());
+    CHECK(x_sub(2.25) == Vector({4.5, -2.25}));
+
+    // Export to independent components, then import
+    TrajectoryVector y(x);
+    y.unshare_time_axis();
+    CHECK(!y.time_axis_shared());
+    CHECK(y == x);
+    y[0].set(3., 9.75);
+    CHECK(y(9.75)[0] == 3.);
+    CHECK(y != x);
+    y.share_time_axis();
+    CHECK(y.time_axis_shared());
+    CHECK(y.sampled_times().size() == 13);
+    CHECK(y(9.75) == Vector({3., 19.5, -9.75}));
+    CHECK(Approx(y(9.5)[0]) == 5.);
+
+    // Temporal operations on the matrix
+    y.truncate_tdomain(Interval(2.25,9.));
+    CHECK(y.tdomain() == Interval(2.25,9.));
+    CHECK(y.sampled_times().size() == 8);
+    CHECK(y.first_value() == Vector({2.25, 4.5, -2.25}));
+    y.shift_tdomain(1.);
+    CHECK(y.tdomain() == Interval(3.25,10.));
+    CHECK(y(4.) == Vector({3., 6., -3.}));
+    y.sample(0.5);
+    CHECK(y.sampled_times().size() == 21);
+    CHECK(Approx(y(3.75)[1]) == 5.5);
+  }
+
   SECTION("Constructor with list")
   {
     // Defined by maps of values
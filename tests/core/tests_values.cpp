@@ -382,6 +382,31 @@ TEST_CASE("Testing set inversion")
     }
   }
 
+  SECTION("Set inversions with synthesis tree")
+  {
+    Tube x = tube_test_1();
+    x.set(Interval(-4,2), 14);
+
+    Tube x_tree(x);
+    x_tree.enable_synthesis(true);
+
+    vector<Interval> v_y = { Interval(0.), Interval(-7.), Interval::ALL_REALS, Interval(-20,-18),
+                             Interval(-1.0,1.0), Interval(-6.9999), Interval(3.5), Interval(9.5,30.0),
+                             Interval(12.0,13.0), Interval(-4.0,-3.0), Interval(6.0,7.0) };
+    vector<Interval> v_search = { Interval::ALL_REALS, Interval(3.8,42.5), Interval(20.5,21.5), Interval::EMPTY_SET };
+
+    for(const auto& y : v_y)
+      for(const auto& search : v_search)
+      {
+        CHECK(x_tree.invert(y, search) == x.invert(y, search));
+
+        vector<Interval> v, v_tree;
+        x.invert(y, v, search);
+        x_tree.invert(y, v_tree, search);
+        CHECK(v_tree == v);
+      }
+  }
+
   SECTION("Invert method with derivative")
   {
     Tube x(Interval(0., 5.), 1.0);
@@ -0,0 +1,144 @@
+#include "catch_interval.hpp"
+#include "tubex_CtcConstell.h"
+
+using namespace Catch;
+using namespace Detail;
+using namespace std;
+using namespace ibex;
+using namespace tubex;
+
+// Reference: hull of the intersections of the box with all the landmarks
+IntervalVector linear_constell(const vector<IntervalVector>& map, const IntervalVector& a)
+{
+  IntervalVector union_result(a.size(), Interval::EMPTY_SET);
+  for(const auto& mj : map)
+    union_result |= a & mj.subvector(0,a.size()-1);
+  return union_result;
+}
+
+// Deterministic pseudo-random landmarks
+vector<IntervalVector> random_map(int n, int dim)
+{
+  srand(42);
+  vector<IntervalVector> map;
+  for(int k = 0 ; k < n ; k++)
+  {
+    IntervalVector mj(dim);
+    for(int i = 0 ; i < dim ; i++)
+    {
+      double c = 100.*rand()/RAND_MAX, r = 0.5*rand()/RAND_MAX;
+      mj[i] = Interval(c-r,c+r);
+    }
+    map.push_back(mj);
+  }
+  return map;
+}
+
+IntervalVector random_box(int dim, double max_width)
+{
+  IntervalVector a(dim);
+  for(int i = 0 ; i < dim ; i++)
+  {
+    double lb = 100.*rand()/RAND_MAX;
+    a[i] = Interval(lb, lb + max_width*rand()/RAND_MAX);
+  }
+  return a;
+}
+
+TEST_CASE("CtcConstell")
+{
+  SECTION("2d landmarks, compared to a linear scan")
+  {
+    vector<IntervalVector> map = random_map(1000, 2);
+    CtcConstell ctc_constell(map);
+    CHECK(ctc_constell.nb_var == 2);
+
+    int nb_nonempty = 0;
+    for(int k = 0 ; k < 500 ; k++)
+    {
+      IntervalVector a = random_box(2, 10.);
+      IntervalVector a_ref = linear_constell(map, a);
+      ctc_constell.contract(a);
+      CHECK(a == a_ref);
+      nb_nonempty += a.is_empty() ? 0 : 1;
+    }
+
+    CHECK(nb_nonempty > 0); // some queries are not trivial
+
+    // Large box containing all the landmarks
+    IntervalVector a(2, Interval(-10.,110.));
+    IntervalVector a_ref = linear_constell(map, a);
+    ctc_constell.contract(a);
+    CHECK(a == a_ref);
+  }
+
+  SECTION("3d landmarks, 2d contractor by default")
+  {
+    vector<IntervalVector> map = random_map(1000, 3);
+    CtcConstell ctc_constell(map);
+    CHECK(ctc_constell.nb_var == 2);
+
+    for(int k = 0 ; k < 300 ; k++)
+    {
+      IntervalVector a = random_box(2, 10.); // compared to the first two components
+      IntervalVector a_ref = linear_constell(map, a);
+      ctc_constell.contract(a);
+      CHECK(a == a_ref);
+    }
+  }
+
+  SECTION("3d landmarks, 3d contractor, 2d and 3d boxes")
+  {
+    vector<IntervalVector> map = random_map(1000, 3);
+    CtcConstell ctc_constell(list<IntervalVector>(map.begin(), map.end()), 3);
+    CHECK(ctc_constell.nb_var == 3);
+
+    for(int k = 0 ; k < 300 ; k++)
+    {
+      IntervalVector a = random_box(3, 30.);
+      IntervalVector a_ref = linear_constell(map, a);
+      ctc_constell.contract(a);
+      CHECK(a == a_ref);
+
+      IntervalVector b = random_box(2, 10.); // compared to the first two components
+      IntervalVector b_ref = linear_constell(map, b);
+      ctc_constell.contract(b);
+      CHECK(b == b_ref);
+    }
+  }
+
+  SECTION("Empty map")
+  {
+    CtcConstell ctc_constell(vector<IntervalVector>{});
+    CHECK(ctc_constell.nb_var == 2);
+
+    IntervalVector a(2, Interval(0.,1.));
+    ctc_constell.contract(a);
+    CHECK(a.is_empty());
+  }
+
+  SECTION("Wrong dimensions")
+  {
+    CHECK_THROWS(CtcConstell(random_map(10, 2), 3));
+    CHECK_THROWS(CtcConstell(random_map(10, 3), 4));
+    CHECK_THROWS(CtcConstell(random_map(10, 2), 1));
+  }
+
+  SECTION("Early exit: box covered by the landmarks")
+  {
+    vector<IntervalVector> map = random_map(1000, 2);
+    map.push_back(IntervalVector(2, Interval(40.,60.))); // large landmark
+    CtcConstell ctc_constell(map);
+
+    IntervalVector a(2, Interval(49.,51.));
+    IntervalVector a_ref = linear_constell(map, a);
+    CHECK(a_ref == a);
+    ctc_constell.contract(a);
+    CHECK(a == a_ref); // no contraction possible
+
+    IntervalVector b(2, Interval(59.,61.)); // partially covered
+    IntervalVector b_ref = linear_constell(map, b);
+    ctc_constell.contract(b);
+    CHECK(b == b_ref);
+  }
+}